@@ -36,13 +36,14 @@
 VerilatedVoidCb Verilated::s_flushCb = NULL;
 
 // Keep below together in one cache line
-Verilated::Serialized Verilated::s_s;
+VL_THREAD VerilatedContext* Verilated::t_contextp = NULL;
 VL_THREAD const VerilatedScope* Verilated::t_dpiScopep = NULL;
 VL_THREAD const char* Verilated::t_dpiFilename = "";
 VL_THREAD int Verilated::t_dpiLineno = 0;
 struct Verilated::CommandArgValues Verilated::s_args = {0, NULL};
 
 VerilatedImp  VerilatedImp::s_s;
+VerilatedContext Verilated::s_defaultContext;
 
 //===========================================================================
 // User definable functions
@@ -84,7 +85,7 @@ void vl_fatal (const char* filename, int linenum, const char* hier, const char*
 //===========================================================================
 // Overall class init
 
-Verilated::Serialized::Serialized() {
+VerilatedContext::Serialized::Serialized() {
     s_randReset = 0;
     s_debug = 0;
     s_calcUnusedSigs = false;
@@ -93,10 +94,30 @@ Verilated::Serialized::Serialized() {
     s_fatalOnVpiError = true; // retains old default behaviour
 }
 
+VerilatedContext::VerilatedContext()
+    : m_randState(VL_ULL(0x1234abcd330e))  // As lrand48 without srand48
+    , m_foreignScopep(NULL) {
+    m_impp = new VerilatedContextImp;
+}
+
+VerilatedContext::~VerilatedContext() {
+    if (Verilated::contextp() == this) Verilated::threadContextp(NULL);
+    delete m_impp; m_impp = NULL;
+}
+
+VerilatedSyms::VerilatedSyms(VerilatedContext* contextp)
+    : __Vm_contextp(contextp ? contextp : Verilated::defaultContextp()) {
+}
+
 //===========================================================================
 // Random reset -- Only called at init time, so don't inline.
 
 IData VL_RAND32() {
+    VerilatedContext* contextp = Verilated::contextp();
+    if (contextp != Verilated::defaultContextp()) {
+	// Private sequence, so models on other threads don't disturb it
+	return (contextp->randNext31()<<16) ^ contextp->randNext31();
+    }
 #if defined(_WIN32) && !defined(__CYGWIN__)
     // Windows doesn't have lrand48(), although Cygwin does.
     return (rand()<<16) ^ rand();
@@ -206,8 +227,10 @@ WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp, boo
     }
 
     // +1 word as we may shift during normalization
-    vluint32_t un[VL_MULS_MAX_WORDS+1]; // Fixed size, as MSVC++ doesn't allow [words] here
-    vluint32_t vn[VL_MULS_MAX_WORDS+1]; // v normalized
+    VerilatedWideTemp unstore (words+1);
+    VerilatedWideTemp vnstore (words+1);
+    vluint32_t* un = unstore.datap();
+    vluint32_t* vn = vnstore.datap(); // v normalized
 
     // Zero for ease of debugging and to save having to zero for shifts
     // Note +1 as loop will use extra word
@@ -282,14 +305,159 @@ WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp, boo
     }
 }
 
+#if VL_WIDE_LIMB64 && VL_MUL_KARATSUBA_WORDS
+// Karatsuba multiply, on 64-bit limbs like VL_MUL_W.  Splitting each
+// operand into halves a=a1*B+a0, the full product needs three half size
+// multiplies,
+//	a0*b0 + ((a0+a1)*(b0+b1) - a0*b0 - a1*b1)*B + a1*b1*B^2
+// and the low half product (what Verilog's truncating multiply needs) three,
+//	a0*b0 + low(a1*b0)*B + low(a0*b1)*B
+// Below VL_MUL_KARATSUBA_WORDS, schoolbook multiply is faster.
+
+#define VL_MUL_KARATSUBA_LIMBS (VL_MUL_KARATSUBA_WORDS/2)
+#if VL_MUL_KARATSUBA_LIMBS < 4
+# error "VL_MUL_KARATSUBA_WORDS must be 0 or at least 8, so each split is smaller"
+#endif
+
+static int _vl_mul_full_temps(int limbs) {
+    // Temporary limbs needed by _vl_mul_full_q
+    if (limbs < VL_MUL_KARATSUBA_LIMBS) return 0;
+    int hil = limbs - limbs/2;
+    return 4*(hil+1) + _vl_mul_full_temps(hil+1);
+}
+
+static int _vl_mul_low_temps(int limbs) {
+    // Temporary limbs needed by _vl_mul_low_q
+    if (limbs < VL_MUL_KARATSUBA_LIMBS) return 0;
+    int low = limbs - limbs/2;
+    int hil = limbs - low;
+    int full = 2*low + _vl_mul_full_temps(low);
+    int cross = 2*hil + _vl_mul_low_temps(hil);
+    return (full > cross) ? full : cross;
+}
+
+static void _vl_mul_add_q(int limbs, QData* op, const QData* lp, int llimbs) {
+    // op[0..limbs) += lp[0..llimbs), dropping any carry out
+    QData carry = 0;
+    int i=0;
+    for (; i<llimbs && i<limbs; ++i) {
+	QData sum = op[i] + carry;
+	carry = (sum < carry);
+	sum += lp[i];
+	carry += (sum < lp[i]);
+	op[i] = sum;
+    }
+    for (; carry && i<limbs; ++i) {
+	op[i] += carry;
+	carry = (op[i] == 0);
+    }
+}
+
+static void _vl_mul_full_q(int limbs, QData* op, const QData* lp, const QData* rp, QData* tmpp) {
+    // op[0..2*limbs) = lp[0..limbs) * rp[0..limbs)
+    if (limbs < VL_MUL_KARATSUBA_LIMBS) {
+	for (int i=0; i<2*limbs; ++i) op[i] = 0;
+	for (int llimb=0; llimb<limbs; ++llimb) {
+	    QData lhs = lp[llimb];
+	    if (!lhs) continue;
+	    QData carry = 0;
+	    for (int rlimb=0; rlimb<limbs; ++rlimb) {
+		vluint128_t mul = (vluint128_t)(lhs) * rp[rlimb] + op[llimb+rlimb] + carry;
+		op[llimb+rlimb] = (QData)(mul);
+		carry = (QData)(mul >> 64);
+	    }
+	    op[llimb+limbs] = carry;
+	}
+	return;
+    }
+    int low = limbs/2;
+    int hil = limbs - low;  // >= low
+    // a0*b0 and a1*b1 land in separate halves of the output
+    _vl_mul_full_q(low, op, lp, rp, tmpp);
+    _vl_mul_full_q(hil, op+2*low, lp+low, rp+low, tmpp);
+    // (a0+a1)*(b0+b1)
+    QData* lsump = tmpp;
+    QData* rsump = lsump + (hil+1);
+    QData* midp = rsump + (hil+1);
+    QData* subtmpp = midp + 2*(hil+1);
+    for (int i=0; i<=hil; ++i) lsump[i] = rsump[i] = 0;
+    _vl_mul_add_q(hil+1, lsump, lp+low, hil);
+    _vl_mul_add_q(hil+1, lsump, lp, low);
+    _vl_mul_add_q(hil+1, rsump, rp+low, hil);
+    _vl_mul_add_q(hil+1, rsump, rp, low);
+    _vl_mul_full_q(hil+1, midp, lsump, rsump, subtmpp);
+    // Less a0*b0 and a1*b1; the result is never negative
+    int midl = 2*(hil+1);
+    QData borrow = 0;
+    for (int i=0; i<midl; ++i) {
+	QData diff = midp[i];
+	QData borrowOut = (diff < borrow);
+	diff -= borrow;
+	if (i<2*low) { borrowOut += (diff < op[i]); diff -= op[i]; }
+	if (i<2*hil) { borrowOut += (diff < op[2*low+i]); diff -= op[2*low+i]; }
+	midp[i] = diff;
+	borrow = borrowOut;
+    }
+    _vl_mul_add_q(2*limbs-low, op+low, midp, midl);
+}
+
+static void _vl_mul_low_q(int limbs, QData* op, const QData* lp, const QData* rp, QData* tmpp) {
+    // op[0..limbs) = low limbs of lp[0..limbs) * rp[0..limbs)
+    if (limbs < VL_MUL_KARATSUBA_LIMBS) {
+	for (int i=0; i<limbs; ++i) op[i] = 0;
+	for (int llimb=0; llimb<limbs; ++llimb) {
+	    QData lhs = lp[llimb];
+	    if (!lhs) continue;
+	    QData carry = 0;
+	    for (int olimb=llimb; olimb<limbs; ++olimb) {
+		vluint128_t mul = (vluint128_t)(lhs) * rp[olimb-llimb] + op[olimb] + carry;
+		op[olimb] = (QData)(mul);
+		carry = (QData)(mul >> 64);
+	    }
+	}
+	return;
+    }
+    int low = limbs - limbs/2;
+    int hil = limbs - low;  // <= low
+    // a0*b0, of which the low limbs are needed
+    _vl_mul_full_q(low, tmpp, lp, rp, tmpp+2*low);
+    for (int i=0; i<limbs; ++i) op[i] = tmpp[i];
+    // low(a1*b0) + low(a0*b1), shifted up by the low half
+    _vl_mul_low_q(hil, tmpp, lp+low, rp, tmpp+2*hil);
+    _vl_mul_add_q(hil, op+low, tmpp, hil);
+    _vl_mul_low_q(hil, tmpp, lp, rp+low, tmpp+2*hil);
+    _vl_mul_add_q(hil, op+low, tmpp, hil);
+}
+
+WDataOutP _vl_mul_karatsuba_w(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    // Copy into limbs once, so an odd last word needs no special case below
+    int limbs = VL_LIMBS_I(words);
+    vector<QData> tmp (3*limbs + _vl_mul_low_temps(limbs));
+    QData* lp = &tmp[0];
+    QData* rp = lp + limbs;
+    QData* op = rp + limbs;
+    for (int i=0; i<limbs; ++i) {
+	lp[i] = _VL_LIMB_RD(words, lwp, i);
+	rp[i] = _VL_LIMB_RD(words, rwp, i);
+    }
+    _vl_mul_low_q(limbs, op, lp, rp, op+limbs);
+    for (int i=0; i<limbs; ++i) _VL_LIMB_WR(words, owp, i, op[i]);
+    // Last output word is dirty
+    return owp;
+}
+#endif
+
 WDataOutP VL_POW_WWW(int obits, int, int rbits, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
     // obits==lbits, rbits can be different
     owp[0] = 1;
     for (int i=1; i < VL_WORDS_I(obits); i++) owp[i] = 0;
     // cppcheck-suppress variableScope
-    WData powstore[VL_MULS_MAX_WORDS]; // Fixed size, as MSVC++ doesn't allow [words] here
-    WData lastpowstore[VL_MULS_MAX_WORDS]; // Fixed size, as MSVC++ doesn't allow [words] here
-    WData lastoutstore[VL_MULS_MAX_WORDS]; // Fixed size, as MSVC++ doesn't allow [words] here
+    VerilatedWideTemp powtemp (VL_WORDS_I(obits));
+    VerilatedWideTemp lastpowtemp (VL_WORDS_I(obits));
+    VerilatedWideTemp lastouttemp (VL_WORDS_I(obits));
+    WDataOutP powstore = powtemp.datap();
+    WDataOutP lastpowstore = lastpowtemp.datap();
+    WDataOutP lastoutstore = lastouttemp.datap();
     // cppcheck-suppress variableScope
     VL_ASSIGN_W(obits, powstore, lwp);
     for (int bit=0; bit<rbits; bit++) {
@@ -1278,39 +1446,40 @@ string VL_CVT_PACK_STR_NW(int lwords, WDataInP lwp) {
 //===========================================================================
 // Verilated:: Methods
 
-const char* Verilated::s_foreignScope = NULL;
-static vector<const char*> g_foreignScope;
-
 void Verilated::pushForeignScope(const char* name) {
-    g_foreignScope.push_back(name);
-    s_foreignScope = NULL;
+    VerilatedContext* contextp = Verilated::contextp();
+    contextp->impp()->m_foreignScopes.push_back(name);
+    contextp->m_foreignScopep = NULL;
 }
 
 void Verilated::popForeignScope() {
-    g_foreignScope.pop_back();
-    s_foreignScope = NULL;
+    VerilatedContext* contextp = Verilated::contextp();
+    contextp->impp()->m_foreignScopes.pop_back();
+    contextp->m_foreignScopep = NULL;
 }
 
 void Verilated::generateForeignScope() {
-    static string concat_scope;
+    VerilatedContext* contextp = Verilated::contextp();
+    const vector<const char*>& scopes = contextp->impp()->m_foreignScopes;
+    string& concat_scope = contextp->impp()->m_foreignScope;
     concat_scope.clear();
-    if (!g_foreignScope.empty())
+    if (!scopes.empty())
 	concat_scope += " [";
-    for (size_t i=0;i<g_foreignScope.size();++i) {
+    for (size_t i=0;i<scopes.size();++i) {
 	if (i)
 	    concat_scope += " ";
-	concat_scope += g_foreignScope[i];
+	concat_scope += scopes[i];
     }
-    if (!g_foreignScope.empty())
+    if (!scopes.empty())
 	concat_scope += "]";
-    s_foreignScope = concat_scope.c_str();
+    contextp->m_foreignScopep = concat_scope.c_str();
 }
 
 const char* Verilated::catName(const char* n1, const char* n2) {
     // Returns new'ed data
     // Used by symbol table creation to make module names
-    static char* strp = NULL;
-    static size_t len  = 0;
+    static VL_THREAD char* strp = NULL;
+    static VL_THREAD size_t len  = 0;
     size_t newlen = strlen(n1)+strlen(n2)+2;
     if (!strp || newlen > len) {
 	if (strp) delete [] strp;
@@ -69,6 +69,8 @@ typedef void (*VerilatedVoidCb)(void);
 
 class SpTraceVcd;
 class SpTraceVcdCFile;
+class VerilatedContext;
+class VerilatedContextImp;
 class VerilatedScopeNameMap;
 class VerilatedVar;
 class VerilatedVarNameMap;
@@ -111,6 +113,22 @@ public:
     const char* name() const { return m_namep; }	///< Return name of module
 };
 
+//=========================================================================
+/// Temporary words for wide math; on the stack when small, else on the heap
+
+class VerilatedWideTemp {
+private:
+    WData		m_store[VL_MULS_MAX_WORDS];	///< Storage when small enough
+    WDataOutP		m_datap;	///< Words in use
+    VerilatedWideTemp(const VerilatedWideTemp& );	///< N/A, no copy constructor
+    VerilatedWideTemp& operator=(const VerilatedWideTemp& );	///< N/A, no copy
+public:
+    explicit VerilatedWideTemp(int words)
+	: m_datap(VL_UNLIKELY(words > VL_MULS_MAX_WORDS) ? new WData[words] : m_store) {}
+    ~VerilatedWideTemp() { if (VL_UNLIKELY(m_datap != m_store)) delete[] m_datap; }
+    WDataOutP datap() { return m_datap; }	///< Return the words
+};
+
 //=========================================================================
 // Declare nets
 
@@ -155,6 +173,10 @@ public:
 /// Constructor declaration for C++, ala SP_CTOR_IMPL
 # define VL_CTOR_IMP(modname)		modname::modname(const char* __VCname) : VerilatedModule(__VCname)
 
+/// Constructor declaration for C++ top module, which may be given a VerilatedContext
+# define VL_CTOR_CONTEXT_IMP(modname)	modname::modname(const char* __VCname, VerilatedContext* __VCcontextp) \
+	: VerilatedModule(__VCname)
+
 /// Constructor declaration for SystemC, ala SP_CTOR_IMPL
 # define VL_SC_CTOR_IMP(modname)	modname::modname(sc_module_name)
 
@@ -174,7 +196,11 @@ public:
 /// Verilator symbol table base class
 
 class VerilatedSyms {
-    // VerilatedSyms base class exists just so symbol tables have a common pointer type
+    // VerilatedSyms base class exists so symbol tables have a common pointer type,
+    // and so each model's scopes can find the model's context
+public:  // But for internal use only
+    VerilatedContext* const __Vm_contextp;	///< Runtime context of the model, never NULL
+    explicit VerilatedSyms(VerilatedContext* contextp);
 };
 
 //===========================================================================
@@ -216,14 +242,21 @@ public:  // But internals only - called from VerilatedModule's
 };
 
 //===========================================================================
-/// Verilator global static information class
-
-class Verilated {
-    // MEMBERS
-    // Slow path variables
-    static VerilatedVoidCb  s_flushCb;		///< Flush callback function
-
-    static struct Serialized {   // All these members serialized/deserialized
+/// Per-model runtime state
+///
+/// A model constructed with its own VerilatedContext keeps its $finish,
+/// runtime options, $random state, open files and scope names apart from
+/// other models, so models on different threads need no locks.  Models
+/// constructed without one share Verilated's default context.  Each eval()
+/// makes its model's context current on the calling thread, and the
+/// Verilated:: methods below act on the current context.  Compile with
+/// VL_THREADED when evaluating models on more than one thread, and
+/// construct and destroy the models one at a time.
+
+class VerilatedContext {
+    friend class Verilated;
+public:
+    struct Serialized {   // All these members serialized/deserialized
 	// Slow path
 	int		s_randReset;		///< Random reset: 0=all 0s, 1=all 1s, 2=random
 	// Fast path
@@ -233,14 +266,59 @@ class Verilated {
 	bool		s_assertOn;		///< Assertions are enabled
         bool		s_fatalOnVpiError;	///< Stop on vpi error/unsupported
 	Serialized();
-    } s_s;
+    };
+private:
+    // MEMBERS
+    Serialized		m_s;		///< Options and $finish state
+    vluint64_t		m_randState;	///< $random state, as lrand48's
+    const char*		m_foreignScopep;	///< Foreign scope name, or NULL to regenerate
+    VerilatedContextImp* m_impp;	///< Files and scope names
+    // CONSTRUCTORS
+    VerilatedContext(const VerilatedContext&);	///< Copying not allowed
+    VerilatedContext& operator= (const VerilatedContext&);	///< Copying not allowed
+public:
+    VerilatedContext();
+    ~VerilatedContext();
+
+    // METHODS - User called; see the Verilated:: method of the same name
+    void randReset(int val) { m_s.s_randReset=val; }
+    int  randReset() const { return m_s.s_randReset; }
+    void calcUnusedSigs(bool flag) { m_s.s_calcUnusedSigs=flag; }
+    bool calcUnusedSigs() const { return m_s.s_calcUnusedSigs; }
+    void gotFinish(bool flag) { m_s.s_gotFinish=flag; }
+    bool gotFinish() const { return m_s.s_gotFinish; }
+    void assertOn(bool flag) { m_s.s_assertOn=flag; }
+    bool assertOn() const { return m_s.s_assertOn; }
+    void fatalOnVpiError(bool flag) { m_s.s_fatalOnVpiError=flag; }
+    bool fatalOnVpiError() const { return m_s.s_fatalOnVpiError; }
+    /// Seed $random and random resets.  Contexts other than the default all
+    /// start from the same seed; the default context uses lrand48().
+    void randSeed(vluint64_t seed) { m_randState = seed & VL_ULL(0xffffffffffff); }
+
+    // METHODS - INTERNAL USE ONLY
+    VerilatedContextImp* impp() const { return m_impp; }
+    IData randNext31() {
+	m_randState = (m_randState * VL_ULL(0x5deece66d) + 0xb) & VL_ULL(0xffffffffffff);
+	return (IData)(m_randState >> 17);
+    }
+};
+
+//===========================================================================
+/// Verilator global static information class
+
+class Verilated {
+    // MEMBERS
+    // Slow path variables
+    static VerilatedVoidCb  s_flushCb;		///< Flush callback function
+
+    static VerilatedContext s_defaultContext;	///< Context of models not given one
+    static VL_THREAD VerilatedContext* t_contextp;	///< Context of model last used on this thread
 
     static VL_THREAD const VerilatedScope* t_dpiScopep;	///< DPI context scope
     static VL_THREAD const char*	t_dpiFilename;	///< DPI context filename
     static VL_THREAD int		t_dpiLineno;	///< DPI context line number
 
     // foreign modules scope tracking
-    static const char* s_foreignScope;
     static void generateForeignScope();
     
     // no need to be save-restored (serialized) the
@@ -257,41 +335,50 @@ public:
     static void pushForeignScope(const char* name);
     static void popForeignScope();
     static inline const char* foreignScope() {
-	if (VL_UNLIKELY(!s_foreignScope)) generateForeignScope();
-	return s_foreignScope;
+	if (VL_UNLIKELY(!contextp()->m_foreignScopep)) generateForeignScope();
+	return contextp()->m_foreignScopep;
     }
 
+    /// Context the Verilated:: methods act on; that of the model last
+    /// constructed or evaluated on this thread, else the default context
+    static inline VerilatedContext* contextp() {
+	return VL_LIKELY(t_contextp) ? t_contextp : &s_defaultContext;
+    }
+    static VerilatedContext* defaultContextp() { return &s_defaultContext; }
+    /// Internal: Make the given model context current on this thread
+    static inline void threadContextp(VerilatedContext* contextp) { t_contextp = contextp; }
+
     /// Select initial value of otherwise uninitialized signals.
     ////
     /// 0 = Set to zeros
     /// 1 = Set all bits to one
     /// 2 = Randomize all bits
-    static void randReset(int val) { s_s.s_randReset=val; }
-    static int  randReset() { return s_s.s_randReset; }	///< Return randReset value
+    static void randReset(int val) { contextp()->randReset(val); }
+    static int  randReset() { return contextp()->randReset(); }	///< Return randReset value
 
     /// Enable debug of internal verilated code
-    static inline void debug(int level) { s_s.s_debug = level; }
+    static inline void debug(int level) { contextp()->m_s.s_debug = level; }
 #ifdef VL_DEBUG
-    static inline int  debug() { return s_s.s_debug; }	///< Return debug value
+    static inline int  debug() { return contextp()->m_s.s_debug; }	///< Return debug value
 #else
     static inline int  debug() { return 0; }		///< Constant 0 debug, so C++'s optimizer rips up
 #endif
     /// Enable calculation of unused signals
-    static void calcUnusedSigs(bool flag) { s_s.s_calcUnusedSigs=flag; }
-    static bool calcUnusedSigs() { return s_s.s_calcUnusedSigs; }	///< Return calcUnusedSigs value
+    static void calcUnusedSigs(bool flag) { contextp()->calcUnusedSigs(flag); }
+    static bool calcUnusedSigs() { return contextp()->calcUnusedSigs(); }	///< Return calcUnusedSigs value
     /// Did the simulation $finish?
-    static void gotFinish(bool flag) { s_s.s_gotFinish=flag; }
-    static bool gotFinish() { return s_s.s_gotFinish; }	///< Return if got a $finish
+    static void gotFinish(bool flag) { contextp()->gotFinish(flag); }
+    static bool gotFinish() { return contextp()->gotFinish(); }	///< Return if got a $finish
     /// Allow traces to at some point be enabled (disables some optimizations)
     static void traceEverOn(bool flag) {
 	if (flag) { calcUnusedSigs(flag); }
     }
     /// Enable/disable assertions
-    static void assertOn(bool flag) { s_s.s_assertOn=flag; }
-    static bool assertOn() { return s_s.s_assertOn; }
+    static void assertOn(bool flag) { contextp()->assertOn(flag); }
+    static bool assertOn() { return contextp()->assertOn(); }
     /// Enable/disable vpi fatal
-    static void fatalOnVpiError(bool flag) { s_s.s_fatalOnVpiError=flag; }
-    static bool fatalOnVpiError() { return s_s.s_fatalOnVpiError; }
+    static void fatalOnVpiError(bool flag) { contextp()->fatalOnVpiError(flag); }
+    static bool fatalOnVpiError() { return contextp()->fatalOnVpiError(); }
     /// Flush callback for VCD waves
     static void flushCb(VerilatedVoidCb cb);
     static void flushCall() { if (s_flushCb) (*s_flushCb)(); }
@@ -334,8 +421,8 @@ public:
     static const char* dpiFilenamep() { return t_dpiFilename; }
     static int dpiLineno() { return t_dpiLineno; }
     static int exportFuncNum(const char* namep);
-    static size_t serializedSize() { return sizeof(s_s); }
-    static void* serializedPtr() { return &s_s; }
+    static size_t serializedSize() { return sizeof(VerilatedContext::Serialized); }
+    static void* serializedPtr() { return &contextp()->m_s; }
 };
 
 //=========================================================================
@@ -364,6 +451,9 @@ extern WDataOutP VL_ZERO_RESET_W(int obits, WDataOutP outwp);	///< Zero reset a
 
 /// Math
 extern WDataOutP _vl_moddiv_w(int lbits, WDataOutP owp, WDataInP lwp, WDataInP rwp, bool is_modulus);
+#if VL_WIDE_LIMB64 && VL_MUL_KARATSUBA_WORDS
+extern WDataOutP _vl_mul_karatsuba_w(int words, WDataOutP owp, WDataInP lwp, WDataInP rwp);
+#endif
 
 /// File I/O
 extern IData VL_FGETS_IXI(int obits, void* destp, IData fpi);
@@ -455,6 +545,21 @@ static inline QData  VL_EXTENDSIGN_Q(int lbits, QData lhs) { return (-((lhs)&(VL
 // Debugging prints
 void _VL_DEBUG_PRINT_W(int lbits, WDataInP iwp);
 
+//=========================================================================
+// Bit parallel lanes
+// With --bit-parallel each single bit signal is a QData holding one
+// independent simulation per bit; these access a single lane.
+
+/// Number of simulations in each --bit-parallel model
+#define VL_LANES		VL_QUADSIZE
+/// Return value of lane (0..VL_LANES-1) as 0/1
+#define VL_LANE_GET(lanes,lane)	((IData)(((lanes) >> (lane)) & VL_ULL(1)))
+/// Set value of lane to bit (0/1), leaving other lanes unchanged
+#define VL_LANE_SET(lanes,lane,bit) ((lanes) = (((lanes) & ~(VL_ULL(1)<<(lane))) \
+						  | ((QData)((bit)&1) << (lane))))
+/// Return lanes all set to bit (0/1)
+#define VL_LANE_ALL(bit)	((bit) ? ~VL_ULL(0) : VL_ULL(0))
+
 //=========================================================================
 // Pli macros
 
@@ -732,6 +837,44 @@ static inline WDataOutP VL_EXTENDS_WW(int obits, int lbits, WDataOutP owp, WData
     return(owp);
 }
 
+//===================================================================
+// Wide vector helpers
+// Internal usage; VL_SIMD_WORDS words are processed per vector operation.
+
+#if VL_SIMD >= 2
+typedef __m256i VlSimdData;
+# define VL_SIMD_WORDS 8
+# define _VL_SIMD_LD(wp)	_mm256_loadu_si256((const __m256i*)(wp))
+# define _VL_SIMD_ST(wp,v)	_mm256_storeu_si256((__m256i*)(wp), (v))
+# define _VL_SIMD_ZERO()	_mm256_setzero_si256()
+# define _VL_SIMD_ONES()	_mm256_set1_epi32(-1)
+# define _VL_SIMD_AND(l,r)	_mm256_and_si256((l), (r))
+# define _VL_SIMD_OR(l,r)	_mm256_or_si256((l), (r))
+# define _VL_SIMD_XOR(l,r)	_mm256_xor_si256((l), (r))
+# define _VL_SIMD_ISZERO(v)	_mm256_testz_si256((v), (v))
+#elif VL_SIMD >= 1
+typedef __m128i VlSimdData;
+# define VL_SIMD_WORDS 4
+# define _VL_SIMD_LD(wp)	_mm_loadu_si128((const __m128i*)(wp))
+# define _VL_SIMD_ST(wp,v)	_mm_storeu_si128((__m128i*)(wp), (v))
+# define _VL_SIMD_ZERO()	_mm_setzero_si128()
+# define _VL_SIMD_ONES()	_mm_set1_epi32(-1)
+# define _VL_SIMD_AND(l,r)	_mm_and_si128((l), (r))
+# define _VL_SIMD_OR(l,r)	_mm_or_si128((l), (r))
+# define _VL_SIMD_XOR(l,r)	_mm_xor_si128((l), (r))
+# define _VL_SIMD_ISZERO(v)	(_mm_movemask_epi8(_mm_cmpeq_epi8((v), _mm_setzero_si128()))==0xffff)
+#endif
+
+#if VL_SIMD
+// Fold a vector to one word by XOR, for parity
+static inline IData _VL_SIMD_XORWORDS(VlSimdData v) {
+    IData words[VL_SIMD_WORDS];  _VL_SIMD_ST(words, v);
+    IData r = 0;
+    for (int i=0; i < VL_SIMD_WORDS; ++i) r ^= words[i];
+    return r;
+}
+#endif
+
 //===================================================================
 // REDUCTION OPERATORS
 
@@ -750,8 +893,16 @@ static inline IData VL_REDAND_IW(int, int lbits, WDataInP lwp) {
 #define VL_REDOR_I(lhs) (lhs!=0)
 #define VL_REDOR_Q(lhs) (lhs!=0)
 static inline IData VL_REDOR_W(int words, WDataInP lwp) {
+    int i=0;
+#if VL_SIMD
+    if (words >= VL_SIMD_WORDS) {
+	VlSimdData acc = _VL_SIMD_ZERO();
+	for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) acc = _VL_SIMD_OR(acc, _VL_SIMD_LD(lwp+i));
+	if (!_VL_SIMD_ISZERO(acc)) return 1;
+    }
+#endif
     IData equal=0;
-    for (int i=0; i < words; ++i) equal |= lwp[i];
+    for (; i < words; ++i) equal |= lwp[i];
     return(equal!=0);
 }
 
@@ -802,8 +953,16 @@ static inline IData VL_REDXOR_64(QData r) {
 #endif
 }
 static inline IData VL_REDXOR_W(int words, WDataInP lwp) {
-    IData r = lwp[0];
-    for (int i=1; i < words; ++i) r ^= lwp[i];
+    IData r = 0;
+    int i=0;
+#if VL_SIMD
+    if (words >= VL_SIMD_WORDS) {
+	VlSimdData acc = _VL_SIMD_ZERO();
+	for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) acc = _VL_SIMD_XOR(acc, _VL_SIMD_LD(lwp+i));
+	r = _VL_SIMD_XORWORDS(acc);
+    }
+#endif
+    for (; i < words; ++i) r ^= lwp[i];
     return VL_REDXOR_32(r);
 }
 
@@ -821,7 +980,12 @@ static inline IData VL_COUNTONES_Q(QData lhs) {
 }
 static inline IData VL_COUNTONES_W(int words, WDataInP lwp) {
     IData r = 0;
+#if defined(__POPCNT__) && !defined(VL_NO_BUILTINS)
+    // With a population count instruction, the builtin beats VL_COUNTONES_I
+    for (int i=0; (i < words); ++i) r+=__builtin_popcount(lwp[i]);
+#else
     for (int i=0; (i < words); ++i) r+=VL_COUNTONES_I(lwp[i]);
+#endif
     return r;
 }
 
@@ -906,38 +1070,94 @@ static inline IData VL_MOSTSETBITP1_W(int words, WDataInP lwp) {
     return 0;
 }
 
+#if VL_WIDE_LIMB64
+// Internal usage
+// Read or write 64-bit limb number 'limb' of a 'words' wide value.
+// An odd last word is a 32-bit limb, so nothing past the end is touched.
+static inline QData _VL_LIMB_RD(int words, WDataInP lwp, int limb) {
+    if (VL_UNLIKELY(limb*2+1 >= words)) return (QData)(lwp[limb*2]);
+    QData data;  memcpy(&data, lwp+limb*2, sizeof(data));
+    return data;
+}
+static inline void _VL_LIMB_WR(int words, WDataOutP owp, int limb, QData data) {
+    if (VL_UNLIKELY(limb*2+1 >= words)) { owp[limb*2] = (IData)(data); return; }
+    memcpy(owp+limb*2, &data, sizeof(data));
+}
+#endif
+
 //===================================================================
 // SIMPLE LOGICAL OPERATORS
 
 // EMIT_RULE: VL_AND:  oclean=lclean||rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_AND_W(int words, WDataOutP owp,WDataInP lwp,WDataInP rwp){
-    for (int i=0; (i < words); ++i) owp[i] = (lwp[i] & rwp[i]);
+    int i=0;
+#if VL_SIMD
+    for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) {
+	_VL_SIMD_ST(owp+i, _VL_SIMD_AND(_VL_SIMD_LD(lwp+i), _VL_SIMD_LD(rwp+i)));
+    }
+#endif
+    for (; (i < words); ++i) owp[i] = (lwp[i] & rwp[i]);
     return(owp);
 }
 // EMIT_RULE: VL_OR:   oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_OR_W(int words, WDataOutP owp,WDataInP lwp,WDataInP rwp){
-    for (int i=0; (i < words); ++i) owp[i] = (lwp[i] | rwp[i]);
+    int i=0;
+#if VL_SIMD
+    for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) {
+	_VL_SIMD_ST(owp+i, _VL_SIMD_OR(_VL_SIMD_LD(lwp+i), _VL_SIMD_LD(rwp+i)));
+    }
+#endif
+    for (; (i < words); ++i) owp[i] = (lwp[i] | rwp[i]);
     return(owp);
 }
 // EMIT_RULE: VL_CHANGEXOR:  oclean=1; obits=32; lbits==rbits;
 static inline IData VL_CHANGEXOR_W(int words, WDataInP lwp,WDataInP rwp){
+    int i=0;
+#if VL_SIMD
+    if (words >= VL_SIMD_WORDS) {
+	VlSimdData acc = _VL_SIMD_ZERO();
+	for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) {
+	    acc = _VL_SIMD_OR(acc, _VL_SIMD_XOR(_VL_SIMD_LD(lwp+i), _VL_SIMD_LD(rwp+i)));
+	}
+	if (!_VL_SIMD_ISZERO(acc)) return 1;
+    }
+#endif
     IData od = 0;
-    for (int i=0; (i < words); ++i) od |= (lwp[i] ^ rwp[i]);
+    for (; (i < words); ++i) od |= (lwp[i] ^ rwp[i]);
     return(od);
 }
 // EMIT_RULE: VL_XOR:  oclean=lclean&&rclean; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_XOR_W(int words, WDataOutP owp,WDataInP lwp,WDataInP rwp){
-    for (int i=0; (i < words); ++i) owp[i] = (lwp[i] ^ rwp[i]);
+    int i=0;
+#if VL_SIMD
+    for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) {
+	_VL_SIMD_ST(owp+i, _VL_SIMD_XOR(_VL_SIMD_LD(lwp+i), _VL_SIMD_LD(rwp+i)));
+    }
+#endif
+    for (; (i < words); ++i) owp[i] = (lwp[i] ^ rwp[i]);
     return(owp);
 }
 // EMIT_RULE: VL_XNOR:  oclean=dirty; obits=lbits; lbits==rbits;
 static inline WDataOutP VL_XNOR_W(int words, WDataOutP owp,WDataInP lwp,WDataInP rwp){
-    for (int i=0; (i < words); ++i) owp[i] = (lwp[i] ^ ~rwp[i]);
+    int i=0;
+#if VL_SIMD
+    for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) {
+	_VL_SIMD_ST(owp+i, _VL_SIMD_XOR(_VL_SIMD_XOR(_VL_SIMD_LD(lwp+i), _VL_SIMD_LD(rwp+i)),
+					_VL_SIMD_ONES()));
+    }
+#endif
+    for (; (i < words); ++i) owp[i] = (lwp[i] ^ ~rwp[i]);
     return(owp);
 }
 // EMIT_RULE: VL_NOT:  oclean=dirty; obits=lbits;
 static inline WDataOutP VL_NOT_W(int words, WDataOutP owp,WDataInP lwp) {
-    for (int i=0; i < words; ++i) owp[i] = ~(lwp[i]);
+    int i=0;
+#if VL_SIMD
+    for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) {
+	_VL_SIMD_ST(owp+i, _VL_SIMD_XOR(_VL_SIMD_LD(lwp+i), _VL_SIMD_ONES()));
+    }
+#endif
+    for (; i < words; ++i) owp[i] = ~(lwp[i]);
     return(owp);
 }
 
@@ -958,17 +1178,36 @@ static inline WDataOutP VL_NOT_W(int words, WDataOutP owp,WDataInP lwp) {
 
 // Output clean, <lhs> AND <rhs> MUST BE CLEAN
 static inline IData VL_EQ_W(int words, WDataInP lwp, WDataInP rwp) {
+    int i=0;
+#if VL_SIMD
+    if (words >= VL_SIMD_WORDS) {
+	VlSimdData acc = _VL_SIMD_ZERO();
+	for (; i+VL_SIMD_WORDS <= words; i+=VL_SIMD_WORDS) {
+	    acc = _VL_SIMD_OR(acc, _VL_SIMD_XOR(_VL_SIMD_LD(lwp+i), _VL_SIMD_LD(rwp+i)));
+	}
+	if (!_VL_SIMD_ISZERO(acc)) return 0;
+    }
+#endif
     int nequal=0;
-    for (int i=0; (i < words); ++i) nequal |= (lwp[i] ^ rwp[i]);
+    for (; (i < words); ++i) nequal |= (lwp[i] ^ rwp[i]);
     return(nequal==0);
 }
 
 // Internal usage
 static inline int _VL_CMP_W(int words, WDataInP lwp, WDataInP rwp) {
+#if VL_WIDE_LIMB64
+    for (int i=VL_LIMBS_I(words)-1; i>=0; --i) {
+	QData lhs = _VL_LIMB_RD(words, lwp, i);
+	QData rhs = _VL_LIMB_RD(words, rwp, i);
+	if (lhs > rhs) return 1;
+	if (lhs < rhs) return -1;
+    }
+#else
     for (int i=words-1; i>=0; --i) {
 	if (lwp[i] > rwp[i]) return 1;
 	if (lwp[i] < rwp[i]) return -1;
     }
+#endif
     return(0); // ==
 }
 
@@ -1052,16 +1291,41 @@ static inline int _VL_CMPS_W(int lbits, WDataInP lwp, WDataInP rwp) {
 #define VL_MODDIV_WWW(lbits,owp,lwp,rwp) (_vl_moddiv_w(lbits,owp,lwp,rwp,1))
 
 static inline WDataOutP VL_ADD_W(int words, WDataOutP owp,WDataInP lwp,WDataInP rwp){
+#if VL_WIDE_LIMB64
+    QData carry = 0;
+    for (int i=0; i<VL_LIMBS_I(words); ++i) {
+	QData lhs = _VL_LIMB_RD(words, lwp, i);
+	QData sum = lhs + _VL_LIMB_RD(words, rwp, i);
+	QData carryOut = (sum < lhs);
+	sum += carry;
+	carryOut |= (sum < carry);
+	_VL_LIMB_WR(words, owp, i, sum);
+	carry = carryOut;
+    }
+#else
     QData carry = 0;
     for (int i=0; i<words; ++i) {
 	carry = carry + (QData)(lwp[i]) + (QData)(rwp[i]);
 	owp[i] = (carry & VL_ULL(0xffffffff));
 	carry = (carry >> VL_ULL(32)) & VL_ULL(0xffffffff);
     }
+#endif
     return(owp);
 }
 
 static inline WDataOutP VL_SUB_W(int words, WDataOutP owp,WDataInP lwp,WDataInP rwp){
+#if VL_WIDE_LIMB64
+    QData borrow = 0;
+    for (int i=0; i<VL_LIMBS_I(words); ++i) {
+	QData lhs = _VL_LIMB_RD(words, lwp, i);
+	QData rhs = _VL_LIMB_RD(words, rwp, i);
+	QData diff = lhs - rhs;
+	QData borrowOut = (lhs < rhs);
+	borrowOut |= (diff < borrow);
+	_VL_LIMB_WR(words, owp, i, diff - borrow);
+	borrow = borrowOut;
+    }
+#else
     QData carry = 0;
     for (int i=0; i<words; ++i) {
 	carry = carry + (QData)(lwp[i]) + (QData)(IData)(~rwp[i]);
@@ -1069,6 +1333,7 @@ static inline WDataOutP VL_SUB_W(int words, WDataOutP owp,WDataInP lwp,WDataInP
 	owp[i] = (carry & VL_ULL(0xffffffff));
 	carry = (carry >> VL_ULL(32)) & VL_ULL(0xffffffff);
     }
+#endif
     return(owp);
 }
 
@@ -1079,6 +1344,15 @@ static inline IData  VL_NEGATE_I(IData data) { return -data; }
 static inline QData  VL_NEGATE_Q(QData data) { return -data; }
 
 static inline WDataOutP VL_NEGATE_W(int words, WDataOutP owp,WDataInP lwp){
+#if VL_WIDE_LIMB64
+    QData borrow = 0;
+    for (int i=0; i<VL_LIMBS_I(words); ++i) {
+	QData lhs = _VL_LIMB_RD(words, lwp, i);
+	QData borrowOut = (lhs != 0) | borrow;
+	_VL_LIMB_WR(words, owp, i, VL_ULL(0) - lhs - borrow);
+	borrow = borrowOut;
+    }
+#else
     QData carry = 0;
     for (int i=0; i<words; ++i) {
 	carry = carry + (QData)(IData)(~lwp[i]);
@@ -1086,21 +1360,47 @@ static inline WDataOutP VL_NEGATE_W(int words, WDataOutP owp,WDataInP lwp){
 	owp[i] = (carry & VL_ULL(0xffffffff));
 	carry = (carry >> VL_ULL(32)) & VL_ULL(0xffffffff);
     }
+#endif
     return(owp);
 }
 
 static inline WDataOutP VL_MUL_W(int words, WDataOutP owp,WDataInP lwp,WDataInP rwp){
+#if VL_WIDE_LIMB64 && VL_MUL_KARATSUBA_WORDS
+    if (VL_UNLIKELY(words >= VL_MUL_KARATSUBA_WORDS)) {
+	return _vl_mul_karatsuba_w(words, owp, lwp, rwp);
+    }
+#endif
     for (int i=0; i<words; ++i) owp[i] = 0;
+#if VL_WIDE_LIMB64
+    // 64x64->128 bit partial products, carrying along each row once.
+    // Bits above the output width are dropped, including the top half of
+    // an odd last word's limb.
+    int limbs = VL_LIMBS_I(words);
+    for (int llimb=0; llimb<limbs; ++llimb) {
+	QData lhs = _VL_LIMB_RD(words, lwp, llimb);
+	if (!lhs) continue;
+	QData carry = 0;
+	for (int olimb=llimb; olimb<limbs; ++olimb) {
+	    vluint128_t mul = (vluint128_t)(lhs) * _VL_LIMB_RD(words, rwp, olimb-llimb)
+		+ _VL_LIMB_RD(words, owp, olimb) + carry;
+	    _VL_LIMB_WR(words, owp, olimb, (QData)(mul));
+	    carry = (QData)(mul >> 64);
+	}
+    }
+#else
+    // 32x32->64 bit partial products, carrying along each row once
     for (int lword=0; lword<words; ++lword) {
-	for (int rword=0; rword<words; ++rword) {
-	    QData mul = (QData)(lwp[lword]) * (QData)(rwp[rword]);
-	    for (int qword=lword+rword; qword<words; ++qword) {
-		mul += (QData)(owp[qword]);
-		owp[qword] = (mul & VL_ULL(0xffffffff));
-		mul = (mul >> VL_ULL(32)) & VL_ULL(0xffffffff);
-	    }
+	QData lhs = (QData)(lwp[lword]);
+	if (!lhs) continue;
+	QData carry = 0;
+	for (int qword=lword; qword<words; ++qword) {
+	    // Max (2^32-1)^2 + 2*(2^32-1) fits in 64 bits
+	    QData mul = lhs * (QData)(rwp[qword-lword]) + (QData)(owp[qword]) + carry;
+	    owp[qword] = (IData)(mul);
+	    carry = mul >> VL_ULL(32);
 	}
     }
+#endif
     // Last output word is dirty
     return(owp);
 }
@@ -1119,22 +1419,22 @@ static inline QData VL_MULS_QQQ(int,int lbits,int, QData lhs,QData rhs) {
 static inline WDataOutP VL_MULS_WWW(int,int lbits,int, WDataOutP owp,WDataInP lwp,WDataInP rwp){
     int words = VL_WORDS_I(lbits);
     // cppcheck-suppress variableScope
-    WData lwstore[VL_MULS_MAX_WORDS]; // Fixed size, as MSVC++ doesn't allow [words] here
+    VerilatedWideTemp lwstore (words);
     // cppcheck-suppress variableScope
-    WData rwstore[VL_MULS_MAX_WORDS];
+    VerilatedWideTemp rwstore (words);
     WDataInP lwusp = lwp;
     WDataInP rwusp = rwp;
     IData lneg = VL_SIGN_I(lbits,lwp[words-1]);
     if (lneg) { // Negate lhs
-	lwusp = lwstore;
-	VL_NEGATE_W(words, lwstore, lwp);
-	lwstore[words-1] &= VL_MASK_I(lbits);  // Clean it
+	lwusp = lwstore.datap();
+	VL_NEGATE_W(words, lwstore.datap(), lwp);
+	lwstore.datap()[words-1] &= VL_MASK_I(lbits);  // Clean it
     }
     IData rneg = VL_SIGN_I(lbits,rwp[words-1]);
     if (rneg) { // Negate rhs
-	rwusp = rwstore;
-	VL_NEGATE_W(words, rwstore, rwp);
-	rwstore[words-1] &= VL_MASK_I(lbits);  // Clean it
+	rwusp = rwstore.datap();
+	VL_NEGATE_W(words, rwstore.datap(), rwp);
+	rwstore.datap()[words-1] &= VL_MASK_I(lbits);  // Clean it
     }
     VL_MUL_W(words,owp,lwusp,rwusp);
     owp[words-1] &= VL_MASK_I(lbits);  // Clean.  Note it's ok for the multiply to overflow into the sign bit
@@ -1182,17 +1482,17 @@ static inline WDataOutP VL_DIVS_WWW(int lbits, WDataOutP owp,WDataInP lwp,WDataI
     IData lsign = VL_SIGN_I(lbits,lwp[words-1]);
     IData rsign = VL_SIGN_I(lbits,rwp[words-1]);
     // cppcheck-suppress variableScope
-    WData lwstore[VL_MULS_MAX_WORDS]; // Fixed size, as MSVC++ doesn't allow [words] here
+    VerilatedWideTemp lwstore (words);
     // cppcheck-suppress variableScope
-    WData rwstore[VL_MULS_MAX_WORDS];
+    VerilatedWideTemp rwstore (words);
     WDataInP ltup = lwp;
     WDataInP rtup = rwp;
-    if (lsign) { ltup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(VL_WORDS_I(lbits), lwstore, lwp)); }
-    if (rsign) { rtup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(VL_WORDS_I(lbits), rwstore, rwp)); }
+    if (lsign) { ltup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(words, lwstore.datap(), lwp)); }
+    if (rsign) { rtup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(words, rwstore.datap(), rwp)); }
     if ((lsign && !rsign) || (!lsign && rsign)) {
-	IData qNoSign[VL_MULS_MAX_WORDS];
-	VL_DIV_WWW(lbits,qNoSign,ltup,rtup);
-	_VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(VL_WORDS_I(lbits), owp, qNoSign));
+	VerilatedWideTemp qNoSign (words);
+	VL_DIV_WWW(lbits,qNoSign.datap(),ltup,rtup);
+	_VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(words, owp, qNoSign.datap()));
 	return owp;
     } else {
 	return VL_DIV_WWW(lbits,owp,ltup,rtup);
@@ -1203,17 +1503,17 @@ static inline WDataOutP VL_MODDIVS_WWW(int lbits, WDataOutP owp,WDataInP lwp,WDa
     IData lsign = VL_SIGN_I(lbits,lwp[words-1]);
     IData rsign = VL_SIGN_I(lbits,rwp[words-1]);
     // cppcheck-suppress variableScope
-    WData lwstore[VL_MULS_MAX_WORDS]; // Fixed size, as MSVC++ doesn't allow [words] here
+    VerilatedWideTemp lwstore (words);
     // cppcheck-suppress variableScope
-    WData rwstore[VL_MULS_MAX_WORDS];
+    VerilatedWideTemp rwstore (words);
     WDataInP ltup = lwp;
     WDataInP rtup = rwp;
-    if (lsign) { ltup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(VL_WORDS_I(lbits), lwstore, lwp)); }
-    if (rsign) { rtup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(VL_WORDS_I(lbits), rwstore, rwp)); }
+    if (lsign) { ltup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(words, lwstore.datap(), lwp)); }
+    if (rsign) { rtup = _VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(words, rwstore.datap(), rwp)); }
     if (lsign) {  // Only dividend sign matters for modulus
-	WData qNoSign[VL_MULS_MAX_WORDS];
-	VL_MODDIV_WWW(lbits,qNoSign,ltup,rtup);
-	_VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(VL_WORDS_I(lbits), owp, qNoSign));
+	VerilatedWideTemp qNoSign (words);
+	VL_MODDIV_WWW(lbits,qNoSign.datap(),ltup,rtup);
+	_VL_CLEAN_INPLACE_W(lbits, VL_NEGATE_W(words, owp, qNoSign.datap()));
 	return owp;
     } else {
 	return VL_MODDIV_WWW(lbits,owp,ltup,rtup);
@@ -2015,6 +2315,124 @@ static inline void VL_CONSTLO_W_8X(int lsb, WDataOutP obase,
     WDataOutP o = obase + VL_WORDS_I(lsb);
     o[0]=d0; o[1]=d1; o[2]=d2; o[3]=d3; o[4]=d4; o[5]=d5; o[6]=d6; o[7]=d7; }
 
+//======================================================================
+// Constant width specializations
+// When every width is known and at most --wide-template-words words,
+// V3EmitC calls these instead, e.g. VL_AND_W<16>(16, ...).  Each
+// instantiation is a copy of the runtime width function above with the
+// widths as constants and the calls inside it flattened, so the word loops
+// have constant trip counts and unroll, even if the copy isn't itself
+// inlined into its caller.
+
+template <int T_obits> static inline WDataOutP VL_ASSIGN_W(int, WDataOutP owp, WDataInP lwp) VL_ATTR_FLATTEN;
+template <int T_obits> static inline WDataOutP VL_ASSIGN_W(int, WDataOutP owp, WDataInP lwp) {
+    return VL_ASSIGN_W(T_obits, owp, lwp);
+}
+template <int T_obits, int T_lbits> static inline WDataOutP VL_EXTEND_WI(int, int, WDataOutP owp, IData ld) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits> static inline WDataOutP VL_EXTEND_WI(int, int, WDataOutP owp, IData ld) {
+    return VL_EXTEND_WI(T_obits, T_lbits, owp, ld);
+}
+template <int T_obits, int T_lbits> static inline WDataOutP VL_EXTEND_WQ(int, int, WDataOutP owp, QData ld) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits> static inline WDataOutP VL_EXTEND_WQ(int, int, WDataOutP owp, QData ld) {
+    return VL_EXTEND_WQ(T_obits, T_lbits, owp, ld);
+}
+template <int T_obits, int T_lbits> static inline WDataOutP VL_EXTEND_WW(int, int, WDataOutP owp, WDataInP lwp) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits> static inline WDataOutP VL_EXTEND_WW(int, int, WDataOutP owp, WDataInP lwp) {
+    return VL_EXTEND_WW(T_obits, T_lbits, owp, lwp);
+}
+template <int T_words> static inline IData VL_REDOR_W(int, WDataInP lwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline IData VL_REDOR_W(int, WDataInP lwp) {
+    return VL_REDOR_W(T_words, lwp);
+}
+template <int T_words> static inline IData VL_REDXOR_W(int, WDataInP lwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline IData VL_REDXOR_W(int, WDataInP lwp) {
+    return VL_REDXOR_W(T_words, lwp);
+}
+template <int T_words> static inline IData VL_COUNTONES_W(int, WDataInP lwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline IData VL_COUNTONES_W(int, WDataInP lwp) {
+    return VL_COUNTONES_W(T_words, lwp);
+}
+template <int T_words> static inline WDataOutP VL_AND_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline WDataOutP VL_AND_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    return VL_AND_W(T_words, owp, lwp, rwp);
+}
+template <int T_words> static inline WDataOutP VL_OR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline WDataOutP VL_OR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    return VL_OR_W(T_words, owp, lwp, rwp);
+}
+template <int T_words> static inline WDataOutP VL_XOR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline WDataOutP VL_XOR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    return VL_XOR_W(T_words, owp, lwp, rwp);
+}
+template <int T_words> static inline WDataOutP VL_XNOR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline WDataOutP VL_XNOR_W(int, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    return VL_XNOR_W(T_words, owp, lwp, rwp);
+}
+template <int T_words> static inline WDataOutP VL_NOT_W(int, WDataOutP owp, WDataInP lwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline WDataOutP VL_NOT_W(int, WDataOutP owp, WDataInP lwp) {
+    return VL_NOT_W(T_words, owp, lwp);
+}
+template <int T_words> static inline IData VL_EQ_W(int, WDataInP lwp, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_words> static inline IData VL_EQ_W(int, WDataInP lwp, WDataInP rwp) {
+    return VL_EQ_W(T_words, lwp, rwp);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WII(int, int, int, WDataOutP owp, IData ld, IData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WII(int, int, int, WDataOutP owp, IData ld, IData rd) {
+    return VL_CONCAT_WII(T_obits, T_lbits, T_rbits, owp, ld, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WWI(int, int, int, WDataOutP owp, WDataInP lwp, IData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WWI(int, int, int, WDataOutP owp, WDataInP lwp, IData rd) {
+    return VL_CONCAT_WWI(T_obits, T_lbits, T_rbits, owp, lwp, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WIW(int, int, int, WDataOutP owp, IData ld, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WIW(int, int, int, WDataOutP owp, IData ld, WDataInP rwp) {
+    return VL_CONCAT_WIW(T_obits, T_lbits, T_rbits, owp, ld, rwp);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WIQ(int, int, int, WDataOutP owp, IData ld, QData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WIQ(int, int, int, WDataOutP owp, IData ld, QData rd) {
+    return VL_CONCAT_WIQ(T_obits, T_lbits, T_rbits, owp, ld, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WQI(int, int, int, WDataOutP owp, QData ld, IData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WQI(int, int, int, WDataOutP owp, QData ld, IData rd) {
+    return VL_CONCAT_WQI(T_obits, T_lbits, T_rbits, owp, ld, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WQQ(int, int, int, WDataOutP owp, QData ld, QData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WQQ(int, int, int, WDataOutP owp, QData ld, QData rd) {
+    return VL_CONCAT_WQQ(T_obits, T_lbits, T_rbits, owp, ld, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WWQ(int, int, int, WDataOutP owp, WDataInP lwp, QData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WWQ(int, int, int, WDataOutP owp, WDataInP lwp, QData rd) {
+    return VL_CONCAT_WWQ(T_obits, T_lbits, T_rbits, owp, lwp, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WQW(int, int, int, WDataOutP owp, QData ld, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WQW(int, int, int, WDataOutP owp, QData ld, WDataInP rwp) {
+    return VL_CONCAT_WQW(T_obits, T_lbits, T_rbits, owp, ld, rwp);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WWW(int, int, int, WDataOutP owp, WDataInP lwp, WDataInP rwp) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_CONCAT_WWW(int, int, int, WDataOutP owp, WDataInP lwp, WDataInP rwp) {
+    return VL_CONCAT_WWW(T_obits, T_lbits, T_rbits, owp, lwp, rwp);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_SHIFTL_WWI(int, int, int, WDataOutP owp, WDataInP lwp, IData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_SHIFTL_WWI(int, int, int, WDataOutP owp, WDataInP lwp, IData rd) {
+    return VL_SHIFTL_WWI(T_obits, T_lbits, T_rbits, owp, lwp, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_SHIFTR_WWI(int, int, int, WDataOutP owp, WDataInP lwp, IData rd) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits> static inline WDataOutP VL_SHIFTR_WWI(int, int, int, WDataOutP owp, WDataInP lwp, IData rd) {
+    return VL_SHIFTR_WWI(T_obits, T_lbits, T_rbits, owp, lwp, rd);
+}
+template <int T_obits, int T_lbits, int T_rbits, int T_tbits> static inline IData VL_SEL_IWII(int, int, int, int, WDataInP lwp, IData lsb, IData width) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits, int T_tbits> static inline IData VL_SEL_IWII(int, int, int, int, WDataInP lwp, IData lsb, IData width) {
+    return VL_SEL_IWII(T_obits, T_lbits, T_rbits, T_tbits, lwp, lsb, width);
+}
+template <int T_obits, int T_lbits, int T_rbits, int T_tbits> static inline QData VL_SEL_QWII(int, int, int, int, WDataInP lwp, IData lsb, IData width) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits, int T_tbits> static inline QData VL_SEL_QWII(int, int, int, int, WDataInP lwp, IData lsb, IData width) {
+    return VL_SEL_QWII(T_obits, T_lbits, T_rbits, T_tbits, lwp, lsb, width);
+}
+template <int T_obits, int T_lbits, int T_rbits, int T_tbits> static inline WDataOutP VL_SEL_WWII(int, int, int, int, WDataOutP owp, WDataInP lwp, IData lsb, IData width) VL_ATTR_FLATTEN;
+template <int T_obits, int T_lbits, int T_rbits, int T_tbits> static inline WDataOutP VL_SEL_WWII(int, int, int, int, WDataOutP owp, WDataInP lwp, IData lsb, IData width) {
+    return VL_SEL_WWII(T_obits, T_lbits, T_rbits, T_tbits, owp, lwp, lsb, width);
+}
+
 //======================================================================
 
 #endif /*_VERILATED_H_*/
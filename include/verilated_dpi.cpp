@@ -276,12 +276,12 @@ svScope svGetScopeFromName(const char* scopeName) {
 }
 
 int svPutUserData(const svScope scope, void *userKey, void* userData) {
-    VerilatedImp::userInsert(scope,userKey,userData);
+    VerilatedImp::userInsert((const VerilatedScope*)scope,userKey,userData);
     return 0;
 }
 
 void* svGetUserData(const svScope scope, void* userKey) {
-    return VerilatedImp::userFind(scope,userKey);
+    return VerilatedImp::userFind((const VerilatedScope*)scope,userKey);
 }
 
 int svGetCallerInfo(const char** fileNamepp, int *lineNumberp) {
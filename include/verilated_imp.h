@@ -43,40 +43,72 @@ class VerilatedScope;
 //======================================================================
 // Types
 
-class VerilatedImp {
-    // Whole class is internal use only - Global information shared between verilated*.cpp files.
+class VerilatedContextImp {
+    // Whole class is internal use only - Per-context information, see VerilatedContext.
+    friend class VerilatedImp;
+    friend class Verilated;
 
     // TYPES
-    typedef vector<string> ArgVec;
     typedef map<pair<const void*,void*>,void*> UserMap;
-    typedef map<const char*, int, VerilatedCStrCmp>  ExportNameMap;
 
     // MEMBERS
-    static VerilatedImp	s_s;		///< Static Singleton; One and only static this
-
     // Nothing here is save-restored; users expected to re-register appropriately
-
-    ArgVec		m_argVec;	///< Argument list (NOT save-restored, may want different results)
-    bool		m_argVecLoaded;	///< Ever loaded argument list
     UserMap	 	m_userMap;	///< Map of <(scope,userkey), userData>
     VerilatedScopeNameMap	m_nameMap;	///< Map of <scope_name, scope pointer>
-    // Slow - somewhat static:
-    ExportNameMap	m_exportMap;	///< Map of <export_func_proto, func number>
-    int			m_exportNext;	///< Next export funcnum
 
     // File I/O
     vector<FILE*>	m_fdps;		///< File descriptors
     deque<IData>	m_fdFree;	///< List of free descriptors (SLOW - FOPEN/CLOSE only)
 
+    // Foreign scope tracking
+    vector<const char*>	m_foreignScopes;	///< Stack of pushForeignScope names
+    string		m_foreignScope;	///< Joined names, see Verilated::foreignScope()
+
 public: // But only for verilated*.cpp
     // CONSTRUCTORS
-    VerilatedImp() : m_argVecLoaded(false), m_exportNext(0) {
+    VerilatedContextImp() {
 	m_fdps.resize(3);
 	m_fdps[0] = stdin;
 	m_fdps[1] = stdout;
 	m_fdps[2] = stderr;
     }
+    ~VerilatedContextImp() {}
+};
+
+class VerilatedImp {
+    // Whole class is internal use only - Global information shared between verilated*.cpp files.
+
+    // TYPES
+    typedef vector<string> ArgVec;
+    typedef VerilatedContextImp::UserMap UserMap;
+    typedef map<const char*, int, VerilatedCStrCmp>  ExportNameMap;
+
+    // MEMBERS
+    static VerilatedImp	s_s;		///< Static Singleton; One and only static this
+
+    // Nothing here is save-restored; users expected to re-register appropriately
+    // Per-model state is in VerilatedContextImp; this is shared by all contexts,
+    // and only written before models are evaluated.
+
+    ArgVec		m_argVec;	///< Argument list (NOT save-restored, may want different results)
+    bool		m_argVecLoaded;	///< Ever loaded argument list
+    // Slow - somewhat static:
+    ExportNameMap	m_exportMap;	///< Map of <export_func_proto, func number>
+    int			m_exportNext;	///< Next export funcnum
+
+public: // But only for verilated*.cpp
+    // CONSTRUCTORS
+    VerilatedImp() : m_argVecLoaded(false), m_exportNext(0) {}
     ~VerilatedImp() {}
+
+    // ACCESSORS
+    /// Context of the model being evaluated on this thread
+    static inline VerilatedContextImp* contextImpp() { return Verilated::contextp()->impp(); }
+    /// Context of the model owning the given scope, whichever thread asks
+    static inline VerilatedContextImp* contextImpp(const VerilatedScope* scopep) {
+	if (VL_UNLIKELY(!scopep->symsp())) return contextImpp();  // Never configured
+	return scopep->symsp()->__Vm_contextp->impp();
+    }
     static void internalsDump() {
 	VL_PRINTF("internalsDump:\n");
 	VL_PRINTF("  Argv:");
@@ -121,24 +153,28 @@ public: // But only for verilated*.cpp
     // We implement this as a single large map instead of one map per scope
     // There's often many more scopes than userdata's and thus having a ~48byte
     // per map overhead * N scopes would take much more space and cache thrashing.
-    static inline void userInsert(const void* scopep, void* userKey, void* userData) {
-	UserMap::iterator it=s_s.m_userMap.find(make_pair(scopep,userKey));
-	if (it != s_s.m_userMap.end()) it->second = userData;
-	// When we support VL_THREADs, we need a lock around this insert, as it's runtime
-	else s_s.m_userMap.insert(it, make_pair(make_pair(scopep,userKey),userData));
+    // The map is per context, so models evaluated on different threads
+    // don't need a lock around the insert.
+    static inline void userInsert(const VerilatedScope* scopep, void* userKey, void* userData) {
+	UserMap& userMap = contextImpp(scopep)->m_userMap;
+	UserMap::iterator it=userMap.find(make_pair((const void*)scopep,userKey));
+	if (it != userMap.end()) it->second = userData;
+	else userMap.insert(it, make_pair(make_pair((const void*)scopep,userKey),userData));
     }
-    static inline void* userFind(const void* scopep, void* userKey) {
-	UserMap::iterator it=s_s.m_userMap.find(make_pair(scopep,userKey));
-	if (VL_LIKELY(it != s_s.m_userMap.end())) return it->second;
+    static inline void* userFind(const VerilatedScope* scopep, void* userKey) {
+	UserMap& userMap = contextImpp(scopep)->m_userMap;
+	UserMap::iterator it=userMap.find(make_pair((const void*)scopep,userKey));
+	if (VL_LIKELY(it != userMap.end())) return it->second;
 	else return NULL;
     }
 private:
     /// Symbol table destruction cleans up the entries for each scope.
     static void userEraseScope(const VerilatedScope* scopep) {
 	// Slow ok - called once/scope on destruction, so we simply iterate.
-	for (UserMap::iterator it=s_s.m_userMap.begin(); it!=s_s.m_userMap.end(); ) {
+	UserMap& userMap = contextImpp(scopep)->m_userMap;
+	for (UserMap::iterator it=userMap.begin(); it!=userMap.end(); ) {
 	    if (it->first.first == scopep) {
-		s_s.m_userMap.erase(it++);
+		userMap.erase(it++);
 	    } else {
 		++it;
 	    }
@@ -146,7 +182,8 @@ private:
     }
     static void userDump() {
 	bool first = true;
-	for (UserMap::iterator it=s_s.m_userMap.begin(); it!=s_s.m_userMap.end(); ++it) {
+	UserMap& userMap = contextImpp()->m_userMap;
+	for (UserMap::iterator it=userMap.begin(); it!=userMap.end(); ++it) {
 	    if (first) { VL_PRINTF("  userDump:\n"); first=false; }
 	    VL_PRINTF("    DPI_USER_DATA scope %p key %p: %p\n",
 		      it->first.first, it->first.second, it->second);
@@ -157,32 +194,36 @@ public: // But only for verilated*.cpp
     // METHODS - scope name
     static void scopeInsert(const VerilatedScope* scopep) {
 	// Slow ok - called once/scope at construction
-	VerilatedScopeNameMap::iterator it=s_s.m_nameMap.find(scopep->name());
-	if (it == s_s.m_nameMap.end()) {
-	    s_s.m_nameMap.insert(it, make_pair(scopep->name(),scopep));
+	VerilatedScopeNameMap& nameMap = contextImpp(scopep)->m_nameMap;
+	VerilatedScopeNameMap::iterator it=nameMap.find(scopep->name());
+	if (it == nameMap.end()) {
+	    nameMap.insert(it, make_pair(scopep->name(),scopep));
 	}
     }
     static inline const VerilatedScope* scopeFind(const char* namep) {
-	VerilatedScopeNameMap::iterator it=s_s.m_nameMap.find(namep);
-	if (VL_LIKELY(it != s_s.m_nameMap.end())) return it->second;
+	VerilatedScopeNameMap& nameMap = contextImpp()->m_nameMap;
+	VerilatedScopeNameMap::iterator it=nameMap.find(namep);
+	if (VL_LIKELY(it != nameMap.end())) return it->second;
 	else return NULL;
     }
     static void scopeErase(const VerilatedScope* scopep) {
 	// Slow ok - called once/scope at destruction
 	userEraseScope(scopep);
-	VerilatedScopeNameMap::iterator it=s_s.m_nameMap.find(scopep->name());
-	if (it != s_s.m_nameMap.end()) s_s.m_nameMap.erase(it);
+	VerilatedScopeNameMap& nameMap = contextImpp(scopep)->m_nameMap;
+	VerilatedScopeNameMap::iterator it=nameMap.find(scopep->name());
+	if (it != nameMap.end() && it->second == scopep) nameMap.erase(it);
     }
     static void scopesDump() {
 	VL_PRINTF("  scopesDump:\n");
-	for (VerilatedScopeNameMap::iterator it=s_s.m_nameMap.begin(); it!=s_s.m_nameMap.end(); ++it) {
+	VerilatedScopeNameMap& nameMap = contextImpp()->m_nameMap;
+	for (VerilatedScopeNameMap::iterator it=nameMap.begin(); it!=nameMap.end(); ++it) {
 	    const VerilatedScope* scopep = it->second;
 	    scopep->scopeDump();
 	}
 	VL_PRINTF("\n");
     }
     static const VerilatedScopeNameMap* scopeNameMap() {
-        return &s_s.m_nameMap;
+        return &contextImpp()->m_nameMap;
     }
 
 public: // But only for verilated*.cpp
@@ -233,28 +274,31 @@ public: // But only for verilated*.cpp
     // METHODS - file IO
     static IData fdNew(FILE* fp) {
 	if (VL_UNLIKELY(!fp)) return 0;
+	VerilatedContextImp* impp = contextImpp();
 	// Bit 31 indicates it's a descriptor not a MCD
-	if (s_s.m_fdFree.empty()) {
+	if (impp->m_fdFree.empty()) {
 	    // Need to create more space in m_fdps and m_fdFree
-	    size_t start = s_s.m_fdps.size();
-	    s_s.m_fdps.resize(start*2);
-	    for (size_t i=start; i<start*2; ++i) s_s.m_fdFree.push_back((IData)i);
+	    size_t start = impp->m_fdps.size();
+	    impp->m_fdps.resize(start*2);
+	    for (size_t i=start; i<start*2; ++i) impp->m_fdFree.push_back((IData)i);
 	}
-	IData idx = s_s.m_fdFree.back(); s_s.m_fdFree.pop_back();
-	s_s.m_fdps[idx] = fp;
+	IData idx = impp->m_fdFree.back(); impp->m_fdFree.pop_back();
+	impp->m_fdps[idx] = fp;
 	return (idx | (1UL<<31));  // bit 31 indicates not MCD
     }
     static void fdDelete(IData fdi) {
+	VerilatedContextImp* impp = contextImpp();
 	IData idx = VL_MASK_I(31) & fdi;
-	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= s_s.m_fdps.size())) return;
-	if (VL_UNLIKELY(!s_s.m_fdps[idx])) return;  // Already free
-	s_s.m_fdps[idx] = NULL;
-	s_s.m_fdFree.push_back(idx);
+	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= impp->m_fdps.size())) return;
+	if (VL_UNLIKELY(!impp->m_fdps[idx])) return;  // Already free
+	impp->m_fdps[idx] = NULL;
+	impp->m_fdFree.push_back(idx);
     }
     static inline FILE* fdToFp(IData fdi) {
+	VerilatedContextImp* impp = contextImpp();
 	IData idx = VL_MASK_I(31) & fdi;
-	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= s_s.m_fdps.size())) return NULL;
-	return s_s.m_fdps[idx];
+	if (VL_UNLIKELY(!(fdi & (1ULL<<31)) || idx >= impp->m_fdps.size())) return NULL;
+	return impp->m_fdps[idx];
     }
 };
 
@@ -36,6 +36,7 @@
 #ifdef __GNUC__
 # define VL_ATTR_ALIGNED(alignment) __attribute__ ((aligned (alignment)))
 # define VL_ATTR_ALWINLINE __attribute__ ((always_inline))
+# define VL_ATTR_FLATTEN __attribute__ ((flatten))
 # define VL_ATTR_NORETURN __attribute__ ((noreturn))
 # ifdef _WIN32
 #  define VL_ATTR_PRINTF(fmtArgNum)  // GCC with MS runtime will fool the print arg checker
@@ -52,6 +53,7 @@
 #elif defined(_MSC_VER)
 # define VL_ATTR_ALIGNED(alignment)
 # define VL_ATTR_ALWINLINE
+# define VL_ATTR_FLATTEN
 # define VL_ATTR_NORETURN
 # define VL_ATTR_PRINTF(fmtArgNum)
 # define VL_ATTR_UNUSED
@@ -64,6 +66,7 @@
 #else
 # define VL_ATTR_ALIGNED(alignment)	///< Align structure to specified byte alignment
 # define VL_ATTR_ALWINLINE		///< Inline, even when not optimizing
+# define VL_ATTR_FLATTEN		///< Inline all calls inside this function
 # define VL_ATTR_NORETURN		///< Function does not ever return
 # define VL_ATTR_PRINTF(fmtArgNum)	///< Function with printf format checking
 # define VL_ATTR_UNUSED			///< Function that may be never used
@@ -251,10 +254,59 @@ typedef unsigned long long	vluint64_t;	///< 64-bit unsigned type
 /// Words this number of bits needs (1 bit=1 word)
 #define VL_WORDS_I(nbits) (((nbits)+(VL_WORDSIZE-1))/VL_WORDSIZE)
 
+//=========================================================================
+// Wide data limbs
+
+/// Wide (>64 bit) data is stored in VL_WORDSIZE words, least significant
+/// first.  On little-endian hosts with a 128-bit product type, each pair of
+/// words is also a 64-bit limb, so wide math processes two words at a time.
+/// Define VL_WIDE_LIMB64=0 to force one word at a time.
+#ifndef VL_WIDE_LIMB64
+# if defined(__SIZEOF_INT128__) && defined(__BYTE_ORDER__) \
+	&& (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#  define VL_WIDE_LIMB64 1
+# else
+#  define VL_WIDE_LIMB64 0
+# endif
+#endif
+#if VL_WIDE_LIMB64
+__extension__ typedef unsigned __int128 vluint128_t;	///< 128-bit unsigned type, for wide products
+#endif
+
+/// 64-bit limbs this number of words needs (odd last word is a short limb)
+#define VL_LIMBS_I(words) (((words)+1)/2)
+
+//=========================================================================
+// Wide data vector instructions
+
+/// Wide bitwise, equality and reduction helpers use the widest vector
+/// instructions the compiler was told the host has: 2=AVX2, 1=SSE2, 0=none.
+/// Dispatch is at compile time, so build with e.g. -mavx2 to get AVX2.
+/// Define VL_SIMD=0 to force one word at a time.
+#ifndef VL_SIMD
+# if defined(VL_NO_BUILTINS)
+#  define VL_SIMD 0
+# elif defined(__AVX2__)
+#  define VL_SIMD 2
+# elif defined(__SSE2__)
+#  define VL_SIMD 1
+# else
+#  define VL_SIMD 0
+# endif
+#endif
+#if VL_SIMD >= 2
+# include <immintrin.h>
+#elif VL_SIMD >= 1
+# include <emmintrin.h>
+#endif
+
 //=========================================================================
 // Verilated function size macros
 
-#define VL_MULS_MAX_WORDS 16		///< Max size in words of MULS operation
+#define VL_MULS_MAX_WORDS 16		///< Max size in words of math temporaries kept on the stack
+#ifndef VL_MUL_KARATSUBA_WORDS
+# define VL_MUL_KARATSUBA_WORDS 64	///< Min size in words of multiply to split with Karatsuba, 0=never
+#endif
 #define VL_TO_STRING_MAX_WORDS 64	///< Max size in words of String conversion operation
 
 //=========================================================================
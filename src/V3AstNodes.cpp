@@ -152,6 +152,13 @@ bool AstVar::isSigPublic() const {
     return (m_sigPublic || (v3Global.opt.allPublic() && !isTemp() && !isGenVar()));
 }
 
+bool AstVar::isLaneShared() const {
+    // All lanes share the clocks, their edge detection temporaries and constants
+    return (isUsedClock() || isParam() || isConst()
+	    || name().substr(0,12) == "__Vclklast__"
+	    || name().substr(0,11) == "__VinpClk__");
+}
+
 bool AstVar::isScQuad() const {
     return (isSc() && isQuad() && !isScBv() && !isScBigUint());
 }
@@ -1154,6 +1154,7 @@ public:
     bool	isGenVar() const { return (varType()==AstVarType::GENVAR); }
     bool	isBitLogic() const { AstBasicDType* bdtypep = basicp(); return bdtypep && bdtypep->isBitLogic(); }
     bool	isUsedClock() const { return m_usedClock; }
+    bool	isLaneShared() const;	// Same value in all --bit-parallel or --batch lanes
     bool	isUsedParam() const { return m_usedParam; }
     bool	isUsedLoopIdx() const { return m_usedLoopIdx; }
     bool	isSc() const { return m_sc; }
@@ -0,0 +1,430 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Bit-parallel and batched lane conversion
+//
+// Code available from: http://www.veripool.org/verilator
+//
+//*************************************************************************
+//
+// Copyright 2003-2017 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3BitParallel's Transformations:
+//
+// With --bit-parallel, each single bit signal becomes a 64 bit lane mask,
+// so the model simulates 64 independent stimulus streams at once.
+// With --batch, EmitC makes each signal an array with one element (lane)
+// per instance, and the statements writing them loop over the lanes;
+// here only the per-lane IFs need converting.
+//
+// Each variable:
+//	Clocks (and the clock edge temporaries made from them) stay scalar,
+//	    as all lanes share the clock.
+//	--bit-parallel: Other one bit variables become 64 bits wide.
+//	    Anything else is an error.
+// Each expression referencing a lane variable (--bit-parallel only):
+//	Constants and scalar terms are broadcast to all lanes.
+//	AND/OR/XOR/NOT stay as is.
+//	Logical ops, ==, != and reductions become bitwise ops.
+//	COND(c,a,b) becomes (c & a) | (~c & b).
+// Each IF with a per-lane condition:
+//	The condition is latched into a __Vlanepred temporary.
+//	Each assignment below becomes  v = (pred & rhs) | (~pred & v),
+//	    or with --batch  v = pred ? rhs : v.
+//	The IF is replaced with the predicated assignments.
+// IFs on scalar (clock) conditions are unchanged.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+#include <cstdio>
+#include <cstdarg>
+#include <unistd.h>
+
+#include "V3Global.h"
+#include "V3BitParallel.h"
+#include "V3Ast.h"
+#include "V3Stats.h"
+
+//######################################################################
+
+enum { BP_LANE_VAR = 1, BP_SCALAR_VAR = 2 };
+
+class BitParallelVarVisitor : public AstNVisitor {
+private:
+    // NODE STATE
+    // Entire netlist:
+    //  AstVar::user1()		-> int.  BP_LANE_VAR or BP_SCALAR_VAR
+
+    // STATE
+    bool		m_batch;	// --batch, else --bit-parallel
+    V3Double0		m_statLaneVars;	// Statistic tracking
+
+    // VISITORS
+    virtual void visit(AstVar* nodep) {
+	if (nodep->isParam()) return;
+	if (nodep->isLaneShared()) {
+	    nodep->user1(BP_SCALAR_VAR);
+	} else if (m_batch) {
+	    nodep->user1(BP_LANE_VAR);
+	    if (nodep->isSigPublic()) {
+		nodep->v3error("Unsupported: --batch with public signal: "<<nodep->prettyName());
+	    }
+	    ++m_statLaneVars;
+	} else if (nodep->width() == 1 && nodep->dtypeSkipRefp()->castBasicDType()) {
+	    nodep->user1(BP_LANE_VAR);
+	    nodep->dtypeSetLogicSized(VL_QUADSIZE, VL_QUADSIZE, AstNumeric::UNSIGNED);
+	    ++m_statLaneVars;
+	} else {
+	    nodep->v3error("Unsupported: --bit-parallel requires single bit signals: "
+			   <<nodep->prettyName());
+	}
+    }
+    virtual void visit(AstNodeMath* nodep) {}  // Short circuit
+    virtual void visit(AstNodeStmt* nodep) {}  // Short circuit
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+
+public:
+    // CONSTUCTORS
+    BitParallelVarVisitor(AstNetlist* nodep, bool batch) {
+	m_batch = batch;
+	nodep->accept(*this);
+    }
+    virtual ~BitParallelVarVisitor() {
+	V3Stats::addStat(string("Optimizations, ")+(m_batch ? "Batch" : "Bit parallel")
+			 +" lane signals", m_statLaneVars);
+    }
+};
+
+//######################################################################
+
+class BitParallelVisitor : public AstNVisitor {
+private:
+    // NODE STATE
+    // Entire netlist:
+    //  AstVar::user1()		-> int.  BP_LANE_VAR or BP_SCALAR_VAR (BitParallelVarVisitor)
+    //  AstNode::user2()	-> bool.  Expression is per-lane (a lane mask with --bit-parallel)
+    //  AstNodeAssign::user3()	-> bool.  Already converted
+    AstUser1InUse	m_inuser1;
+    AstUser2InUse	m_inuser2;
+    AstUser3InUse	m_inuser3;
+
+    // STATE
+    bool		m_batch;	// --batch, else --bit-parallel
+    AstScope*		m_scopep;	// Current scope
+    AstNode*		m_predp;	// Lane predicate of current statement, NULL if all lanes
+    int			m_predNum;	// Number of predicate temporaries created
+    V3Double0		m_statLaneIfs;	// Statistic tracking
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+
+    static void laneDType(AstNode* nodep) {
+	nodep->dtypeSetLogicSized(VL_QUADSIZE, VL_QUADSIZE, AstNumeric::UNSIGNED);
+    }
+    bool isLane(AstNode* nodep) const {
+	return nodep && nodep->user2();
+    }
+    string optName() const { return m_batch ? "--batch" : "--bit-parallel"; }
+    void unsupported(AstNode* nodep) {
+	nodep->v3error("Unsupported: "<<optName()<<" with per-lane "<<nodep->prettyTypeName());
+    }
+    void fixCloneLvalue(AstNode* nodep) {
+	// The clone of an assignment's lhs is read as the old value
+	if (nodep->castVarRef()) nodep->castVarRef()->lvalue(false);
+	// Iterate
+	if (nodep->op1p()) fixCloneLvalue(nodep->op1p());
+	if (nodep->op2p()) fixCloneLvalue(nodep->op2p());
+	if (nodep->op3p()) fixCloneLvalue(nodep->op3p());
+	if (nodep->op4p()) fixCloneLvalue(nodep->op4p());
+    }
+
+    AstNode* toLane(AstNode* nodep) {
+	// Make nodep a lane mask, broadcasting scalars; return the replacement
+	if (isLane(nodep)) return nodep;
+	AstNode* newp;
+	if (AstConst* constp = nodep->castConst()) {
+	    V3Number num (nodep->fileline(), VL_QUADSIZE, 0);
+	    if (!constp->num().isEqZero()) num.setAllBits1();
+	    newp = new AstConst(nodep->fileline(), num);
+	    nodep->replaceWith(newp); nodep->deleteTree(); VL_DANGLING(nodep);
+	} else {
+	    if (nodep->width() != 1) {
+		nodep->v3error("Unsupported: --bit-parallel with multi-bit term in per-lane logic");
+	    }
+	    // -(uint64)x is all ones when x is set
+	    AstNRelinker handle;
+	    nodep->unlinkFrBack(&handle);
+	    newp = new AstNegate(nodep->fileline(),
+				 new AstExtend(nodep->fileline(), nodep, VL_QUADSIZE));
+	    handle.relink(newp);
+	}
+	newp->user2(true);
+	return newp;
+    }
+    AstNode* newMux(FileLine* fl, AstNode* condp, AstNode* thenp, AstNode* elsep) {
+	// (cond & then) | (~cond & else), all arguments are lane masks
+	// With --batch each lane is a separate C++ element, so a plain ?: works
+	AstNode* newp;
+	if (m_batch) {
+	    newp = new AstCond(fl, condp, thenp, elsep);
+	} else {
+	    newp = new AstOr(fl, new AstAnd(fl, condp, thenp),
+			     new AstAnd(fl, new AstNot(fl, condp->cloneTree(false)), elsep));
+	}
+	newp->user2(true);
+	return newp;
+    }
+    void replaceLane(AstNode* nodep, AstNode* newp) {
+	newp->user2(true);
+	nodep->replaceWith(newp);
+	pushDeletep(nodep); VL_DANGLING(nodep);
+    }
+    bool laneChildren(AstNode* nodep) {
+	// Iterate, and if any operand is per-lane, broadcast the others.
+	// Return true if nodep needs converting to lane mask operations.
+	nodep->iterateChildren(*this);
+	if (!isLane(nodep->op1p()) && !isLane(nodep->op2p())
+	    && !isLane(nodep->op3p()) && !isLane(nodep->op4p())) return false;
+	if (m_batch) {
+	    // C++ operators already work on a single lane
+	    nodep->user2(true);
+	    return false;
+	}
+	if (nodep->op1p()) toLane(nodep->op1p());
+	if (nodep->op2p()) toLane(nodep->op2p());
+	if (nodep->op3p()) toLane(nodep->op3p());
+	return true;
+    }
+    AstVarScope* newPredTemp(FileLine* fl) {
+	if (!m_scopep) v3fatalSrc("Per-lane IF outside of scoped function");
+	AstVar* varp = new AstVar(fl, AstVarType::MODULETEMP,
+				  "__Vlanepred"+cvtToStr(++m_predNum),
+				  VFlagLogicPacked(), m_batch ? 1 : VL_QUADSIZE);
+	varp->user1(BP_LANE_VAR);
+	m_scopep->modp()->addStmtp(varp);
+	AstVarScope* vscp = new AstVarScope(fl, m_scopep, varp);
+	m_scopep->addVarp(vscp);
+	return vscp;
+    }
+    AstNode* newPredRef(FileLine* fl, AstVarScope* vscp, bool invert) {
+	// Predicate of a branch: outer predicate & (invert ? ~temp : temp)
+	AstNode* newp = new AstVarRef(fl, vscp, false);
+	if (invert) newp = new AstNot(fl, newp);
+	if (m_predp) newp = new AstAnd(fl, m_predp->cloneTree(false), newp);
+	return newp;
+    }
+
+    // VISITORS
+    virtual void visit(AstVarRef* nodep) {
+	if (nodep->varp()->user1() == BP_LANE_VAR) {
+	    nodep->dtypeFrom(nodep->varp());
+	    nodep->user2(true);
+	}
+    }
+    virtual void visit(AstVarScope* nodep) {
+	nodep->dtypeFrom(nodep->varp());
+    }
+    virtual void visit(AstCFunc* nodep) {
+	m_scopep = nodep->scopep();
+	nodep->iterateChildren(*this);
+	m_scopep = NULL;
+    }
+
+    // VISITORS - expressions
+    virtual void visit(AstNot* nodep) {
+	if (laneChildren(nodep)) { laneDType(nodep); nodep->user2(true); }
+    }
+    virtual void visit(AstAnd* nodep) {
+	if (laneChildren(nodep)) { laneDType(nodep); nodep->user2(true); }
+    }
+    virtual void visit(AstOr* nodep) {
+	if (laneChildren(nodep)) { laneDType(nodep); nodep->user2(true); }
+    }
+    virtual void visit(AstXor* nodep) {
+	if (laneChildren(nodep)) { laneDType(nodep); nodep->user2(true); }
+    }
+    virtual void visit(AstXnor* nodep) {
+	if (laneChildren(nodep)) { laneDType(nodep); nodep->user2(true); }
+    }
+    virtual void visit(AstLogNot* nodep) {
+	if (laneChildren(nodep)) {
+	    replaceLane(nodep, new AstNot(nodep->fileline(), nodep->lhsp()->unlinkFrBack()));
+	}
+    }
+    virtual void visit(AstLogAnd* nodep) {
+	if (laneChildren(nodep)) {
+	    replaceLane(nodep, new AstAnd(nodep->fileline(), nodep->lhsp()->unlinkFrBack(),
+					  nodep->rhsp()->unlinkFrBack()));
+	}
+    }
+    virtual void visit(AstLogOr* nodep) {
+	if (laneChildren(nodep)) {
+	    replaceLane(nodep, new AstOr(nodep->fileline(), nodep->lhsp()->unlinkFrBack(),
+					 nodep->rhsp()->unlinkFrBack()));
+	}
+    }
+    virtual void visit(AstLogIf* nodep) {
+	if (laneChildren(nodep)) {
+	    replaceLane(nodep, new AstOr(nodep->fileline(),
+					 new AstNot(nodep->fileline(), nodep->lhsp()->unlinkFrBack()),
+					 nodep->rhsp()->unlinkFrBack()));
+	}
+    }
+    void visitEq(AstNodeBiop* nodep, bool invert) {
+	if (laneChildren(nodep)) {
+	    AstNode* newp = new AstXor(nodep->fileline(), nodep->lhsp()->unlinkFrBack(),
+				       nodep->rhsp()->unlinkFrBack());
+	    if (invert) newp = new AstNot(nodep->fileline(), newp);
+	    replaceLane(nodep, newp);
+	}
+    }
+    virtual void visit(AstLogIff* nodep) { visitEq(nodep, true); }
+    virtual void visit(AstEq* nodep) { visitEq(nodep, true); }
+    virtual void visit(AstEqCase* nodep) { visitEq(nodep, true); }
+    virtual void visit(AstNeq* nodep) { visitEq(nodep, false); }
+    virtual void visit(AstNeqCase* nodep) { visitEq(nodep, false); }
+    void visitRed(AstNodeUniop* nodep, bool invert) {
+	// Reduction of a single bit is the bit itself
+	if (laneChildren(nodep)) {
+	    AstNode* newp = nodep->lhsp()->unlinkFrBack();
+	    if (invert) newp = new AstNot(nodep->fileline(), newp);
+	    replaceLane(nodep, newp);
+	}
+    }
+    virtual void visit(AstRedAnd* nodep) { visitRed(nodep, false); }
+    virtual void visit(AstRedOr* nodep) { visitRed(nodep, false); }
+    virtual void visit(AstRedXor* nodep) { visitRed(nodep, false); }
+    virtual void visit(AstRedXnor* nodep) { visitRed(nodep, true); }
+    virtual void visit(AstNodeCond* nodep) {
+	if (laneChildren(nodep)) {
+	    replaceLane(nodep, newMux(nodep->fileline(), nodep->condp()->unlinkFrBack(),
+				      nodep->expr1p()->unlinkFrBack(),
+				      nodep->expr2p()->unlinkFrBack()));
+	}
+    }
+    virtual void visit(AstNodeMath* nodep) {
+	if (laneChildren(nodep)) unsupported(nodep);
+    }
+
+    // VISITORS - statements
+    virtual void visit(AstNodeAssign* nodep) {
+	// Predicated statements move up when their IF is removed, don't convert twice
+	if (nodep->user3SetOnce()) return;
+	nodep->rhsp()->iterateAndNext(*this);
+	nodep->lhsp()->iterateAndNext(*this);
+	AstVarRef* lhsp = nodep->lhsp()->castVarRef();
+	if (!isLane(nodep->lhsp())) {
+	    if (isLane(nodep->rhsp()) || m_predp) {
+		if (lhsp && lhsp->varp()->user1() == BP_SCALAR_VAR) {
+		    nodep->v3error("Unsupported: "<<optName()<<" clock driven by per-lane logic: "
+				   <<lhsp->prettyName());
+		} else {
+		    unsupported(nodep);
+		}
+	    }
+	    return;
+	}
+	if (!lhsp && !m_batch) { unsupported(nodep); return; }
+	AstNode* rhsp = m_batch ? nodep->rhsp() : toLane(nodep->rhsp());
+	if (m_predp) {
+	    // Lanes where the predicate is clear keep their old value
+	    FileLine* fl = nodep->fileline();
+	    AstNRelinker handle;
+	    rhsp->unlinkFrBack(&handle);
+	    AstNode* oldp = nodep->lhsp()->cloneTree(false);
+	    fixCloneLvalue(oldp);
+	    oldp->user2(true);
+	    handle.relink(newMux(fl, m_predp->cloneTree(false), rhsp, oldp));
+	}
+    }
+    virtual void visit(AstIf* nodep) {
+	nodep->condp()->iterateAndNext(*this);
+	if (!isLane(nodep->condp())) {
+	    nodep->ifsp()->iterateAndNext(*this);
+	    nodep->elsesp()->iterateAndNext(*this);
+	    return;
+	}
+	UINFO(8,"  LaneIf "<<nodep<<endl);
+	++m_statLaneIfs;
+	// Latch the condition, as the branches may change its inputs
+	FileLine* fl = nodep->fileline();
+	AstVarScope* predVscp = newPredTemp(fl);
+	AstNode* latchp = new AstAssign(fl, new AstVarRef(fl, predVscp, true),
+					nodep->condp()->unlinkFrBack());
+	latchp->user3(true);
+	nodep->addHereThisAsNext(latchp);
+	AstNode* outerPredp = m_predp;
+	{
+	    m_predp = newPredRef(fl, predVscp, false);
+	    nodep->ifsp()->iterateAndNext(*this);
+	    pushDeletep(m_predp);
+	    m_predp = newPredRef(fl, predVscp, true);
+	    nodep->elsesp()->iterateAndNext(*this);
+	    pushDeletep(m_predp);
+	}
+	m_predp = outerPredp;
+	// Both branches now run unconditionally
+	AstNode* stmtsp = NULL;
+	if (nodep->ifsp()) stmtsp = AstNode::addNext(stmtsp, nodep->ifsp()->unlinkFrBackWithNext());
+	if (nodep->elsesp()) stmtsp = AstNode::addNext(stmtsp, nodep->elsesp()->unlinkFrBackWithNext());
+	if (stmtsp) nodep->addNextHere(stmtsp);
+	nodep->unlinkFrBack(); pushDeletep(nodep); VL_DANGLING(nodep);
+    }
+    virtual void visit(AstComment* nodep) {}
+    virtual void visit(AstNodeStmt* nodep) {
+	if (m_predp) {
+	    nodep->v3error("Unsupported: "<<optName()<<" with "<<nodep->prettyTypeName()
+			   <<" under per-lane condition");
+	}
+	nodep->iterateChildren(*this);
+	if (isLane(nodep->op1p()) || isLane(nodep->op2p())
+	    || isLane(nodep->op3p()) || isLane(nodep->op4p())) {
+	    unsupported(nodep);
+	}
+    }
+    //--------------------
+    // Default: Just iterate
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+
+public:
+    // CONSTUCTORS
+    explicit BitParallelVisitor(AstNetlist* nodep) {
+	m_batch = v3Global.opt.batch() != 0;
+	m_scopep = NULL;
+	m_predp = NULL;
+	m_predNum = 0;
+	{ BitParallelVarVisitor varVisitor (nodep, m_batch); }
+	nodep->accept(*this);
+    }
+    virtual ~BitParallelVisitor() {
+	V3Stats::addStat(string("Optimizations, ")+(m_batch ? "Batch" : "Bit parallel")
+			 +" lane ifs", m_statLaneIfs);
+    }
+};
+
+//######################################################################
+// BitParallel class functions
+
+void V3BitParallel::bitParallelAll(AstNetlist* nodep) {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    BitParallelVisitor visitor (nodep);
+    V3Global::dumpCheckGlobalTree("bitparallel", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
@@ -28,9 +28,10 @@
 //						    (other items))
 //						body
 //		Or, converts to a if/else tree.
+//	    Wide or incomplete tables with constants and no masking (decoders, address muxes)
+//		Sort the values into ranges of identical items, and use a balanced
+//		tree of < compares down to a few == compares at the leaves.
 //	FUTURES:
-//	    Large 16+ bit tables with constants and no masking (address muxes)
-//		Enter all into multimap, sort by value and use a tree of < and == compares.
 //	    "Diagonal" find of {rightmost,leftmost} bit {set,clear}
 //		Ignoring mask, check each value is unique (using multimap as above?)
 //		Each branch is then mask-and-compare operation (IE <000000001_000000000 at midpoint.)
@@ -43,6 +44,8 @@
 #include <cstdarg>
 #include <unistd.h>
 #include <algorithm>
+#include <vector>
+#include <set>
 
 #include "V3Global.h"
 #include "V3Case.h"
@@ -52,6 +55,9 @@
 #define CASE_OVERLAP_WIDTH 12		// Maximum width we can check for overlaps in
 #define CASE_BARF	   999999	// Magic width when non-constant
 #define CASE_ENCODER_GROUP_DEPTH 8	// Levels of priority to be ORed together in top IF tree
+#define CASE_SEARCH_MIN_VALUES 8	// Minimum constant values to use a search tree
+#define CASE_SEARCH_LEAF_RANGES 3	// Maximum ranges compared in turn at a search tree leaf
+#define CASE_SEARCH_DUP_NODES 1000	// Maximum body nodes a search tree may duplicate
 
 //######################################################################
 
@@ -132,12 +138,23 @@ private:
     // STATE
     V3Double0	m_statCaseFast;	// Statistic tracking
     V3Double0	m_statCaseSlow;	// Statistic tracking
+    V3Double0	m_statCaseSearch;	// Statistic tracking
+
+    // TYPES
+    typedef pair<vluint64_t,AstCaseItem*> SearchValue;
+    struct SearchRange {
+	vluint64_t	m_lo;		// Lowest value in range
+	vluint64_t	m_hi;		// Highest value in range
+	AstCaseItem*	m_itemp;	// Item selected by values in range
+    };
 
     // Per-CASE
     int		m_caseWidth;	// Width of valueItems
     int		m_caseItems;	// Number of caseItem unique values
     bool	m_caseNoOverlapsAllCovered;	// Proven to be synopsys parallel_case compliant
     AstNode*	m_valueItem[1<<CASE_OVERLAP_WIDTH];  // For each possible value, the case branch we need
+    vector<SearchRange> m_searchRanges;	// Sorted value ranges for search tree
+    AstCaseItem* m_searchDefaultp;	// Default item for search tree, or NULL
 
     // METHODS
     static int debug() {
@@ -300,6 +317,145 @@ private:
 	if (debug()>=9) ifrootp->dumpTree(cout,"    _simp: ");
     }
 
+    static bool searchValueLt(const SearchValue& a, const SearchValue& b) {
+	return a.first < b.first;
+    }
+    static int nodeCountRecurse(AstNode* nodep) {
+	// Number of nodes in the nodep list and below
+	int count = 0;
+	for (; nodep; nodep=nodep->nextp()) {
+	    count += 1 + nodeCountRecurse(nodep->op1p()) + nodeCountRecurse(nodep->op2p())
+		+ nodeCountRecurse(nodep->op3p()) + nodeCountRecurse(nodep->op4p());
+	}
+	return count;
+    }
+    static int bodyNodes(AstCaseItem* itemp) {
+	return itemp ? nodeCountRecurse(itemp->bodysp()) : 0;
+    }
+    int searchLeaves(int lo, int hi) const {
+	// Number of leaves replaceCaseSearchRecurse will make, each with a copy of the default
+	if (hi - lo < CASE_SEARCH_LEAF_RANGES) return 1;
+	int mid = (lo + hi + 1) / 2;
+	return searchLeaves(lo, mid-1) + searchLeaves(mid, hi);
+    }
+
+    bool isCaseSearch(AstCase* nodep) {
+	// Constant, unmasked values may be found with a search tree instead of
+	// comparing each in turn.  Values are sorted, and neighboring values for the
+	// same item are merged into ranges, which is what most decoders reduce to.
+	AstNode* cexprp = nodep->exprp();
+	int width = cexprp->width();
+	if (width == 0 || width > VL_QUADSIZE || cexprp->isDouble()) return false;
+	m_searchRanges.clear();
+	m_searchDefaultp = NULL;
+	vector<SearchValue> values;
+	for (AstCaseItem* itemp = nodep->itemsp(); itemp; itemp=itemp->nextp()->castCaseItem()) {
+	    if (!itemp->condsp()) {
+		// Defaults were moved to last in the caseitem list by V3LinkDot
+		if (!m_searchDefaultp) m_searchDefaultp = itemp;
+		continue;
+	    }
+	    for (AstNode* icondp = itemp->condsp(); icondp!=NULL; icondp=icondp->nextp()) {
+		AstConst* iconstp = icondp->castConst();
+		if (!iconstp || iconstp->isDouble() || iconstp->width() != width) return false;
+		if (neverItem(nodep, iconstp)) continue;  // X in casez can't ever be executed
+		if (iconstp->num().isFourState()) return false;  // Masked, needs AND compares
+		values.push_back(make_pair(iconstp->num().toUQuad(), itemp));
+	    }
+	}
+	if (values.size() < CASE_SEARCH_MIN_VALUES) return false;
+	// Stable, so the earliest item wins any duplicate value, matching case priority
+	stable_sort(values.begin(), values.end(), searchValueLt);
+	for (vector<SearchValue>::iterator it = values.begin(); it != values.end(); ++it) {
+	    if (!m_searchRanges.empty()) {
+		SearchRange& lastr = m_searchRanges.back();
+		if (it->first == lastr.m_hi) continue;  // Duplicate, lower priority
+		if (it->first == lastr.m_hi + 1 && it->second == lastr.m_itemp) {
+		    lastr.m_hi = it->first;
+		    continue;
+		}
+	    }
+	    SearchRange range;
+	    range.m_lo = range.m_hi = it->first;
+	    range.m_itemp = it->second;
+	    m_searchRanges.push_back(range);
+	}
+	// Items selected by several ranges, and the default, get a body copy per leaf.
+	// Don't trade a long compare chain for a huge amount of duplicated code.
+	int dupNodes = (searchLeaves(0, m_searchRanges.size()-1) - 1) * bodyNodes(m_searchDefaultp);
+	set<AstCaseItem*> seenItems;
+	for (vector<SearchRange>::iterator it = m_searchRanges.begin(); it != m_searchRanges.end(); ++it) {
+	    if (seenItems.find(it->m_itemp) != seenItems.end()) {
+		dupNodes += bodyNodes(it->m_itemp);
+	    } else {
+		seenItems.insert(it->m_itemp);
+	    }
+	}
+	UINFO(8,"Search case statement: "<<nodep<<" ranges="<<m_searchRanges.size()
+	      <<" dupNodes="<<dupNodes<<endl);
+	return dupNodes <= CASE_SEARCH_DUP_NODES;
+    }
+
+    AstNode* searchConst(AstNode* cexprp, vluint64_t value) {
+	V3Number num (cexprp->fileline(), cexprp->width());
+	num.setQuad(value);
+	return new AstConst(cexprp->fileline(), num);
+    }
+
+    AstNode* replaceCaseSearchRecurse(AstNode* cexprp, int lo, int hi, bool loKnown) {
+	// loKnown indicates a parent compare already proved cexpr >= m_searchRanges[lo].m_lo
+	FileLine* fl = cexprp->fileline();
+	if (hi - lo < CASE_SEARCH_LEAF_RANGES) {
+	    // Few enough ranges left to compare each in turn, falling to the default
+	    AstNode* treep = NULL;
+	    if (m_searchDefaultp && m_searchDefaultp->bodysp()) {
+		treep = m_searchDefaultp->bodysp()->cloneTree(true);
+	    }
+	    for (int i=hi; i>=lo; --i) {
+		const SearchRange& range = m_searchRanges[i];
+		AstNode* condp;
+		if (range.m_lo == range.m_hi) {
+		    condp = new AstEq(fl, cexprp->cloneTree(false), searchConst(cexprp, range.m_lo));
+		} else if (i==lo && loKnown) {
+		    condp = new AstLte(fl, cexprp->cloneTree(false), searchConst(cexprp, range.m_hi));
+		} else {
+		    condp = new AstAnd(fl,
+				       new AstGte(fl, cexprp->cloneTree(false),
+						  searchConst(cexprp, range.m_lo)),
+				       new AstLte(fl, cexprp->cloneTree(false),
+						  searchConst(cexprp, range.m_hi)));
+		}
+		AstNode* bodysp = range.m_itemp->bodysp();
+		if (bodysp) bodysp = bodysp->cloneTree(true);
+		treep = new AstIf(fl, condp, bodysp, treep);
+	    }
+	    return treep;
+	}
+	// Split at the middle range; the right half starts at a known bound
+	int mid = (lo + hi + 1) / 2;
+	AstNode* condp = new AstLt(fl, cexprp->cloneTree(false),
+				   searchConst(cexprp, m_searchRanges[mid].m_lo));
+	return new AstIf(fl, condp,
+			 replaceCaseSearchRecurse(cexprp, lo, mid-1, loKnown),
+			 replaceCaseSearchRecurse(cexprp, mid, hi, true));
+    }
+
+    void replaceCaseSearch(AstCase* nodep) {
+	// CASEx(cexpr,ITEM(icond1,istmts1),ITEM(icond2,istmts2),...)
+	// ->  IF(cexpr < icondMid, IF(cexpr < icondLow, ...),
+	//			    IF(cexpr < icondHigh, ...))
+	AstNode* cexprp = nodep->exprp()->unlinkFrBack();
+	// Handle any assertions
+	replaceCaseParallel(nodep, false);
+	AstNode* ifrootp = replaceCaseSearchRecurse(cexprp, 0, m_searchRanges.size()-1, false);
+	if (debug()>=9 && ifrootp) ifrootp->dumpTree(cout,"    _search: ");
+	if (ifrootp) nodep->replaceWith(ifrootp);
+	else nodep->unlinkFrBack();
+	nodep->deleteTree(); VL_DANGLING(nodep);
+	cexprp->deleteTree(); VL_DANGLING(cexprp);
+	m_searchRanges.clear();
+    }
+
     void replaceCaseComplicated(AstCase* nodep) {
 	// CASEx(cexpr,ITEM(icond1,istmts1),ITEM(icond2,istmts2),ITEM(default,istmts3))
 	// ->  IF((cexpr==icond1),istmts1,
@@ -460,6 +616,10 @@ private:
 	    // we can make a tree of statements to avoid extra comparisons
 	    ++m_statCaseFast;
 	    replaceCaseFast(nodep); VL_DANGLING(nodep);
+	} else if (v3Global.opt.oCase() && isCaseSearch(nodep)) {
+	    // Constant values without masks; binary search them
+	    ++m_statCaseSearch;
+	    replaceCaseSearch(nodep); VL_DANGLING(nodep);
 	} else {
 	    ++m_statCaseSlow;
 	    replaceCaseComplicated(nodep); VL_DANGLING(nodep);
@@ -475,11 +635,13 @@ public:
     // CONSTUCTORS
     explicit CaseVisitor(AstNetlist* nodep) {
 	m_caseNoOverlapsAllCovered = false;
+	m_searchDefaultp = NULL;
 	nodep->accept(*this);
     }
     virtual ~CaseVisitor() {
 	V3Stats::addStat("Optimizations, Cases parallelized", m_statCaseFast);
 	V3Stats::addStat("Optimizations, Cases complex", m_statCaseSlow);
+	V3Stats::addStat("Optimizations, Cases binary searched", m_statCaseSearch);
     }
 };
 
@@ -29,6 +29,9 @@
 // 	    !splitable: Mark all VARREFs in this statement as comming from it
 //	Optimize graph so if signal is referenced under multiple IF branches it moves up
 //	Make ALWAYS for each new gating term, and move statements there
+//	    Only banks of BANK_FLOPS_MIN or more flops move; the SenGate
+//	    then tests the enable once per bank, so the same IF on each
+//	    moved statement is replaced with a constant
 //*************************************************************************
 
 #include "config_build.h"
@@ -346,13 +349,15 @@ class GaterVisitor : public GaterBaseVisitor {
 
     enum MiscConsts {
 	IF_DEPTH_MAX = 4,	// IFs deep we bother to analyze
-	DOMAINS_MAX = 32	// Clock domains before avoiding O(N^2) blowup
+	DOMAINS_MAX = 32,	// Clock domains before avoiding O(N^2) blowup
+	BANK_FLOPS_MIN = 2	// Flops sharing a gater before it gets its own always
     };
 
     // MEMBERS
     string	m_nonopt;		// Reason block is not optimizable
     V3Double0	m_statGaters;		// Statistic tracking
     V3Double0	m_statBits;		// Statistic tracking
+    V3Double0	m_statFlops;		// Statistic tracking
     bool	m_directlyUnderAlw;	// Immediately under Always or If
     int		m_ifDepth;		// Depth of IF statements
     int		m_numIfs;		// Number of IF statements
@@ -631,11 +636,20 @@ class GaterVisitor : public GaterBaseVisitor {
     }
 
     void newAlwaysTrees(AstAlways* nodep) {
+	// Count flops under each gater; a lone flop gains nothing from
+	// its own always, so it stays under the IF in the original block
+	map<uint32_t,int> colorFlops;
+	for (V3GraphVertex* vertexp = m_graph.verticesBeginp(); vertexp; vertexp=vertexp->verticesNextp()) {
+	    if (GaterVarVertex* vVxp = dynamic_cast<GaterVarVertex*>(vertexp)) {
+		++colorFlops[vVxp->color()];
+	    }
+	}
 	// Across all variables we're moving
 	uint32_t lastColor = 0;
 	AstNode* lastExprp = NULL;
 	for (V3GraphVertex* vertexp = m_graph.verticesBeginp(); vertexp; vertexp=vertexp->verticesNextp()) {
 	    if (GaterVarVertex* vVxp = dynamic_cast<GaterVarVertex*>(vertexp)) {
+		if (colorFlops[vVxp->color()] < BANK_FLOPS_MIN) continue;
 		if (!lastExprp || lastColor != vVxp->color()) {
 		    lastColor = vVxp->color();
 		    // Create the block we've just finished
@@ -647,6 +661,7 @@ class GaterVisitor : public GaterBaseVisitor {
 		if (vVxp->nodep()->user2p()) vVxp->nodep()->v3fatalSrc("One variable got marked under two gaters");
 		vVxp->nodep()->user2p(lastExprp);
 		m_statBits += vVxp->nodep()->width();  // Moving a wide bus counts more!
+		++m_statFlops;
 		// There shouldn't be two possibilities we want to
 		// move to, IE {A,B} <= Z because we marked such
 		// things as unoptimizable
@@ -696,11 +711,48 @@ class GaterVisitor : public GaterBaseVisitor {
 	GaterBodyVisitor(nodep,exprp,true);
 	// Blow old statements from new body
 	GaterBodyVisitor(alwp,exprp,false);
+	// The SenGate tests the enable once for the whole bank
+	vector<AstNode*> termps;
+	gaterTerms(exprp, termps);
+	simplifyEnables(alwp->bodysp(), termps);
 
 	++m_statGaters;
 	if (debug()>=9) alwp->dumpTree(cout,"  new: ");
     }
 
+    void gaterTerms(AstNode* exprp, vector<AstNode*>& termps) {
+	// Each AND term of the gater is true whenever the new always runs
+	if (AstAnd* andp = exprp->castAnd()) {
+	    gaterTerms(andp->lhsp(), termps);
+	    gaterTerms(andp->rhsp(), termps);
+	} else {
+	    termps.push_back(exprp);
+	}
+    }
+    void simplifyEnables(AstNode* stmtsp, const vector<AstNode*>& termps) {
+	// Replace IF conditions implied by the gater; V3Const removes the IFs.
+	// Only delayed assignments remain, so the terms can't change in the body.
+	for (AstNode* stmtp = stmtsp; stmtp; stmtp=stmtp->nextp()) {
+	    AstNodeIf* ifp = stmtp->castNodeIf();
+	    if (!ifp) continue;
+	    AstNode* condp = ifp->condp();
+	    for (vector<AstNode*>::const_iterator it = termps.begin(); it != termps.end(); ++it) {
+		AstNot* notp = (*it)->castNot();
+		if (condp->sameTree(*it)) {
+		    condp->replaceWith(new AstConst(condp->fileline(), AstConst::LogicTrue()));
+		} else if (notp && condp->sameTree(notp->lhsp())) {
+		    condp->replaceWith(new AstConst(condp->fileline(), AstConst::LogicFalse()));
+		} else {
+		    continue;
+		}
+		condp->deleteTree(); VL_DANGLING(condp);
+		break;
+	    }
+	    simplifyEnables(ifp->ifsp(), termps);
+	    simplifyEnables(ifp->elsesp(), termps);
+	}
+    }
+
     // VISITORS
     virtual void visit(AstAlways* nodep) {
 	if (debug()>=9) cout<<endl<<endl<<endl;
@@ -904,6 +956,7 @@ public:
     virtual ~GaterVisitor() {
 	V3Stats::addStat("Optimizations, Gaters inserted", m_statGaters);
 	V3Stats::addStat("Optimizations, Gaters impacted bits", m_statBits);
+	V3Stats::addStat("Optimizations, Gaters flops gated", m_statFlops);
     }
 };
 
@@ -912,8 +965,7 @@ public:
 
 void V3ClkGater::clkGaterAll(AstNetlist* nodep) {
     UINFO(2,__FUNCTION__<<": "<<endl);
-    // While the gater does well at some modules, it seems to slow down many others
-    UINFO(5,"ClkGater is disabled due to performance issues\n");
-    //GaterVisitor visitor (nodep);
+    // Gating single flops slowed down many modules, so only banks are gated
+    GaterVisitor visitor (nodep);
     V3Global::dumpCheckGlobalTree("clkgater", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
 }
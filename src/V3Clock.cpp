@@ -29,6 +29,11 @@
 //		Replace UNTILSTABLEs with loops until specified signals become const.
 //   Create global calling function for any per-scope functions.  (For FINALs).
 //
+// With --domain-gate, for each combo call at the top of _eval:
+//	If it is pure, reads few scalars, and is the only writer of its outputs
+//	    Wrap in IF(first eval || any read differs from its __Vgate copy)
+//	    Copy the reads to the __Vgate copies under the IF
+//
 //*************************************************************************
 
 #include "config_build.h"
@@ -37,11 +42,74 @@
 #include <cstdarg>
 #include <unistd.h>
 #include <algorithm>
+#include <map>
+#include <set>
 
 #include "V3Global.h"
 #include "V3Clock.h"
 #include "V3Ast.h"
 #include "V3EmitCBase.h"
+#include "V3Stats.h"
+
+//######################################################################
+
+#define GATE_MAX_READS		32	// Max reads compared to gate a combo call
+#define GATE_MIN_NODES_PER_READ	4	// Min combo size per read to be worth comparing
+
+//######################################################################
+// Reads and writes of a statement, through the functions it calls
+
+class ClockGateUsesVisitor : public AstNVisitor {
+public:
+    // TYPES
+    typedef set<AstVarScope*> VarScopeSet;
+private:
+    // STATE
+    VarScopeSet		m_reads;	// Variables read
+    VarScopeSet		m_writes;	// Variables written
+    set<AstCFunc*>	m_funcps;	// Functions already walked
+    bool		m_impure;	// Has side effects or unpredictable reads
+    int			m_nodes;	// Number of nodes, as cost estimate
+
+    // VISITORS
+    virtual void visit(AstVarRef* nodep) {
+	++m_nodes;
+	AstVarScope* vscp = nodep->varScopep();
+	if (!vscp) { m_impure = true; return; }
+	if (nodep->varp()->isFuncLocal()) return;
+	if (nodep->lvalue()) m_writes.insert(vscp);
+	else m_reads.insert(vscp);
+    }
+    virtual void visit(AstCCall* nodep) {
+	++m_nodes;
+	AstCFunc* funcp = nodep->funcp();
+	if (funcp->dpiImport() || funcp->funcPublic()) m_impure = true;
+	else if (m_funcps.insert(funcp).second) funcp->iterateChildren(*this);
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstNode* nodep) {
+	++m_nodes;
+	if (!nodep->isPure() || !nodep->isPredictOptimizable() || nodep->isOutputter()
+	    || nodep->castCStmt() || nodep->castUCStmt() || nodep->castCMath()
+	    || nodep->castUCFunc() || nodep->castCoverInc()) {
+	    m_impure = true;
+	}
+	nodep->iterateChildren(*this);
+    }
+public:
+    // CONSTRUCTORS
+    explicit ClockGateUsesVisitor(AstNode* nodep) {
+	m_impure = false;
+	m_nodes = 0;
+	nodep->accept(*this);
+    }
+    virtual ~ClockGateUsesVisitor() {}
+    // ACCESSORS
+    const VarScopeSet& reads() const { return m_reads; }
+    const VarScopeSet& writes() const { return m_writes; }
+    bool impure() const { return m_impure; }
+    int nodes() const { return m_nodes; }
+};
 
 //######################################################################
 // Clock state, as a visitor of each AstNode
@@ -71,6 +139,7 @@ private:
     AstSenTree*		m_lastSenp;	// Last sensitivity match, so we can detect duplicates.
     AstIf*		m_lastIfp;	// Last sensitivity if active to add more under
     int			m_stableNum;	// Number of each untilstable
+    V3Double0		m_statGated;	// Statistic tracking
 
     // METHODS
     static int debug() {
@@ -186,6 +255,91 @@ private:
 	m_lastSenp = NULL;
 	m_lastIfp = NULL;
     }
+    bool gateOk(AstCCall* callp, const ClockGateUsesVisitor& uses,
+		const map<AstVarScope*,int>& writers) {
+	if (uses.impure()) return false;
+	int reads = 0;
+	for (ClockGateUsesVisitor::VarScopeSet::const_iterator it = uses.reads().begin();
+	     it != uses.reads().end(); ++it) {
+	    AstVar* varp = (*it)->varp();
+	    if (uses.writes().count(*it) && varp->isTemp()) continue;  // Written before read
+	    if (varp->isDouble() || varp->isString()
+		|| varp->dtypeSkipRefp()->castUnpackArrayDType()
+		|| (varp->basicp() && varp->basicp()->isOpaque())) {
+		return false;
+	    }
+	    ++reads;
+	}
+	if (reads > GATE_MAX_READS) return false;
+	if (uses.nodes() < reads * GATE_MIN_NODES_PER_READ) return false;
+	// Another writer could change an output while this call is skipped
+	for (ClockGateUsesVisitor::VarScopeSet::const_iterator it = uses.writes().begin();
+	     it != uses.writes().end(); ++it) {
+	    if (writers.find(*it)->second > 1) return false;
+	}
+	return true;
+    }
+    void gateCombo() {
+	// Skip each combo call whose reads are unchanged since it last ran
+	map<AstVarScope*,int> writers;
+	vector<ClockGateUsesVisitor*> usesps;
+	for (AstNode* stmtp = m_evalFuncp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+	    ClockGateUsesVisitor* usesp = new ClockGateUsesVisitor(stmtp);
+	    usesps.push_back(usesp);
+	    for (ClockGateUsesVisitor::VarScopeSet::const_iterator it = usesp->writes().begin();
+		 it != usesp->writes().end(); ++it) {
+		writers[*it]++;
+	    }
+	}
+	AstVarScope* validVscp = NULL;
+	int gateNum = 0;
+	vector<ClockGateUsesVisitor*>::iterator usesIt = usesps.begin();
+	AstNode* nextp;
+	for (AstNode* stmtp = m_evalFuncp->stmtsp(); stmtp; stmtp = nextp, ++usesIt) {
+	    nextp = stmtp->nextp();
+	    AstCCall* callp = stmtp->castCCall();
+	    if (!callp || !gateOk(callp, **usesIt, writers)) continue;
+	    FileLine* fl = callp->fileline();
+	    if (!validVscp) {
+		// Cleared at initialization, so the first evaluation runs every call
+		AstVar* newvarp = new AstVar(fl, AstVarType::MODULETEMP, "__Vgate__valid",
+					     VFlagLogicPacked(), 1);
+		m_modp->addStmtp(newvarp);
+		validVscp = new AstVarScope(fl, m_scopep, newvarp);
+		m_scopep->addVarp(validVscp);
+		m_initFuncp->addStmtsp(new AstAssign(fl, new AstVarRef(fl, validVscp, true),
+						     new AstConst(fl, AstConst::LogicFalse())));
+		m_evalFuncp->addFinalsp(new AstAssign(fl, new AstVarRef(fl, validVscp, true),
+						      new AstConst(fl, AstConst::LogicTrue())));
+	    }
+	    AstNode* condp = new AstNot(fl, new AstVarRef(fl, validVscp, false));
+	    AstNode* copysp = NULL;
+	    const ClockGateUsesVisitor& uses = **usesIt;
+	    for (ClockGateUsesVisitor::VarScopeSet::const_iterator it = uses.reads().begin();
+		 it != uses.reads().end(); ++it) {
+		AstVarScope* vscp = *it;
+		if (uses.writes().count(vscp) && vscp->varp()->isTemp()) continue;
+		string newvarname = ("__Vgate"+cvtToStr(gateNum)+"__"
+				     +vscp->scopep()->nameDotless()+"__"+vscp->varp()->name());
+		AstVar* newvarp = new AstVar(fl, AstVarType::MODULETEMP, newvarname, vscp->varp());
+		m_modp->addStmtp(newvarp);
+		AstVarScope* newvscp = new AstVarScope(fl, m_scopep, newvarp);
+		m_scopep->addVarp(newvscp);
+		condp = new AstOr(fl, condp,
+				  new AstNeq(fl, new AstVarRef(fl, vscp, false),
+					     new AstVarRef(fl, newvscp, false)));
+		AstNode* copyp = new AstAssign(fl, new AstVarRef(fl, newvscp, true),
+					       new AstVarRef(fl, vscp, false));
+		copysp = copysp ? copysp->addNext(copyp) : copyp;
+	    }
+	    AstIf* ifp = new AstIf(fl, condp, copysp, NULL);
+	    callp->replaceWith(ifp);
+	    ifp->addIfsp(callp);
+	    ++gateNum;
+	    ++m_statGated;
+	}
+	for (usesIt = usesps.begin(); usesIt != usesps.end(); ++usesIt) delete *usesIt;
+    }
 
     // VISITORS
     virtual void visit(AstTopScope* nodep) {
@@ -227,6 +381,8 @@ private:
 	    funcp->addInitsp(new AstCStmt(nodep->fileline(),
 					  EmitCBaseVisitor::symClassVar()+" = this->__VlSymsp;\n"));
 	    funcp->addInitsp(new AstCStmt(nodep->fileline(), EmitCBaseVisitor::symTopAssign()+"\n"));
+	    funcp->addInitsp(new AstCStmt(nodep->fileline(),
+					  "Verilated::threadContextp(vlSymsp->__Vm_contextp);\n"));
 	    m_scopep->addActivep(funcp);
 	    m_finalFuncp = funcp;
 	}
@@ -243,6 +399,7 @@ private:
 	}
 	// Process the activates
 	nodep->iterateChildren(*this);
+	if (v3Global.opt.domainGate()) gateCombo();
 	// Done, clear so we can detect errors
 	UINFO(4," TOPSCOPEDONE "<<nodep<<endl);
 	clearLastSen();
@@ -413,7 +570,9 @@ public:
 	//
 	nodep->accept(*this);
     }
-    virtual ~ClockVisitor() {}
+    virtual ~ClockVisitor() {
+	V3Stats::addStat("Optimizations, Domain gated combo calls", m_statGated);
+    }
 };
 
 //######################################################################
@@ -193,6 +193,7 @@ private:
     // STATE
     typedef enum {STATE_IDLE, STATE_HASH, STATE_DUP} CombineState;
     V3Double0		m_statCombs;	// Statistic tracking
+    bool		m_combinedNow;	// Combined functions since last hashing
     CombineState	m_state;	// Major state
     AstNodeModule*	m_modp;		// Current module
     AstCFunc*		m_funcp;	// Current function
@@ -259,6 +260,7 @@ private:
 	UINFO(5,"         and "<<hex<<V3Hash(oldfuncp->user4p())<<" "<<oldfuncp<<endl);
 	// Mark user3p on entire old tree, so we don't process it more
 	++m_statCombs;
+	m_combinedNow = true;
 	CombMarkVisitor visitor(oldfuncp);
 	m_call.replaceFunc(oldfuncp, newfuncp);
 	oldfuncp->unlinkFrBack();
@@ -402,6 +404,7 @@ private:
 	UINFO(4," MOD   "<<nodep<<endl);
 	m_modp = nodep;
 	m_modNFuncs = 0;
+	m_combinedNow = false;
 	m_hashed.clear();
 	// Compute hash of all statement trees in the function
 	m_state = STATE_HASH;
@@ -417,6 +420,16 @@ private:
 	// Walk the hashes looking for duplicate functions
 	if (duplicateFunctionCombine()) {
 	    walkDupFuncs();
+	    // Callers of functions just combined may now be duplicates too,
+	    // as with each instance's functions under --share-instances
+	    while (m_combinedNow) {
+		m_combinedNow = false;
+		m_hashed.clear();
+		m_state = STATE_HASH;
+		nodep->iterateChildren(*this);
+		m_state = STATE_IDLE;
+		walkDupFuncs();
+	    }
 	}
 	// Walk the statements looking for large replicated code sections
 	if (statementCombine()) {
@@ -461,6 +474,7 @@ public:
 	m_modp=NULL;
 	m_funcp = NULL;
 	m_state = STATE_IDLE;
+	m_combinedNow = false;
 	nodep->accept(*this);
     }
     virtual ~CombineVisitor() {
@@ -1172,6 +1172,18 @@ private:
     }
 
     void replaceWithSimulation(AstNode* nodep) {
+	{
+	    // Compiled form is much faster on loops; when it can't, the visitor
+	    // will also explain why
+	    SimulateProgram prog;
+	    if (prog.compileParam(nodep) && prog.run()) {
+		V3Number* outnump = prog.fetchNumberNull(nodep);
+		if (outnump) {
+		    replaceNum(nodep,*outnump); VL_DANGLING(nodep);
+		    return;
+		}
+	    }
+	}
 	SimulateVisitor simvis;
 	// Run it - may be unoptimizable due to large for loop, etc
 	simvis.mainParamEmulate(nodep);
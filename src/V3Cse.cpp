@@ -0,0 +1,366 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Common subexpression elimination
+//
+// Code available from: http://www.veripool.org/verilator
+//
+//*************************************************************************
+//
+// Copyright 2003-2017 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3Cse's Transformations:
+//
+// Each CFUNC, and each list of statements under it:
+//	Hash each pure expression every statement computes unconditionally,
+//	    that is assignment right hand sides and IF conditions, but not
+//	    the arms of ?: or the right side of && and ||.
+//	An expression stays available until a statement writes a variable
+//	    it reads, or makes a call that might write anything.
+//	For each expression computed twice or more while available,
+//	    largest expressions first:
+//	    ASSIGN(__Vcse#, expression) ahead of the first statement computing it
+//	    Replace each computation with VARREF(__Vcse#)
+//	V3Localize later makes the temporaries local to the function.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+#include <cstdio>
+#include <cstdarg>
+#include <unistd.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "V3Global.h"
+#include "V3Cse.h"
+#include "V3Hashed.h"
+#include "V3Stats.h"
+#include "V3Ast.h"
+
+//######################################################################
+
+#define CSE_MIN_OPS 3	// Min # of non-constant nodes for an expression to be worth a temp
+
+//######################################################################
+// Mark all nodes under specified one, so they are skipped when replacing
+
+class CseMarkVisitor : public AstNVisitor {
+private:
+    // OUTPUT:
+    //  AstNode::user1()	-> bool.  True to indicate replaced by temporary
+    // VISITORS
+    virtual void visit(AstNode* nodep) {
+	nodep->user1(true);
+	nodep->iterateChildren(*this);
+    }
+public:
+    // CONSTRUCTORS
+    explicit CseMarkVisitor(AstNode* nodep) {
+	nodep->accept(*this);
+    }
+    virtual ~CseMarkVisitor() {}
+};
+
+//######################################################################
+// Find what a statement writes
+
+class CseWriteVisitor : public AstNVisitor {
+private:
+    // STATE
+    vector<AstVarScope*>	m_writeVscps;	// Variables written
+    bool		m_writesAll;	// May write anything
+    // VISITORS
+    virtual void visit(AstNodeVarRef* nodep) {
+	if (nodep->lvalue()) {
+	    if (nodep->varScopep()) m_writeVscps.push_back(nodep->varScopep());
+	    else m_writesAll = true;
+	}
+    }
+    virtual void visit(AstCCall* nodep) { m_writesAll = true; }
+    virtual void visit(AstCStmt* nodep) { m_writesAll = true; }
+    virtual void visit(AstCMath* nodep) { m_writesAll = true; }
+    virtual void visit(AstUCStmt* nodep) { m_writesAll = true; }
+    virtual void visit(AstUCFunc* nodep) { m_writesAll = true; }
+    virtual void visit(AstJumpGo* nodep) { m_writesAll = true; }
+    virtual void visit(AstJumpLabel* nodep) { m_writesAll = true; }
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+public:
+    // CONSTRUCTORS
+    explicit CseWriteVisitor(AstNode* nodep) {
+	m_writesAll = false;
+	nodep->accept(*this);
+    }
+    virtual ~CseWriteVisitor() {}
+    const vector<AstVarScope*>& writeVscps() const { return m_writeVscps; }
+    bool writesAll() const { return m_writesAll; }
+};
+
+//######################################################################
+// Cse state, as a visitor of each AstNode
+
+class CseVisitor : public AstNVisitor {
+private:
+    // NODE STATE
+    // Entire netlist:
+    //  AstNode::user1()	-> bool.  True if replaced by temporary (CseMarkVisitor)
+    //  AstNode::user4()	-> V3Hash.  Hash of expression (V3Hashed)
+    AstUser1InUse	m_inuser1;
+
+    // TYPES
+    struct CseEntry {
+	AstNode*	m_exprp;	// Expression computed
+	AstNode*	m_stmtp;	// Statement in the block computing it
+	CseEntry(AstNode* exprp, AstNode* stmtp) : m_exprp(exprp), m_stmtp(stmtp) {}
+    };
+    struct CseGroup {
+	vector<CseEntry>	m_entries;	// Each computation of the expression, in order
+	int			m_ops;		// Size of the expression
+	bool			m_dead;		// An input was written, no longer available
+    };
+    struct CseGroupCmp {
+	bool operator() (const CseGroup* lhsp, const CseGroup* rhsp) const {
+	    return lhsp->m_ops > rhsp->m_ops;
+	}
+    };
+    typedef multimap<V3Hash,CseGroup*> ActiveMap;
+    typedef multimap<AstVarScope*,CseGroup*> ReaderMap;
+    typedef std::map<pair<AstNodeModule*,string>,AstVar*> VarMap;
+
+    // STATE
+    AstScope*		m_scopep;	// Current scope
+    int			m_scopeTemps;	// Temporaries made under this scope
+    V3Hashed		m_hashed;	// Hash of each expression
+    VarMap		m_modVarMap;	// Table of new var names created under module
+    ActiveMap*		m_activep;	// Available expressions in current block
+    ReaderMap*		m_readersp;	// Available expressions reading each variable
+    vector<CseGroup*>*	m_groupsp;	// All expressions in current block
+    V3Double0		m_statTemps;	// Statistic tracking
+    V3Double0		m_statReplaced;	// Statistic tracking
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+
+    bool exprCsable(AstNode* nodep, int& opsr, vector<AstVarScope*>& readVscpsr) {
+	// Can this expression be computed early and reused?  Count size and inputs
+	if (!nodep->castNodeMath()
+	    || nodep->castCMath() || nodep->castUCFunc()
+	    || !nodep->isPure() || !nodep->isGateOptimizable() || !nodep->isPredictOptimizable()) {
+	    return false;
+	}
+	if (AstNodeVarRef* varrefp = nodep->castNodeVarRef()) {
+	    if (varrefp->lvalue() || !varrefp->varScopep()) return false;
+	    readVscpsr.push_back(varrefp->varScopep());
+	}
+	if (!nodep->castConst()) ++opsr;
+	AstNode* opps[4] = { nodep->op1p(), nodep->op2p(), nodep->op3p(), nodep->op4p() };
+	for (int i=0; i<4; ++i) {
+	    for (AstNode* subp = opps[i]; subp; subp=subp->nextp()) {
+		if (!exprCsable(subp, opsr, readVscpsr)) return false;
+	    }
+	}
+	return true;
+    }
+    void addExpr(AstNode* nodep, AstNode* stmtp, int ops, const vector<AstVarScope*>& readVscps) {
+	m_hashed.hash(nodep);
+	V3Hash hash = V3Hashed::nodeHash(nodep);
+	pair<ActiveMap::iterator,ActiveMap::iterator> eqrange = m_activep->equal_range(hash);
+	for (ActiveMap::iterator it = eqrange.first; it != eqrange.second; ++it) {
+	    CseGroup* groupp = it->second;
+	    if (!groupp->m_dead && m_hashed.sameNodes(groupp->m_entries[0].m_exprp, nodep)) {
+		groupp->m_entries.push_back(CseEntry(nodep, stmtp));
+		return;
+	    }
+	}
+	CseGroup* groupp = new CseGroup;
+	groupp->m_entries.push_back(CseEntry(nodep, stmtp));
+	groupp->m_ops = ops;
+	groupp->m_dead = false;
+	m_groupsp->push_back(groupp);
+	m_activep->insert(make_pair(hash, groupp));
+	for (vector<AstVarScope*>::const_iterator it = readVscps.begin(); it != readVscps.end(); ++it) {
+	    m_readersp->insert(make_pair(*it, groupp));
+	}
+    }
+    void findExprs(AstNode* nodep, AstNode* stmtp) {
+	// Find expressions under nodep that are always computed
+	if (!nodep->castNodeMath() || nodep->castNodeVarRef() || nodep->castConst()) return;
+	int ops = 0;
+	vector<AstVarScope*> readVscps;
+	if (exprCsable(nodep, ops, readVscps)
+	    && (ops >= CSE_MIN_OPS || nodep->isWide())
+	    && !nodep->isString()
+	    && nodep->dtypep() && !nodep->dtypep()->skipRefp()->castUnpackArrayDType()) {
+	    addExpr(nodep, stmtp, ops, readVscps);
+	}
+	if (AstNodeCond* condp = nodep->castNodeCond()) {
+	    findExprs(condp->condp(), stmtp);  // Arms are only computed sometimes
+	} else if (nodep->castLogAnd() || nodep->castLogOr()) {
+	    findExprs(nodep->op1p(), stmtp);  // Right side is only computed sometimes
+	} else {
+	    if (nodep->op1p()) findExprs(nodep->op1p(), stmtp);
+	    if (nodep->op2p()) findExprs(nodep->op2p(), stmtp);
+	    if (nodep->op3p()) findExprs(nodep->op3p(), stmtp);
+	    if (nodep->op4p()) findExprs(nodep->op4p(), stmtp);
+	}
+    }
+    void killWrites(AstNode* stmtp) {
+	// Expressions reading what this statement writes are no longer available
+	CseWriteVisitor visitor (stmtp);
+	if (visitor.writesAll()) {
+	    for (ActiveMap::iterator it = m_activep->begin(); it != m_activep->end(); ++it) {
+		it->second->m_dead = true;
+	    }
+	    m_activep->clear();
+	    m_readersp->clear();
+	    return;
+	}
+	for (vector<AstVarScope*>::const_iterator vit = visitor.writeVscps().begin();
+	     vit != visitor.writeVscps().end(); ++vit) {
+	    pair<ReaderMap::iterator,ReaderMap::iterator> eqrange = m_readersp->equal_range(*vit);
+	    for (ReaderMap::iterator it = eqrange.first; it != eqrange.second; ++it) {
+		it->second->m_dead = true;
+	    }
+	    m_readersp->erase(eqrange.first, eqrange.second);
+	}
+    }
+    AstVarScope* createTemp(AstNode* exprp) {
+	// Temporaries are numbered within each scope, so each instance of a
+	// module creates the same names, and its functions may be combined
+	AstNodeModule* addmodp = m_scopep->modp();
+	AstVar* varp = NULL;
+	while (!varp) {
+	    string name = "__Vcse"+cvtToStr(++m_scopeTemps);
+	    VarMap::iterator it = m_modVarMap.find(make_pair(addmodp, name));
+	    if (it == m_modVarMap.end()) {
+		varp = new AstVar(exprp->fileline(), AstVarType::BLOCKTEMP, name, exprp->dtypep());
+		addmodp->addStmtp(varp);
+		m_modVarMap.insert(make_pair(make_pair(addmodp, name), varp));
+	    } else if (it->second->dtypep() == exprp->dtypep()) {
+		varp = it->second;  // Same temporary under another scope of this module
+	    }
+	}
+	AstVarScope* vscp = new AstVarScope(exprp->fileline(), m_scopep, varp);
+	m_scopep->addVarp(vscp);
+	return vscp;
+    }
+    void replaceGroups() {
+	stable_sort(m_groupsp->begin(), m_groupsp->end(), CseGroupCmp());
+	for (vector<CseGroup*>::iterator it = m_groupsp->begin(); it != m_groupsp->end(); ++it) {
+	    CseGroup* groupp = *it;
+	    vector<AstNode*> exprps;
+	    AstNode* firstStmtp = NULL;
+	    for (vector<CseEntry>::iterator eit = groupp->m_entries.begin();
+		 eit != groupp->m_entries.end(); ++eit) {
+		if (eit->m_exprp->user1()) continue;  // Inside an expression already replaced
+		if (!firstStmtp) firstStmtp = eit->m_stmtp;
+		exprps.push_back(eit->m_exprp);
+	    }
+	    if (exprps.size() < 2) continue;
+	    UINFO(5,"  CSE x"<<exprps.size()<<" "<<exprps[0]<<endl);
+	    ++m_statTemps;
+	    AstNode* firstp = exprps[0];
+	    FileLine* fl = firstp->fileline();
+	    AstVarScope* vscp = createTemp(firstp);
+	    firstStmtp->addHereThisAsNext(new AstAssign(fl, new AstVarRef(fl, vscp, true),
+							firstp->cloneTree(false)));
+	    for (vector<AstNode*>::iterator xit = exprps.begin(); xit != exprps.end(); ++xit) {
+		AstNode* exprp = *xit;
+		CseMarkVisitor visitor (exprp);
+		exprp->replaceWith(new AstVarRef(exprp->fileline(), vscp, false));
+		pushDeletep(exprp); VL_DANGLING(exprp);
+		++m_statReplaced;
+	    }
+	}
+    }
+    void cseBlock(AstNode* stmtsp) {
+	// Each statement list has its own available expressions
+	ActiveMap active;
+	ReaderMap readers;
+	vector<CseGroup*> groups;
+	ActiveMap* oldActivep = m_activep;
+	ReaderMap* oldReadersp = m_readersp;
+	vector<CseGroup*>* oldGroupsp = m_groupsp;
+	m_activep = &active;
+	m_readersp = &readers;
+	m_groupsp = &groups;
+	for (AstNode* stmtp = stmtsp; stmtp; stmtp = stmtp->nextp()) {
+	    if (AstNodeAssign* assignp = stmtp->castNodeAssign()) {
+		findExprs(assignp->rhsp(), stmtp);
+	    } else if (AstNodeIf* ifp = stmtp->castNodeIf()) {
+		findExprs(ifp->condp(), stmtp);
+	    }
+	    killWrites(stmtp);
+	    if (AstNodeIf* ifp = stmtp->castNodeIf()) {
+		cseBlock(ifp->ifsp());
+		cseBlock(ifp->elsesp());
+	    }
+	}
+	replaceGroups();
+	for (vector<CseGroup*>::iterator it = groups.begin(); it != groups.end(); ++it) {
+	    delete *it;
+	}
+	m_activep = oldActivep;
+	m_readersp = oldReadersp;
+	m_groupsp = oldGroupsp;
+    }
+
+    // VISITORS
+    virtual void visit(AstScope* nodep) {
+	m_scopep = nodep;
+	m_scopeTemps = 0;
+	nodep->iterateChildren(*this);
+	m_scopep = NULL;
+    }
+    virtual void visit(AstCFunc* nodep) {
+	if (m_scopep) {
+	    UINFO(4," CFUNC "<<nodep<<endl);
+	    cseBlock(nodep->stmtsp());
+	}
+    }
+    virtual void visit(AstVarScope*) {}
+    virtual void visit(AstNodeMath*) {}
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+
+public:
+    // CONSTUCTORS
+    explicit CseVisitor(AstNetlist* nodep) {
+	m_scopep = NULL;
+	m_scopeTemps = 0;
+	m_activep = NULL;
+	m_readersp = NULL;
+	m_groupsp = NULL;
+	nodep->accept(*this);
+    }
+    virtual ~CseVisitor() {
+	V3Stats::addStat("Optimizations, CSE temporaries", m_statTemps);
+	V3Stats::addStat("Optimizations, CSE expressions replaced", m_statReplaced);
+    }
+};
+
+//######################################################################
+// Cse class functions
+
+void V3Cse::cseAll(AstNetlist* nodep) {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    CseVisitor visitor (nodep);
+    V3Global::dumpCheckGlobalTree("cse", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
@@ -49,6 +49,24 @@
 //	...
 //	ASSIGNW (BITSEL(ARRAYSEL(VARREF(x), __Vdlyvdim_x), __Vdlyvlsb_x), __Vdlyvval_x)
 //
+// Single dimension memories written inside loops, or from many sites with
+// variable indexes, instead get a commit queue, so the number of temporaries
+// does not grow with the number of writes:
+// ASSIGNDLY (BITSEL(ARRAYSEL (VARREF(x), bits), selbits), rhs)
+// ->	VAR __Vdlyqval__x[]	Pending element values
+//	VAR __Vdlyqset__x[]	Element has a pending value
+//	VAR __Vdlyqidx__x[]	List of pending elements
+//	VAR __Vdlyqcnt__x	Entries in __Vdlyqidx__x
+//	ASSIGN (__Vdlyqpos__x, bits)
+//	IF (!__Vdlyqset__x[__Vdlyqpos__x])
+//	    ASSIGN (__Vdlyqset__x[__Vdlyqpos__x], 1)
+//	    ASSIGN (__Vdlyqidx__x[__Vdlyqcnt__x], __Vdlyqpos__x)
+//	    ASSIGN (__Vdlyqcnt__x, __Vdlyqcnt__x + 1)
+//	    ASSIGN (__Vdlyqval__x[__Vdlyqpos__x], x[__Vdlyqpos__x])	// Only if BITSEL
+//	ASSIGN (BITSEL(__Vdlyqval__x[__Vdlyqpos__x], selbits), rhs)
+//	...
+//	ALWAYSPOST: for each queued element, x[i] = __Vdlyqval__x[i], clear its set flag
+//
 //*************************************************************************
 
 #include "config_build.h"
@@ -59,12 +77,76 @@
 #include <algorithm>
 #include <map>
 #include <deque>
+#include <set>
 
 #include "V3Global.h"
 #include "V3Delayed.h"
 #include "V3Ast.h"
 #include "V3Stats.h"
 
+// Memories with at least this many delayed writes using a variable index
+// commit through a queue rather than a flag and temporaries per write.
+#define DELAYED_QUEUE_SITES	16
+
+//######################################################################
+// Count delayed array writes, to decide which memories get a commit queue
+
+class DelayedCountVisitor : public AstNVisitor {
+private:
+    // STATE
+    typedef std::map<AstVarScope*,int> SiteMap;
+    SiteMap		m_sites;	// Delayed variable index writes to each memory
+    std::set<AstVarScope*> m_loopVscps;	// Memories with delayed writes inside loops
+    bool		m_inLoop;	// True in for loops
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+
+    // VISITORS
+    virtual void visit(AstAssignDly* nodep) {
+	AstNode* lhsp = nodep->lhsp();
+	if (lhsp->castSel()) lhsp = lhsp->castSel()->fromp();
+	if (AstArraySel* arrayselp = lhsp->castArraySel()) {
+	    AstVarRef* varrefp = AstArraySel::baseFromp(arrayselp)->castVarRef();
+	    if (varrefp && varrefp->varScopep()) {
+		if (m_inLoop) m_loopVscps.insert(varrefp->varScopep());
+		if (!arrayselp->bitp()->castConst()) ++m_sites[varrefp->varScopep()];
+	    }
+	}
+    }
+    virtual void visit(AstWhile* nodep) {
+	bool oldloop = m_inLoop;
+	m_inLoop = true;
+	nodep->iterateChildren(*this);
+	m_inLoop = oldloop;
+    }
+    virtual void visit(AstNodeMath* nodep) {}  // Short circuit
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+
+public:
+    // CONSTUCTORS
+    explicit DelayedCountVisitor(AstNetlist* nodep) {
+	m_inLoop = false;
+	nodep->accept(*this);
+    }
+    virtual ~DelayedCountVisitor() {}
+    // METHODS
+    bool wantQueue(AstVarScope* vscp) const {
+	// Only single dimension memories; writes to others must be unrolled
+	AstUnpackArrayDType* adtypep = vscp->varp()->dtypeSkipRefp()->castUnpackArrayDType();
+	if (!adtypep || adtypep->subDTypep()->skipRefp()->castUnpackArrayDType()) return false;
+	if (m_loopVscps.find(vscp) != m_loopVscps.end()) return true;
+	SiteMap::const_iterator it = m_sites.find(vscp);
+	return (it != m_sites.end() && it->second >= DELAYED_QUEUE_SITES);
+    }
+};
+
 //######################################################################
 // Delayed state, as a visitor of each AstNode
 
@@ -102,7 +184,20 @@ private:
     bool                m_inClocked;     // True in clocked blocks
     typedef std::map<pair<AstNodeModule*,string>,AstVar*> VarMap;
     VarMap		m_modVarMap;	 // Table of new var names created under module
+    struct DlyQueue {
+	AstVarScope*	m_valVscp;	// Pending element values
+	AstVarScope*	m_setVscp;	// Element has a pending value
+	AstVarScope*	m_idxVscp;	// List of elements with pending values
+	AstVarScope*	m_cntVscp;	// Number of entries in m_idxVscp
+	AstVarScope*	m_posVscp;	// Element being written
+    };
+    typedef std::map<AstVarScope*,DlyQueue> QueueMap;
+    QueueMap		m_queues;	 // Commit queue for each queued memory
+    typedef std::map<pair<int,int>,AstNodeDType*> ArrayDTypeMap;
+    ArrayDTypeMap	m_arrayDTypes;	 // Queue array types, by elements and width
+    DelayedCountVisitor	m_counts;	 // Which memories to queue
     V3Double0		m_statSharedSet; // Statistic tracking
+    V3Double0		m_statQueues;	 // Statistic tracking
 
 
     // METHODS
@@ -119,7 +214,8 @@ private:
 	    nodep->v3warn(BLKANDNBLK,"Unsupported: Blocked and non-blocking assignments to same variable: "<<nodep->varp()->prettyName());
 	}
     }
-    AstVarScope* createVarSc(AstVarScope* oldvarscp, string name, int width/*0==fromoldvar*/, AstNodeDType* newdtypep) {
+    AstVarScope* createVarSc(AstVarScope* oldvarscp, string name, int width/*0==fromoldvar*/, AstNodeDType* newdtypep,
+			     AstVarType vartype=AstVarType::BLOCKTEMP) {
 	// Because we've already scoped it, we may need to add both the AstVar and the AstVarScope
 	if (!oldvarscp->scopep()) oldvarscp->v3fatalSrc("Var unscoped");
 	AstVar* varp;
@@ -131,12 +227,12 @@ private:
 	    varp = it->second;
 	} else {
 	    if (newdtypep) {
-		varp = new AstVar (oldvarscp->fileline(), AstVarType::BLOCKTEMP, name, newdtypep);
+		varp = new AstVar (oldvarscp->fileline(), vartype, name, newdtypep);
 	    } else if (width==0) {
-		varp = new AstVar (oldvarscp->fileline(), AstVarType::BLOCKTEMP, name, oldvarscp->varp());
+		varp = new AstVar (oldvarscp->fileline(), vartype, name, oldvarscp->varp());
 		varp->dtypeFrom(oldvarscp);
 	    } else { // Used for vset and dimensions, so can zero init
-		varp = new AstVar (oldvarscp->fileline(), AstVarType::BLOCKTEMP, name, VFlagBitPacked(), width);
+		varp = new AstVar (oldvarscp->fileline(), vartype, name, VFlagBitPacked(), width);
 	    }
 	    addmodp->addStmtp(varp);
 	    m_modVarMap.insert(make_pair(make_pair(addmodp, name), varp));
@@ -338,6 +434,158 @@ private:
 	return newlhsp;
     }
 
+    static int widthForValue(uint32_t value) {
+	int width = 1;
+	while (width < 32 && (value >> width)) ++width;
+	return width;
+    }
+    AstNode* newResize(AstNode* nodep, int width) {
+	// Index is known to be in bounds (V3Unknown added any IF needed), so may truncate
+	if (nodep->width() > width) return new AstSel(nodep->fileline(), nodep, 0, width);
+	if (nodep->width() < width) return new AstExtend(nodep->fileline(), nodep, width);
+	return nodep;
+    }
+    AstNodeDType* findArrayDType(AstNode* nodep, int elements, int width) {
+	pair<int,int> key = make_pair(elements, width);
+	ArrayDTypeMap::iterator it = m_arrayDTypes.find(key);
+	if (it != m_arrayDTypes.end()) return it->second;
+	AstNodeDType* dtypep
+	    = new AstUnpackArrayDType (nodep->fileline(),
+				       nodep->findBitDType(width, width, AstNumeric::UNSIGNED),
+				       new AstRange (nodep->fileline(), elements-1, 0));
+	v3Global.rootp()->typeTablep()->addTypesp(dtypep);
+	m_arrayDTypes.insert(make_pair(key, dtypep));
+	return dtypep;
+    }
+    AstNode* newFlush(FileLine* fl, AstVarScope* memvscp, const DlyQueue& queue,
+		      int idxWidth, int cntWidth) {
+	// Commit each queued element, then empty the queue:
+	//   for (k=0; k<cnt; ++k) { j=idx[k]; mem[j]=val[j]; set[j]=0; }  cnt=0;
+	AstVar* oldvarp = memvscp->varp();
+	AstVarScope* kvscp = createVarSc(memvscp, "__Vdlyqk__"+oldvarp->shortName(), cntWidth, NULL);
+	AstVarScope* jvscp = createVarSc(memvscp, "__Vdlyqj__"+oldvarp->shortName(), idxWidth, NULL);
+	AstNode* stmtsp
+	    = new AstAssign(fl, new AstVarRef(fl, kvscp, true),
+			    new AstConst(fl, V3Number(fl, cntWidth, 0)));
+	AstNode* bodysp
+	    = new AstAssign(fl, new AstVarRef(fl, jvscp, true),
+			    new AstArraySel(fl, new AstVarRef(fl, queue.m_idxVscp, false),
+					    new AstVarRef(fl, kvscp, false)));
+	bodysp->addNext(new AstAssign(fl, new AstArraySel(fl, new AstVarRef(fl, memvscp, true),
+							  new AstVarRef(fl, jvscp, false)),
+				      new AstArraySel(fl, new AstVarRef(fl, queue.m_valVscp, false),
+						      new AstVarRef(fl, jvscp, false))));
+	bodysp->addNext(new AstAssign(fl, new AstArraySel(fl, new AstVarRef(fl, queue.m_setVscp, true),
+							  new AstVarRef(fl, jvscp, false)),
+				      new AstConst(fl, V3Number(fl, 1, 0))));
+	AstNode* incp
+	    = new AstAssign(fl, new AstVarRef(fl, kvscp, true),
+			    new AstAdd(fl, new AstVarRef(fl, kvscp, false),
+				       new AstConst(fl, V3Number(fl, cntWidth, 1))));
+	stmtsp->addNext(new AstWhile(fl, new AstLt(fl, new AstVarRef(fl, kvscp, false),
+						   new AstVarRef(fl, queue.m_cntVscp, false)),
+				     bodysp, incp));
+	stmtsp->addNext(new AstAssign(fl, new AstVarRef(fl, queue.m_cntVscp, true),
+				      new AstConst(fl, V3Number(fl, cntWidth, 0))));
+	return stmtsp;
+    }
+
+    void createDlyQueue(AstAssignDly* nodep, AstNode* lhsp) {
+	// Create delayed assignment through the memory's commit queue
+	// See top of this file for transformation
+	AstSel*  bitselp = NULL;
+	AstArraySel*  arrayselp = NULL;
+	if (lhsp->castSel()) {
+	    bitselp = lhsp->castSel();
+	    arrayselp = bitselp->fromp()->castArraySel();
+	} else {
+	    arrayselp = lhsp->castArraySel();
+	}
+	if (!arrayselp) nodep->v3fatalSrc("No arraysel under bitsel?");
+	AstVarRef* varrefp = arrayselp->fromp()->castVarRef();
+	if (!varrefp) nodep->v3fatalSrc("Queued delayed assignment to multidimensional array");
+	AstVarScope* memvscp = varrefp->varScopep();
+	if (!memvscp) varrefp->v3fatalSrc("Var didn't get varscoped in V3Scope.cpp");
+	AstVar* oldvarp = varrefp->varp();
+	FileLine* fl = nodep->fileline();
+	UINFO(4,"AssignDlyQueue: "<<nodep<<endl);
+	//
+	int elements = oldvarp->dtypeSkipRefp()->castUnpackArrayDType()->elementsConst();
+	int idxWidth = widthForValue(elements-1);
+	int cntWidth = widthForValue(elements);
+	QueueMap::iterator it = m_queues.find(memvscp);
+	if (it == m_queues.end()) {
+	    // First write to this memory; create the queue
+	    // The set flags and count are bit typed so they zero initialize
+	    // even when Verilated::randReset(2) randomizes; each flush leaves them zero again
+	    DlyQueue queue;
+	    queue.m_valVscp = createVarSc(memvscp, "__Vdlyqval__"+oldvarp->shortName(),
+					  0, NULL, AstVarType::MODULETEMP);
+	    queue.m_setVscp = createVarSc(memvscp, "__Vdlyqset__"+oldvarp->shortName(),
+					  0, findArrayDType(nodep, elements, 1), AstVarType::MODULETEMP);
+	    queue.m_idxVscp = createVarSc(memvscp, "__Vdlyqidx__"+oldvarp->shortName(),
+					  0, findArrayDType(nodep, elements, idxWidth), AstVarType::MODULETEMP);
+	    queue.m_cntVscp = createVarSc(memvscp, "__Vdlyqcnt__"+oldvarp->shortName(),
+					  0, nodep->findBitDType(cntWidth, cntWidth, AstNumeric::UNSIGNED),
+					  AstVarType::MODULETEMP);
+	    queue.m_posVscp = createVarSc(memvscp, "__Vdlyqpos__"+oldvarp->shortName(),
+					  idxWidth, NULL);
+	    it = m_queues.insert(make_pair(memvscp, queue)).first;
+	    ++m_statQueues;
+	}
+	const DlyQueue& queue = it->second;
+	//
+	// Enqueue the element if this is its first write
+	AstNode* stmtsp
+	    = new AstAssign(fl, new AstVarRef(fl, queue.m_posVscp, true),
+			    newResize(arrayselp->bitp()->unlinkFrBack(), idxWidth));
+	AstNode* enqp
+	    = new AstAssign(fl, new AstArraySel(fl, new AstVarRef(fl, queue.m_setVscp, true),
+						new AstVarRef(fl, queue.m_posVscp, false)),
+			    new AstConst(fl, V3Number(fl, 1, 1)));
+	enqp->addNext(new AstAssign(fl, new AstArraySel(fl, new AstVarRef(fl, queue.m_idxVscp, true),
+							new AstVarRef(fl, queue.m_cntVscp, false)),
+				    new AstVarRef(fl, queue.m_posVscp, false)));
+	enqp->addNext(new AstAssign(fl, new AstVarRef(fl, queue.m_cntVscp, true),
+				    new AstAdd(fl, new AstVarRef(fl, queue.m_cntVscp, false),
+					       new AstConst(fl, V3Number(fl, cntWidth, 1)))));
+	if (bitselp) {
+	    // Other bits of the element keep their current value
+	    enqp->addNext(new AstAssign(fl, new AstArraySel(fl, new AstVarRef(fl, queue.m_valVscp, true),
+							    new AstVarRef(fl, queue.m_posVscp, false)),
+					new AstArraySel(fl, new AstVarRef(fl, memvscp, false),
+							new AstVarRef(fl, queue.m_posVscp, false))));
+	}
+	stmtsp->addNext(new AstIf(fl, new AstNot(fl, new AstArraySel(fl, new AstVarRef(fl, queue.m_setVscp, false),
+								     new AstVarRef(fl, queue.m_posVscp, false))),
+				  enqp, NULL));
+	//
+	// Write the pending value
+	AstNode* newlhsp = new AstArraySel(fl, new AstVarRef(fl, queue.m_valVscp, true),
+					   new AstVarRef(fl, queue.m_posVscp, false));
+	if (bitselp) {
+	    newlhsp = new AstSel(fl, newlhsp, bitselp->lsbp()->unlinkFrBack(),
+				 bitselp->widthp()->cloneTree(false));
+	}
+	stmtsp->addNext(new AstAssign(fl, newlhsp, nodep->rhsp()->unlinkFrBack()));
+	nodep->addNextHere(stmtsp);
+	//
+	// Create ALWAYSPOST to commit the queue, shared by all writes to the memory
+	AstAlwaysPost* finalp = memvscp->user4p()->castAlwaysPost();
+	if (finalp) {
+	    AstActive* oldactivep = finalp->user2p()->castActive();
+	    checkActivePost(varrefp, oldactivep);
+	} else { // first time we've dealt with this memory
+	    finalp = new AstAlwaysPost(fl, NULL/*sens*/, NULL/*body*/);
+	    UINFO(9,"     Created "<<finalp<<endl);
+	    AstActive* newactp = createActivePost(varrefp);
+	    newactp->addStmtsp(finalp);
+	    memvscp->user4p(finalp);
+	    finalp->user2p(newactp);
+	    finalp->addBodysp(newFlush(fl, memvscp, queue, idxWidth, cntWidth));
+	}
+    }
+
     // VISITORS
     virtual void visit(AstNetlist* nodep) {
 	//VV*****  We reset all userp() on the netlist
@@ -373,8 +621,16 @@ private:
 	    || (nodep->lhsp()->castSel()
 		&& nodep->lhsp()->castSel()->fromp()->castArraySel())) {
 	    AstNode* lhsp = nodep->lhsp()->unlinkFrBack();
-	    AstNode* newlhsp = createDlyArray(nodep, lhsp);
-	    if (m_inLoop) nodep->v3warn(E_BLKLOOPINIT,"Unsupported: Delayed assignment to array inside for loops (non-delayed is ok - see docs)");
+	    AstNode* basep = lhsp->castSel() ? lhsp->castSel()->fromp() : lhsp;
+	    AstVarRef* basevarrefp = AstArraySel::baseFromp(basep)->castVarRef();
+	    AstNode* newlhsp = NULL;
+	    if (basevarrefp && basevarrefp->varScopep()
+		&& m_counts.wantQueue(basevarrefp->varScopep())) {
+		createDlyQueue(nodep, lhsp);
+	    } else {
+		newlhsp = createDlyArray(nodep, lhsp);
+		if (m_inLoop) nodep->v3warn(E_BLKLOOPINIT,"Unsupported: Delayed assignment to multidimensional array inside for loops (non-delayed is ok - see docs)");
+	    }
 	    if (newlhsp) {
 		nodep->lhsp(newlhsp);
 	    } else {
@@ -464,7 +720,8 @@ private:
 
 public:
     // CONSTUCTORS
-    explicit DelayedVisitor(AstNetlist* nodep) {
+    explicit DelayedVisitor(AstNetlist* nodep)
+	: m_counts(nodep) {
 	m_inDly = false;
 	m_activep=NULL;
 	m_cfuncp=NULL;
@@ -477,6 +734,7 @@ public:
     }
     virtual ~DelayedVisitor() {
 	V3Stats::addStat("Optimizations, Delayed shared-sets", m_statSharedSet);
+	V3Stats::addStat("Optimizations, Delayed array queues", m_statQueues);
     }
 };
 
@@ -61,14 +61,17 @@ private:
 	// Create function
 	string name = m_funcp->name()+"__deep"+cvtToStr(++m_deepNum);
 	AstCFunc* funcp = new AstCFunc(nodep->fileline(), name, NULL);
-	funcp->argTypes(EmitCBaseVisitor::symClassVar());
+	// Under --share-instances the body may reference the instance passed as vlSelf
+	bool self = (m_funcp->argTypes().find("* vlSelf") != string::npos);
+	if (self) funcp->argTypes(m_funcp->argTypes());
+	else funcp->argTypes(EmitCBaseVisitor::symClassVar());
 	funcp->symProlog(true);
 	funcp->slow(m_funcp->slow());
 	funcp->addStmtsp(nodep);
 	m_modp->addStmtp(funcp);
 	// Call it at the point where the body was removed from
 	AstCCall* callp = new AstCCall(nodep->fileline(), funcp);
-	callp->argTypes("vlSymsp");
+	callp->argTypes(self ? "vlSymsp, vlSelf" : "vlSymsp");
 	UINFO(6,"      New "<<callp<<endl);
 	//
 	relinkHandle.relink(callp);
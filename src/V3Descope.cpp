@@ -23,6 +23,11 @@
 //		Change varref name() to be relative to current module
 //		Remove varScopep()
 //	    This allows for better V3Combine'ing.
+//	With --share-instances, each CFUNC of a non-top scope:
+//	    Takes a vlSelf pointer to the scope's instance
+//	    VARREFs to its own scope are made relative to vlSelf
+//	    CCALLs pass the scope's instance as vlSelf
+//	    So each instance's functions are identical, for V3Combine.
 //
 //*************************************************************************
 
@@ -45,7 +50,9 @@ private:
     // NODE STATE
     //  Cleared entire netlist
     //   AstCFunc::user()		// bool.  Indicates processing completed
+    //   AstCFunc::user2()		// int.  1 = passed vlSelf, 2 = not, 0 = not yet known
     AstUser1InUse	m_inuser1;
+    AstUser2InUse	m_inuser2;
 
     // TYPES
     typedef multimap<string,AstCFunc*>	FuncMmap;
@@ -54,6 +61,7 @@ private:
     AstNodeModule*	m_modp;		// Current module
     AstScope*		m_scopep;	// Current scope
     bool		m_needThis;	// Add thisp to function
+    bool		m_selfFunc;	// Current function is passed vlSelf
     FuncMmap		m_modFuncs;	// Name of public functions added
 
     // METHODS
@@ -63,11 +71,29 @@ private:
 	return level;
     }
 
+    bool selfFunc(AstCFunc* funcp) {
+	// Does this function get the instance of its scope passed as vlSelf?
+	// Must be decided before the argTypes are changed, so cache the answer
+	if (!funcp->user2()) {
+	    bool self = (v3Global.opt.shareInstances()
+			 && funcp->scopep() && funcp->scopep()->aboveScopep()  // Not top
+			 && funcp->funcType() == AstCFuncType::FT_NORMAL
+			 && !funcp->funcPublic() && !funcp->dpiImport() && !funcp->dpiExport()
+			 && funcp->argTypes() == EmitCBaseVisitor::symClassVar());
+	    funcp->user2(self ? 1 : 2);
+	}
+	return funcp->user2() == 1;
+    }
+
     string descopedName(AstScope* scopep, bool& hierThisr, AstVar* varp=NULL) {
 	UASSERT(scopep, "Var/Func not scoped\n");
 	hierThisr = true;
 	if (varp && varp->isFuncLocal()) {
 	    return "";  // Relative to function, not in this
+	} else if (scopep == m_scopep && m_selfFunc && varp) {
+	    // Reference to the instance we were passed
+	    hierThisr = false;
+	    return "vlSelf->";
 	} else if (scopep == m_scopep && m_modp->isTop()) {
 	    //return "";  // Reference to scope we're in, no need to HIER-> it
 	    return "vlTOPp->";
@@ -214,13 +240,27 @@ private:
 	bool hierThis;
 	if (!nodep->funcp()->isStatic())
 	    nodep->hiername(descopedName(nodep->funcp()->scopep(), hierThis/*ref*/));
+	if (selfFunc(nodep->funcp())) {
+	    AstScope* calleeScopep = nodep->funcp()->scopep();
+	    if (calleeScopep == m_scopep && m_selfFunc) {
+		nodep->argTypes(nodep->argTypes()+", vlSelf");
+	    } else {
+		nodep->argTypes(nodep->argTypes()+", &("+calleeScopep->nameVlSym()+")");
+	    }
+	}
 	// Can't do this, as we may have more calls later
 	// nodep->funcp()->scopep(NULL);
     }
     virtual void visit(AstCFunc* nodep) {
 	if (!nodep->user1()) {
 	    m_needThis = false;
+	    m_selfFunc = selfFunc(nodep);
+	    if (m_selfFunc) {
+		nodep->argTypes(nodep->argTypes()+", "+EmitCBaseVisitor::modClassName(m_scopep->modp())
+				+"* vlSelf");
+	    }
 	    nodep->iterateChildren(*this);
+	    m_selfFunc = false;
 	    nodep->user1(true);
 	    if (m_needThis) {
 		nodep->v3fatalSrc("old code");
@@ -253,6 +293,7 @@ public:
 	m_modp = NULL;
 	m_scopep = NULL;
 	m_needThis = false;
+	m_selfFunc = false;
 	nodep->accept(*this);
     }
     virtual ~DescopeVisitor() {}
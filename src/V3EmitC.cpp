@@ -23,16 +23,26 @@
 #include <cstdio>
 #include <cstdarg>
 #include <unistd.h>
+#include <cerrno>
 #include <cmath>
 #include <map>
+#include <set>
 #include <vector>
 #include <algorithm>
+#include <iomanip>
+
+#if defined(__unix__) || defined(__unix) || (defined(__APPLE__) && defined(__MACH__))
+# define EMITC_FORK  // Allow parallel emission.  Needs fork()
+# include <sys/wait.h>
+#endif
 
 #include "V3Global.h"
 #include "V3String.h"
 #include "V3EmitC.h"
 #include "V3EmitCBase.h"
 #include "V3Number.h"
+#include "V3Os.h"
+#include "V3Stats.h"
 
 #define VL_VALUE_STRING_MAX_WIDTH 8192	// We use a static char array in VL_VALUE_STRING
 
@@ -44,6 +54,7 @@
 class EmitCStmts : public EmitCBaseVisitor {
 private:
     bool	m_suppressSemi;
+    bool	m_inLane;		// Inside a --batch lane loop
     AstVarRef*	m_wideTempRefp;		// Variable that _WW macros should be setting
     vector<AstVar*>		m_ctorVarsVec;		// All variables in constructor order
     int		m_splitSize;	// # of cfunc nodes placed into output file
@@ -59,6 +70,7 @@ public:
 
     // ACCESSORS
     int	splitFilenum() const { return m_splitFilenum; }
+    void splitFilenum(int filenum) { m_splitSize = 0; m_splitFilenum = filenum; }
     int	splitFilenumInc() { m_splitSize = 0; return ++m_splitFilenum; }
     int splitSize() const { return m_splitSize; }
     void splitSizeInc(int count) { m_splitSize += count; }
@@ -75,7 +87,12 @@ public:
 
     void emitVarDecl(AstVar* nodep, const string& prefixIfImp);
     typedef enum {EVL_IO, EVL_SIG, EVL_TEMP, EVL_PAR, EVL_ALL} EisWhich;
-    void emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp);
+    typedef enum {EVH_ALL, EVH_HOT, EVH_COLD} EisHot;
+    static bool varIsHot(AstVar* varp) {
+	// See EmitCHotVisitor; memories are never grouped with the hot scalars
+	return varp->user1() && !varp->dtypeSkipRefp()->castUnpackArrayDType();
+    }
+    void emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp, EisHot hot=EVH_ALL);
     void emitVarCtors();
     bool emitSimpleOk(AstNodeMath* nodep);
     void emitIQW(AstNode* nodep) {
@@ -93,7 +110,24 @@ public:
     }
     void emitOpName(AstNode* nodep, const string& format,
 		    AstNode* lhsp, AstNode* rhsp, AstNode* thsp);
+    string emitOpTemplate(AstNode* nodep, const string& format,
+			  AstNode* lhsp, AstNode* rhsp, AstNode* thsp);
+    string emitAssignTemplate(AstNode* nodep) {
+	// VL_ASSIGN_W has a constant width specialization
+	int maxWords = v3Global.opt.wideTemplateWords();
+	if (!maxWords || nodep->widthWords() > maxWords) return "";
+	return "<"+cvtToStr(nodep->widthMin())+">";
+    }
+    static bool batchRef(AstNode* nodep) {
+	// True if nodep refers to a variable with one element per --batch lane
+	if (!nodep || !v3Global.opt.batch()) return false;
+	if (AstVarRef* refp = nodep->castVarRef()) return batchVar(refp->varp());
+	return (batchRef(nodep->op1p()) || batchRef(nodep->op2p())
+		|| batchRef(nodep->op3p()) || batchRef(nodep->op4p()));
+    }
     void emitDeclArrayBrackets(AstVar* nodep) {
+	// The --batch lane is the outermost dimension
+	if (batchVar(nodep)) puts("["+cvtToStr(v3Global.opt.batch())+"]");
 	// This isn't very robust and may need cleanup for other data types
 	for (AstUnpackArrayDType* arrayp=nodep->dtypeSkipRefp()->castUnpackArrayDType(); arrayp;
 	     arrayp = arrayp->subDTypep()->skipRefp()->castUnpackArrayDType()) {
@@ -135,6 +169,15 @@ public:
 
     // VISITORS
     virtual void visit(AstNodeAssign* nodep) {
+	if (!m_inLane && batchRef(nodep->lhsp())) {
+	    // Lanes are independent, so the compiler may vectorize each statement's loop
+	    m_inLane = true;
+	    puts(batchLoop());
+	    visit(nodep);
+	    puts("}\n");
+	    m_inLane = false;
+	    return;
+	}
 	bool paren = true;  bool decind = false;
 	if (AstSel* selp=nodep->lhsp()->castSel()) {
 	    if (selp->widthMin()==1) {
@@ -181,7 +224,7 @@ public:
 	    m_wideTempRefp = nodep->lhsp()->castVarRef();
 	    paren = false;
 	} else if (nodep->isWide()) {
-	    putbs("VL_ASSIGN_W(");
+	    putbs("VL_ASSIGN_W"+emitAssignTemplate(nodep)+"(");
 	    puts(cvtToStr(nodep->widthMin())+",");
 	    nodep->lhsp()->iterateAndNext(*this); puts(", ");
 	} else {
@@ -505,36 +548,6 @@ public:
 	    puts(")");
 	}
     }
-    virtual void visit(AstMulS* nodep) {
-	if (nodep->widthWords() > VL_MULS_MAX_WORDS) {
-	    nodep->v3error("Unsupported: Signed multiply of "<<nodep->width()<<" bits exceeds hardcoded limit VL_MULS_MAX_WORDS in verilatedos.h");
-	}
-	visit(nodep->castNodeBiop());
-    }
-    virtual void visit(AstPow* nodep) {
-	if (nodep->widthWords() > VL_MULS_MAX_WORDS) {
-	    nodep->v3error("Unsupported: Power of "<<nodep->width()<<" bits exceeds hardcoded limit VL_MULS_MAX_WORDS in verilatedos.h");
-	}
-	visit(nodep->castNodeBiop());
-    }
-    virtual void visit(AstPowSS* nodep) {
-	if (nodep->widthWords() > VL_MULS_MAX_WORDS) {
-	    nodep->v3error("Unsupported: Power of "<<nodep->width()<<" bits exceeds hardcoded limit VL_MULS_MAX_WORDS in verilatedos.h");
-	}
-	visit(nodep->castNodeBiop());
-    }
-    virtual void visit(AstPowSU* nodep) {
-	if (nodep->widthWords() > VL_MULS_MAX_WORDS) {
-	    nodep->v3error("Unsupported: Power of "<<nodep->width()<<" bits exceeds hardcoded limit VL_MULS_MAX_WORDS in verilatedos.h");
-	}
-	visit(nodep->castNodeBiop());
-    }
-    virtual void visit(AstPowUS* nodep) {
-	if (nodep->widthWords() > VL_MULS_MAX_WORDS) {
-	    nodep->v3error("Unsupported: Power of "<<nodep->width()<<" bits exceeds hardcoded limit VL_MULS_MAX_WORDS in verilatedos.h");
-	}
-	visit(nodep->castNodeBiop());
-    }
     virtual void visit(AstCCast* nodep) {
 	// Extending a value of the same word width is just a NOP.
 	if (nodep->size()>VL_WORDSIZE) {
@@ -604,6 +617,7 @@ public:
     virtual void visit(AstVarRef* nodep) {
 	puts(nodep->hiername());
 	puts(nodep->varp()->name());
+	puts(batchIndex(nodep->varp()));
     }
     void emitCvtPackStr(AstNode* nodep) {
 	if (AstConst* constp = nodep->castConst()) {
@@ -659,6 +673,7 @@ public:
 		} else if (assigntop->castVarRef()) {
 		    puts(assigntop->hiername());
 		    puts(assigntop->varp()->name());
+		    puts(batchIndex(assigntop->varp()));
 		} else {
 		    assigntop->iterateAndNext(*this);
 		}
@@ -680,6 +695,7 @@ public:
 		} else if (assigntop->castVarRef()) {
 		    puts(assigntop->hiername());
 		    puts(assigntop->varp()->name());
+		    puts(batchIndex(assigntop->varp()));
 		} else {
 		    assigntop->iterateAndNext(*this);
 		}
@@ -764,6 +780,7 @@ public:
 public:
     EmitCStmts() {
 	m_suppressSemi = false;
+	m_inLane = false;
 	m_wideTempRefp = NULL;
 	m_splitSize = 0;
 	m_splitFilenum = 0;
@@ -771,15 +788,77 @@ public:
     virtual ~EmitCStmts() {}
 };
 
+//######################################################################
+// Predicted compile cost of each output file, for --stats
+
+class EmitCCostReport {
+    // TYPES
+    typedef vector<pair<int,string> > CostVec;
+    struct CmpCost {
+	inline bool operator () (const pair<int,string>& lhs, const pair<int,string>& rhs) const {
+	    return lhs.first > rhs.first;
+	}
+    };
+    // STATE
+    static CostVec	s_files;	// Cost and filename of each file
+public:
+    static void addFile(const string& filename, int cost) {
+	s_files.push_back(make_pair(cost, filename));
+    }
+    static void report() {
+	if (s_files.empty()) return;
+	string filename = v3Global.opt.makeDir()+"/"+v3Global.opt.prefix()+"__stats_split.txt";
+	ofstream* ofp (V3File::new_ofstream(filename));
+	if (ofp->fail()) v3fatalSrc("Can't write "<<filename);
+	stable_sort(s_files.begin(), s_files.end(), CmpCost());
+	double total = 0;
+	for (CostVec::iterator it = s_files.begin(); it != s_files.end(); ++it) total += it->first;
+	double mean = total / s_files.size();
+	double max = s_files.front().first;
+	*ofp<<"Verilator Split Cost Report"<<endl<<endl;
+	*ofp<<"Predicted relative C++ compile cost of each output file."<<endl<<endl;
+	*ofp<<"  Files "<<s_files.size()<<", total cost "<<total
+	    <<", mean "<<fixed<<setprecision(0)<<mean<<", max "<<max
+	    <<" ("<<setprecision(2)<<(mean ? max/mean : 0)<<"x mean)"<<endl<<endl;
+	*ofp<<"     Cost  % Total  File"<<endl;
+	for (CostVec::iterator it = s_files.begin(); it != s_files.end(); ++it) {
+	    *ofp<<"  "<<setw(7)<<it->first
+		<<"  "<<setw(6)<<setprecision(2)<<(total ? 100.0*it->first/total : 0)
+		<<"  "<<V3Os::filenameNonDir(it->second)<<endl;
+	}
+	ofp->close(); delete ofp; VL_DANGLING(ofp);
+	V3Stats::addStat("EmitC, Split files", s_files.size());
+	V3Stats::addStat("EmitC, Split cost max", max);
+	V3Stats::addStat("EmitC, Split cost mean", mean);
+	s_files.clear();
+    }
+};
+
+EmitCCostReport::CostVec EmitCCostReport::s_files;
+
 //######################################################################
 // Internal EmitC implementation
 
 class EmitCImp : EmitCStmts {
+public:
+    // TYPES
+    typedef vector<AstCFunc*> FuncVec;
+    typedef vector<FuncVec> SplitPlan;	// Functions to emit into each split file
+private:
+    struct CmpCostDesc {
+	const vector<int>& m_costs;
+	explicit CmpCostDesc(const vector<int>& costs) : m_costs(costs) {}
+	inline bool operator () (int lhs, int rhs) const {
+	    return m_costs[lhs] > m_costs[rhs];
+	}
+    };
+
     // MEMBERS
     AstNodeModule*	m_modp;
     vector<AstChangeDet*>	m_blkChangeDetVec;	// All encountered changes in block
     bool	m_slow;		// Creating __Slow file
     bool	m_fast;		// Creating non __Slow file (or both)
+    bool	m_newCFiles;	// Record created files in the netlist (false in emit workers)
 
     //---------------------------------------
     // METHODS
@@ -819,25 +898,18 @@ class EmitCImp : EmitCStmts {
     }
 
     V3OutCFile* newOutCFile(AstNodeModule* modp, bool slow, bool source, int filenum=0) {
-	string filenameNoExt = v3Global.opt.makeDir()+"/"+ modClassName(modp);
-	if (filenum) filenameNoExt += "__"+cvtToStr(filenum);
-	filenameNoExt += (slow ? "__Slow":"");
+	string filename = outCFilename(modp, slow, source, filenum);
+	if (m_newCFiles) newCFile(filename, slow, source);
 	V3OutCFile* ofp = NULL;
 	if (v3Global.opt.lintOnly()) {
 	    // Unfortunately we have some lint checks here, so we can't just skip processing.
 	    // We should move them to a different stage.
-	    string filename = VL_DEV_NULL;
-	    newCFile(filename, slow, source);
 	    ofp = new V3OutCFile (filename);
 	}
 	else if (optSystemC()) {
-	    string filename = filenameNoExt+(source?".cpp":".h");
-	    newCFile(filename, slow, source);
 	    ofp = new V3OutScFile (filename);
 	}
 	else {
-	    string filename = filenameNoExt+(source?".cpp":".h");
-	    newCFile(filename, slow, source);
 	    ofp = new V3OutCFile  (filename);
 	}
 
@@ -861,21 +933,23 @@ class EmitCImp : EmitCStmts {
 	return ofp;
     }
 
+    bool funcEmitted(AstCFunc* nodep) const {
+	// TRACE_* and DPI handled elsewhere
+	if (nodep->funcType().isTrace()) return false;
+	if (nodep->dpiImport()) return false;
+	// Foreign AstCFuncs are internal only
+	if (nodep->funcType().isForeign()) return false;
+	return (nodep->slow() ? m_slow : m_fast);
+    }
+
     //---------------------------------------
     // VISITORS
     using EmitCStmts::visit;  // Suppress hidden overloaded virtual function warnng
     virtual void visit(AstCFunc* nodep) {
-	// TRACE_* and DPI handled elsewhere
-	if (nodep->funcType().isTrace()) return;
-	if (nodep->dpiImport()) return;
-	// Foreign AstCFuncs are internal only
-	if (nodep->funcType().isForeign()) return;
-	if (!(nodep->slow() ? m_slow : m_fast)) return;
+	if (!funcEmitted(nodep)) return;
 
 	m_blkChangeDetVec.clear();
 
-	splitSizeInc(nodep);
-
 	puts("\n");
 	if (nodep->isInline()) puts("VL_INLINE_OPT ");
 	puts(nodep->rtnTypeVoid()); puts(" ");
@@ -917,6 +991,7 @@ class EmitCImp : EmitCStmts {
     void emitChangeDet() {
 	putsDecoration("// Change detection\n");
 	puts("QData __req = false;  // Logically a bool\n");  // But not because it results in faster code
+	if (v3Global.opt.batch()) puts(batchLoop());
 	bool gotOne = false;
 	for (vector<AstChangeDet*>::iterator it = m_blkChangeDetVec.begin();
 	     it != m_blkChangeDetVec.end(); ++it) {
@@ -948,6 +1023,7 @@ class EmitCImp : EmitCStmts {
 		}
 	    }
 	}
+	if (v3Global.opt.batch()) puts("}\n");
 
 	for (AstNode* nodep=m_modp->stmtsp(); nodep; nodep = nodep->nextp()) {
 	    if (AstForeignInstance* fi = nodep->castForeignInstance()) {
@@ -968,7 +1044,9 @@ class EmitCImp : EmitCStmts {
 
     virtual void visit(AstCReset* nodep) {
 	AstVar* varp = nodep->varrefp()->varp();
+	if (batchVar(varp)) puts(batchLoop());
 	emitVarReset(varp);
+	if (batchVar(varp)) puts("}\n");
     }
 
     //---------------------------------------
@@ -1000,9 +1078,25 @@ public:
 	m_modp = NULL;
 	m_slow = false;
 	m_fast = false;
+	m_newCFiles = true;
     }
     virtual ~EmitCImp() {}
+    static string outCFilename(AstNodeModule* modp, bool slow, bool source, int filenum) {
+	if (v3Global.opt.lintOnly()) return VL_DEV_NULL;
+	string filenameNoExt = v3Global.opt.makeDir()+"/"+ modClassName(modp);
+	if (filenum) filenameNoExt += "__"+cvtToStr(filenum);
+	filenameNoExt += (slow ? "__Slow":"");
+	return filenameNoExt+(source?".cpp":".h");
+    }
+    void newCFiles(bool flag) { m_newCFiles = flag; }
     void main(AstNodeModule* modp, bool slow, bool fast);
+    void mainInit(AstNodeModule* modp, bool slow, bool fast) {
+	m_modp = modp;
+	m_slow = slow;
+	m_fast = fast;
+    }
+    void mainPlan(SplitPlan& plan, vector<int>& sizes);
+    void mainFile(int filenum, const FuncVec& funcs);
     void mainDoFunc(AstCFunc* nodep) {
 	nodep->accept(*this);
     }
@@ -1139,6 +1233,7 @@ void EmitCStmts::emitOpName(AstNode* nodep, const string& format,
     //	,	Commas suppressed if the previous field is suppressed
     string nextComma;
     bool needComma = false;
+    string templateArgs = emitOpTemplate(nodep, format, lhsp, rhsp, thsp);
 #define COMMA { if (nextComma!="") { puts(nextComma); nextComma=""; } }
 
     putbs("");
@@ -1169,6 +1264,7 @@ void EmitCStmts::emitOpName(AstNode* nodep, const string& format,
 		    COMMA;
 		    puts(m_wideTempRefp->hiername());
 		    puts(m_wideTempRefp->varp()->name());
+		    puts(batchIndex(m_wideTempRefp->varp()));
 		    m_wideTempRefp = NULL;
 		    needComma = true;
 		}
@@ -1208,7 +1304,9 @@ void EmitCStmts::emitOpName(AstNode* nodep, const string& format,
 	} else if (pos[0] == ')') {
 	    nextComma=""; puts(")");
 	} else if (pos[0] == '(') {
-	    COMMA; needComma = false; puts("(");
+	    COMMA; needComma = false;
+	    puts(templateArgs); templateArgs = "";
+	    puts("(");
 	} else {
 	    // Normal text
 	    if (isalnum(pos[0])) needComma = true;
@@ -1218,6 +1316,66 @@ void EmitCStmts::emitOpName(AstNode* nodep, const string& format,
     }
 }
 
+string EmitCStmts::emitOpTemplate(AstNode* nodep, const string& format,
+				  AstNode* lhsp, AstNode* rhsp, AstNode* thsp) {
+    // If emitOpName's function has a constant width specialization in
+    // verilated.h, return its template arguments, which repeat the leading
+    // width arguments of the call; else "".
+    int maxWords = v3Global.opt.wideTemplateWords();
+    if (!maxWords) return "";
+    static set<string> s_names;
+    if (s_names.empty()) {
+	const char* const names[] = {
+	    "VL_ASSIGN_W", "VL_EXTEND_WI", "VL_EXTEND_WQ", "VL_EXTEND_WW",
+	    "VL_REDOR_W", "VL_REDXOR_W", "VL_COUNTONES_W",
+	    "VL_AND_W", "VL_OR_W", "VL_XOR_W", "VL_XNOR_W", "VL_NOT_W", "VL_EQ_W",
+	    "VL_CONCAT_WII", "VL_CONCAT_WWI", "VL_CONCAT_WIW", "VL_CONCAT_WIQ", "VL_CONCAT_WQI",
+	    "VL_CONCAT_WQQ", "VL_CONCAT_WWQ", "VL_CONCAT_WQW", "VL_CONCAT_WWW",
+	    "VL_SHIFTL_WWI", "VL_SHIFTR_WWI", "VL_SEL_IWII", "VL_SEL_QWII", "VL_SEL_WWII",
+	    NULL };
+	for (int i=0; names[i]; ++i) s_names.insert(names[i]);
+    }
+    // Function name, with %[nlrt]q expanded as emitOpName does
+    string name;
+    string::size_type pos = 0;
+    for (; pos < format.size() && format[pos] != '('; ++pos) {
+	if (format[pos] == '%') {
+	    if (pos+2 >= format.size() || format[pos+2] != 'q') return "";
+	    AstNode* detailp = (format[pos+1]=='n' ? nodep : format[pos+1]=='l' ? lhsp
+				: format[pos+1]=='r' ? rhsp : format[pos+1]=='t' ? thsp : NULL);
+	    if (!detailp) return "";
+	    name += (detailp->isString() ? "N" : detailp->isWide() ? "W"
+		     : detailp->isQuad() ? "Q" : "I");
+	    pos += 2;
+	} else {
+	    name += format[pos];
+	}
+    }
+    if (s_names.find(name) == s_names.end()) return "";
+    // Leading %[nlrt]w and %lW arguments
+    string args;
+    for (++pos; pos+2 < format.size() && format[pos] == '%'; ) {
+	AstNode* detailp = (format[pos+1]=='n' ? nodep : format[pos+1]=='l' ? lhsp
+			    : format[pos+1]=='r' ? rhsp : format[pos+1]=='t' ? thsp : NULL);
+	int value;
+	int words;
+	if (format[pos+2] == 'w' && detailp) {
+	    value = detailp->widthMin();
+	    words = VL_WORDS_I(value);
+	} else if (format[pos+2] == 'W' && lhsp && lhsp->isWide()) {
+	    value = words = lhsp->widthWords();
+	} else {
+	    break;
+	}
+	if (words > maxWords) return "";
+	if (args != "") args += ",";
+	args += cvtToStr(value);
+	for (pos += 3; pos < format.size() && (format[pos]==',' || format[pos]==' '); ++pos) ;
+    }
+    if (args == "") return "";
+    return "<"+args+">";
+}
+
 //----------------------------------------------------------------------
 // Mid level - VISITS
 
@@ -1451,14 +1609,14 @@ void EmitCImp::emitVarReset(AstVar* varp) {
 		puts("{ int __Vi=0;");
 		puts(" for (; __Vi<"+cvtToStr(arrayp->elementsConst()));
 		puts("; ++__Vi) {\n");
-		emitSetVarConstant(varp->name()+"[__Vi]", initarp->defaultp()->castConst());
+		emitSetVarConstant(varp->name()+batchIndex(varp)+"[__Vi]", initarp->defaultp()->castConst());
 		puts("}}\n");
 	    }
 	    int pos = 0;
 	    for (AstNode* itemp = initarp->initsp(); itemp; ++pos, itemp=itemp->nextp()) {
 		int index = initarp->posIndex(pos);
 		if (!initarp->defaultp() && index!=pos) initarp->v3fatalSrc("Not enough values in array initalizement");
-		emitSetVarConstant(varp->name()+"["+cvtToStr(index)+"]", itemp->castConst());
+		emitSetVarConstant(varp->name()+batchIndex(varp)+"["+cvtToStr(index)+"]", itemp->castConst());
 	    }
 	} else {
 	    varp->v3fatalSrc("InitArray under non-arrayed var");
@@ -1490,11 +1648,11 @@ void EmitCImp::emitVarReset(AstVar* varp) {
 	    else puts("VL_RAND_RESET_W(");
 	    puts(cvtToStr(varp->widthMin()));
 	    puts(",");
-	    puts(varp->name());
+	    puts(varp->name()+batchIndex(varp));
 	    for (int v=0; v<vects; ++v) puts( "[__Vi"+cvtToStr(v)+"]");
 	    puts(");\n");
 	} else {
-	    puts(varp->name());
+	    puts(varp->name()+batchIndex(varp));
 	    for (int v=0; v<vects; ++v) puts( "[__Vi"+cvtToStr(v)+"]");
 	    // If --x-initial-edge is set, we want to force an initial
 	    // edge on uninitialized clocks (from 'X' to whatever the
@@ -1516,7 +1674,6 @@ void EmitCImp::emitVarReset(AstVar* varp) {
 	}
 	for (int v=0; v<vects; ++v) puts( "}}\n");
     }
-    splitSizeInc(1);
 }
 
 void EmitCImp::emitCoverageDecl(AstNodeModule* modp) {
@@ -1532,6 +1689,8 @@ void EmitCImp::emitCtorImp(AstNodeModule* modp) {
     puts("\n");
     if (optSystemC() && modp->isTop()) {
 	puts("VL_SC_CTOR_IMP("+modClassName(modp)+")");
+    } else if (modp->isTop()) {
+	puts("VL_CTOR_CONTEXT_IMP("+modClassName(modp)+")");
     } else {
 	puts("VL_CTOR_IMP("+modClassName(modp)+")");
     }
@@ -1559,7 +1718,6 @@ void EmitCImp::emitConfigureImp(AstNodeModule* modp) {
 	puts("this->_configure_coverage(vlSymsp, first);\n");
     }
     puts("}\n");
-    splitSizeInc(10);
 }
 
 void EmitCImp::emitCoverageImp(AstNodeModule* modp) {
@@ -1581,7 +1739,6 @@ void EmitCImp::emitCoverageImp(AstNodeModule* modp) {
 	puts(	"  \"page\",pagep,");
 	puts(	"  \"comment\",commentp);\n");
 	puts("}\n");
-	splitSizeInc(10);
     }
 }
 
@@ -1603,7 +1760,6 @@ void EmitCImp::emitDestructorImp(AstNodeModule* modp) {
     }
 
     puts("}\n");
-    splitSizeInc(10);
 }
 
 void EmitCImp::emitSavableImp(AstNodeModule* modp) {
@@ -1714,8 +1870,11 @@ void EmitCImp::emitTextSection(AstType type) {
 void EmitCImp::emitCellCtors(AstNodeModule* modp) {
     if (modp->isTop()) {
 	// Must be before other constructors, as __vlCoverInsert calls it
-	puts(EmitCBaseVisitor::symClassVar()+" = __VlSymsp = new "+symClassName()+"(this, name());\n");
+	puts(EmitCBaseVisitor::symClassVar()+" = __VlSymsp = new "+symClassName()+"(this, name(), "
+	     +(optSystemC() ? "NULL" : "__VCcontextp")+");\n");
 	puts(EmitCBaseVisitor::symTopAssign()+"\n");
+	// So random resets come from this model's context
+	puts("Verilated::threadContextp(vlSymsp->__Vm_contextp);\n");
     }
     for (AstNode* nodep=modp->stmtsp(); nodep; nodep = nodep->nextp()) {
 	if (AstCell* cellp=nodep->castCell()) {
@@ -1773,6 +1932,7 @@ void EmitCImp::emitWrapEval(AstNodeModule* modp) {
     puts("\nvoid "+modClassName(modp)+"::eval() {\n");
     puts(EmitCBaseVisitor::symClassVar()+" = this->__VlSymsp; // Setup global symbol table\n");
     puts(EmitCBaseVisitor::symTopAssign()+"\n");
+    puts("Verilated::threadContextp(vlSymsp->__Vm_contextp); // Setup this thread's runtime context\n");
     putsDecoration("// Initialize\n");
     puts("if (VL_UNLIKELY(!vlSymsp->__Vm_didInit)) _eval_initial_loop(vlSymsp);\n");
     if (v3Global.opt.inhibitSim()) {
@@ -1791,7 +1951,6 @@ void EmitCImp::emitWrapEval(AstNodeModule* modp) {
 	     +") vl_fatal(__FILE__,__LINE__,__FILE__,\"Verilated model didn't converge\");\n");
     puts("}\n");
     puts("}\n");
-    splitSizeInc(10);
 
     //
     puts("\nvoid "+modClassName(modp)+"::_eval_initial_loop("+EmitCBaseVisitor::symClassVar()+") {\n");
@@ -1808,23 +1967,30 @@ void EmitCImp::emitWrapEval(AstNodeModule* modp) {
 		 +") vl_fatal(__FILE__,__LINE__,__FILE__,\"Verilated model didn't DC converge\");\n");
     puts(    "}\n");
     puts("}\n");
-    splitSizeInc(10);
 }
 
 //----------------------------------------------------------------------
 // Top interface/ implementation
 
-void EmitCStmts::emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp) {
+struct CmpHotRefs {
+    inline bool operator () (const AstVar* lhsp, const AstVar* rhsp) const {
+	return lhsp->user1() > rhsp->user1();
+    }
+};
+
+void EmitCStmts::emitVarList(AstNode* firstp, EisWhich which, const string& prefixIfImp, EisHot hot) {
     // Put out a list of signal declarations
     // in order of 0:clocks, 1:vluint8, 2:vluint16, 4:vluint32, 5:vluint64, 6:wide, 7:arrays
     // This aids cache packing and locality
     // Largest->smallest reduces the number of pad variables.
     // But for now, Smallest->largest makes it more likely a small offset will allow access to the signal.
+    // Hot variables are additionally ordered most referenced first.
     for (int isstatic=1; isstatic>=0; isstatic--) {
 	if (prefixIfImp!="" && !isstatic) continue;
 	const int sortmax = 9;
 	for (int sort=0; sort<sortmax; sort++) {
 	    if (sort==3) continue;
+	    vector<AstVar*> varps;
 	    for (AstNode* nodep=firstp; nodep; nodep = nodep->nextp()) {
 		if (AstVar* varp = nodep->castVar()) {
 		    bool doit = true;
@@ -1837,6 +2003,7 @@ void EmitCStmts::emitVarList(AstNode* firstp, EisWhich which, const string& pref
 		    default: v3fatalSrc("Bad Case");
 		    }
 		    if (varp->isStatic() ? !isstatic : isstatic) doit=false;
+		    if (hot != EVH_ALL && varIsHot(varp) != (hot == EVH_HOT)) doit=false;
 		    if (doit) {
 			int sigbytes = varp->dtypeSkipRefp()->widthAlignBytes();
 			int sortbytes = sortmax-1;
@@ -1849,11 +2016,15 @@ void EmitCStmts::emitVarList(AstNode* firstp, EisWhich which, const string& pref
 			else if (sigbytes==2) sortbytes=2;
 			else if (sigbytes==1) sortbytes=1;
 			if (sort==sortbytes) {
-			    emitVarDecl(varp, prefixIfImp);
+			    varps.push_back(varp);
 			}
 		    }
 		}
 	    }
+	    if (hot == EVH_HOT) stable_sort(varps.begin(), varps.end(), CmpHotRefs());
+	    for (vector<AstVar*>::iterator it = varps.begin(); it != varps.end(); ++it) {
+		emitVarDecl(*it, prefixIfImp);
+	    }
 	}
     }
 }
@@ -1924,6 +2095,12 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
 	    puts("class "+modClassName(cellp->modp())+";\n");
 	}
     }
+    if (modp->isTop() && v3Global.opt.shareInstances()) {
+	// Functions shared between instances take an instance of any module
+	for (AstNodeModule* submodp=v3Global.rootp()->modulesp(); submodp; submodp=submodp->nextp()->castNodeModule()) {
+	    if (!submodp->isTop()) puts("class "+modClassName(submodp)+";\n");
+	}
+    }
     if (v3Global.opt.trace()) {
 	puts("class "+v3Global.opt.traceClassBase()+";\n");
     }
@@ -1968,15 +2145,29 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
     puts("\n// PORTS\n");
     if (modp->isTop()) puts("// The application code writes and reads these signals to\n");
     if (modp->isTop()) puts("// propagate new values into/out from the Verilated model.\n");
+    if (modp->isTop() && v3Global.opt.batch()) {
+	puts("// With --batch, each is an array holding one element per lane.\n");
+	puts("enum { BATCH = "+cvtToStr(v3Global.opt.batch())+" };\t///< Lanes per model\n");
+    }
     emitVarList(modp->stmtsp(), EVL_IO, "");
 
+    // With -Oh, the signals and variables used every evaluation are packed
+    // together ahead of those only used at initialization, and of memories
+    EisHot hot = v3Global.opt.oHotCold() ? EVH_HOT : EVH_ALL;
     puts("\n// LOCAL SIGNALS\n");
     if (modp->isTop()) puts("// Internals; generally not touched by application code\n");
-    emitVarList(modp->stmtsp(), EVL_SIG, "");
+    emitVarList(modp->stmtsp(), EVL_SIG, "", hot);
 
     puts("\n// LOCAL VARIABLES\n");
     if (modp->isTop()) puts("// Internals; generally not touched by application code\n");
-    emitVarList(modp->stmtsp(), EVL_TEMP, "");
+    emitVarList(modp->stmtsp(), EVL_TEMP, "", hot);
+
+    if (hot != EVH_ALL) {
+	puts("\n// COLD SIGNALS AND VARIABLES\n");
+	if (modp->isTop()) puts("// Memories, and internals not accessed every evaluation\n");
+	emitVarList(modp->stmtsp(), EVL_SIG, "", EVH_COLD);
+	emitVarList(modp->stmtsp(), EVL_TEMP, "", EVH_COLD);
+    }
 
     puts("\n// INTERNAL VARIABLES\n");
     if (modp->isTop()) puts("// Internals; generally not touched by application code\n");
@@ -2046,8 +2237,12 @@ void EmitCImp::emitInt(AstNodeModule* modp) {
 	    puts("/// Construct the model; called by application code\n");
 	    puts("/// The special name "" may be used to make a wrapper with a\n");
 	    puts("/// single model invisible WRT DPI scope names.\n");
+	    puts("/// Models given different contexts may be evaluated on different threads;\n");
+	    puts("/// the context must outlive the model.\n");
+	    puts(modClassName(modp)+"(const char* name=\"TOP\", VerilatedContext* contextp=NULL);\n");
+	} else {
+	    puts(modClassName(modp)+"(const char* name=\"TOP\");\n");
 	}
-	puts(modClassName(modp)+"(const char* name=\"TOP\");\n");
 	if (modp->isTop()) puts("/// Destroy the model; called (often implicitly) by application code\n");
 	puts("~"+modClassName(modp)+"();\n");
     }
@@ -2180,54 +2375,102 @@ void EmitCImp::emitImp(AstNodeModule* modp) {
 
 //######################################################################
 
-void EmitCImp::main(AstNodeModule* modp, bool slow, bool fast) {
-    // Output a module
-    m_modp = modp;
-    m_slow = slow;
-    m_fast = fast;
-
-    if (debug()>=5) {
-	UINFO(0,"  Emitting "<<modClassName(modp)<<endl);
-    }
-
-    if (optSystemC()) {
-	if (m_fast) {
-	    m_ofp = newOutCFile (modp, !m_fast, false/*source*/);
-	    emitInt (modp);
-	    delete m_ofp; m_ofp=NULL;
+void EmitCImp::mainPlan(SplitPlan& plan, vector<int>& sizes) {
+    // Decide which functions go into which split file before any text is
+    // formatted, so each file can be emitted on its own.  Functions are
+    // packed by estimated compile cost into as many files as --output-split
+    // needs, so no single file holds up a parallel make.
+    FuncVec funcs;
+    vector<int> costs;
+    // Fixed code emitImp() puts into the primary file
+    int prologue = 0;
+    if (m_slow) {
+	prologue += 10;  // emitConfigureImp
+	prologue += 10;  // emitDestructorImp
+	if (v3Global.opt.coverage()) prologue += 10;  // emitCoverageImp
+    }
+    if (m_fast && m_modp->isTop()) prologue += 20;  // emitWrapEval's two functions
+    int total = prologue;
+    for (AstNode* nodep=m_modp->stmtsp(); nodep; nodep = nodep->nextp()) {
+	if (AstCFunc* funcp = nodep->castCFunc()) {
+	    int cost = 10;  // Even blank functions get a file with a low csplit
+	    if (funcEmitted(funcp)) cost += EmitCBaseCostVisitor(funcp).count();
+	    funcs.push_back(funcp);
+	    costs.push_back(cost);
+	    total += cost;
+	}
+    }
+
+    int nfiles = 1;
+    if (v3Global.opt.outputSplit() && total > v3Global.opt.outputSplit()) {
+	nfiles = (total + v3Global.opt.outputSplit() - 1) / v3Global.opt.outputSplit();
+	// Never more files than functions, plus the primary file
+	nfiles = min(nfiles, (int)funcs.size() + 1);
+    }
+
+    // Largest function first into the least loaded file
+    vector<int> order;
+    for (size_t i=0; i<funcs.size(); ++i) order.push_back(i);
+    stable_sort(order.begin(), order.end(), CmpCostDesc(costs));
+    vector<int> loads (nfiles, 0);
+    loads[0] = prologue;
+    vector<int> fileOf (funcs.size(), 0);
+    for (vector<int>::iterator it = order.begin(); it != order.end(); ++it) {
+	int best = 0;
+	for (int f=1; f<nfiles; ++f) if (loads[f] < loads[best]) best = f;
+	fileOf[*it] = best;
+	loads[best] += costs[*it];
+    }
+
+    // Functions keep their module order within each file; drop unused files
+    SplitPlan bins (nfiles);
+    for (size_t i=0; i<funcs.size(); ++i) bins[fileOf[i]].push_back(funcs[i]);
+    plan.clear();
+    sizes.clear();
+    for (int f=0; f<nfiles; ++f) {
+	if (f && bins[f].empty()) continue;
+	plan.push_back(bins[f]);
+	sizes.push_back(loads[f]);
+	if (v3Global.opt.stats()) {
+	    EmitCCostReport::addFile(outCFilename(m_modp, !m_fast, true, plan.size()-1), loads[f]);
 	}
+    }
+}
 
-	m_ofp = newOutCFile (modp, !m_fast, true/*source*/);
+void EmitCImp::mainFile(int filenum, const FuncVec& funcs) {
+    // Output one file of the plan; the header goes with the primary file
+    if (debug()>=5) {
+	UINFO(0,"  Emitting "<<modClassName(m_modp)<<" file "<<filenum<<endl);
     }
-    else {
-	if (m_fast) {
-	    m_ofp = newOutCFile (modp, !m_fast, false/*source*/);
-	    emitInt (modp);
-	    delete m_ofp; m_ofp=NULL;
-	}
 
-	m_ofp = newOutCFile (modp, !m_fast, true/*source*/);
+    if (m_fast && filenum==0) {
+	m_ofp = newOutCFile (m_modp, !m_fast, false/*source*/);
+	emitInt (m_modp);
+	delete m_ofp; m_ofp=NULL;
     }
 
-    emitImp (modp);
+    splitFilenum(filenum);
+    m_ofp = newOutCFile (m_modp, !m_fast, true/*source*/, filenum);
+    emitImp (m_modp);
 
-    for (AstNode* nodep=modp->stmtsp(); nodep; nodep = nodep->nextp()) {
-	if (AstCFunc* funcp = nodep->castCFunc()) {
-	    if (splitNeeded()) {
-		// Close old file
-		delete m_ofp; m_ofp=NULL;
-		// Open a new file
-		m_ofp = newOutCFile (modp, !m_fast, true/*source*/, splitFilenumInc());
-		emitImp (modp);
-	    }
-	    splitSizeInc(10);  // Even blank functions get a file with a low csplit
-	    mainDoFunc(funcp);
-	}
+    for (FuncVec::const_iterator it = funcs.begin(); it != funcs.end(); ++it) {
+	mainDoFunc(*it);
     }
 
     delete m_ofp; m_ofp=NULL;
 }
 
+void EmitCImp::main(AstNodeModule* modp, bool slow, bool fast) {
+    // Output a module
+    mainInit(modp, slow, fast);
+    SplitPlan plan;
+    vector<int> sizes;
+    mainPlan(plan, sizes);
+    for (size_t filenum=0; filenum<plan.size(); ++filenum) {
+	mainFile(filenum, plan[filenum]);
+    }
+}
+
 //######################################################################
 // Tracing routines
 
@@ -2329,7 +2572,7 @@ class EmitCTrace : EmitCStmts {
 	putsDecoration("// Callback from vcd->open()\n");
 	puts(topClassName()+"* t=("+topClassName()+"*)userthis;\n");
 	puts(EmitCBaseVisitor::symClassVar()+" = t->__VlSymsp; // Setup global symbol table\n");
-	puts("if (!Verilated::calcUnusedSigs()) vl_fatal(__FILE__,__LINE__,__FILE__,\"Turning on wave traces requires Verilated::traceEverOn(true) call before time 0.\");\n");
+	puts("if (!vlSymsp->__Vm_contextp->calcUnusedSigs()) vl_fatal(__FILE__,__LINE__,__FILE__,\"Turning on wave traces requires Verilated::traceEverOn(true) call before time 0.\");\n");
 
 	puts("vcdp->scopeEscape(' ');\n");
 	puts("t->traceInitThis (vlSymsp, vcdp, code);\n");
@@ -2566,20 +2809,232 @@ public:
     }
 };
 
+//######################################################################
+// Hot variable detection
+//
+// Variables referenced from fast (non-slow) functions are accessed every
+// evaluation, so their declarations are grouped in the class so _eval
+// touches fewer cache lines.  Those only referenced from _eval_initial,
+// _eval_settle and the like are left with the memories.
+
+class EmitCHotVisitor : public AstNVisitor {
+private:
+    // NODE STATE
+    // Entire netlist, held by the caller through emission:
+    //  AstVar::user1()		-> int.  References from fast functions
+
+    // STATE
+    AstCFunc*	m_funcp;	// Current function
+    V3Double0	m_statHot;	// Statistic tracking
+    V3Double0	m_statCold;	// Statistic tracking
+
+    // VISITORS
+    virtual void visit(AstCFunc* nodep) {
+	m_funcp = nodep;
+	nodep->iterateChildren(*this);
+	m_funcp = NULL;
+    }
+    virtual void visit(AstVarRef* nodep) {
+	if (m_funcp && !m_funcp->slow()) {
+	    nodep->varp()->user1Inc();
+	}
+    }
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+    void countVars(AstNetlist* nodep) {
+	for (AstNodeModule* modp = nodep->modulesp(); modp; modp=modp->nextp()->castNodeModule()) {
+	    for (AstNode* stmtp = modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+		if (AstVar* varp = stmtp->castVar()) {
+		    if ((varp->isSignal() || varp->isTemp()) && !varp->isIO()) {
+			if (varp->user1() && !varp->dtypeSkipRefp()->castUnpackArrayDType()) ++m_statHot;
+			else ++m_statCold;
+		    }
+		}
+	    }
+	}
+    }
+public:
+    // CONSTRUCTORS
+    explicit EmitCHotVisitor(AstNetlist* nodep) {
+	m_funcp = NULL;
+	nodep->accept(*this);
+	countVars(nodep);
+    }
+    virtual ~EmitCHotVisitor() {
+	V3Stats::addStat("EmitC, Hot members", m_statHot);
+	V3Stats::addStat("EmitC, Cold members", m_statCold);
+    }
+};
+
+//######################################################################
+// Parallel emission
+//
+// The netlist is read-only by now, so each split file is formatted by a
+// forked worker process working on its own copy of the tree.  The parent
+// records the output files in the netlist and dependency lists itself, so
+// the makefiles are identical to a serial run.
+
+class EmitCJobs {
+    // TYPES
+    struct Job {
+	AstNodeModule*	m_modp;
+	bool		m_slow;
+	bool		m_fast;
+	int		m_filenum;
+	EmitCImp::FuncVec m_funcs;
+	int		m_cost;		// Estimated formatting cost
+	int		m_worker;	// Worker number that emits this job
+    };
+    typedef vector<Job> JobVec;
+    struct CmpCost {
+	inline bool operator () (const Job* lhsp, const Job* rhsp) const {
+	    return lhsp->m_cost > rhsp->m_cost;
+	}
+    };
+
+    // MEMBERS
+    JobVec	m_jobs;		// All files to emit, in serial emission order
+    int		m_workers;	// Number of worker processes
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+    void addModule(AstNodeModule* modp, bool slow, bool fast) {
+	EmitCImp imp;
+	imp.mainInit(modp, slow, fast);
+	EmitCImp::SplitPlan plan;
+	vector<int> sizes;
+	imp.mainPlan(plan, sizes);
+	for (size_t filenum=0; filenum<plan.size(); ++filenum) {
+	    Job job;
+	    job.m_modp = modp;
+	    job.m_slow = slow;
+	    job.m_fast = fast;
+	    job.m_filenum = filenum;
+	    job.m_funcs = plan[filenum];
+	    job.m_cost = sizes[filenum];
+	    job.m_worker = 0;
+	    m_jobs.push_back(job);
+	}
+    }
+    void newCFile(const string& filename, bool slow, bool source) {
+	AstCFile* cfilep = new AstCFile(v3Global.rootp()->fileline(), filename);
+	cfilep->slow(slow);
+	cfilep->source(source);
+	v3Global.rootp()->addFilesp(cfilep);
+	V3File::addTgtDepend(filename);
+    }
+    void assignWorkers() {
+	// Largest job first onto the least loaded worker
+	vector<Job*> sorted;
+	for (JobVec::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it) sorted.push_back(&(*it));
+	stable_sort(sorted.begin(), sorted.end(), CmpCost());
+	vector<int> loads (m_workers, 0);
+	for (vector<Job*>::iterator it = sorted.begin(); it != sorted.end(); ++it) {
+	    int best = 0;
+	    for (int w=1; w<m_workers; ++w) if (loads[w] < loads[best]) best = w;
+	    (*it)->m_worker = best;
+	    loads[best] += (*it)->m_cost;
+	}
+    }
+    void emitWorker(int worker) {
+	for (JobVec::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+	    if (it->m_worker != worker) continue;
+	    EmitCImp imp;
+	    imp.newCFiles(false);
+	    imp.mainInit(it->m_modp, it->m_slow, it->m_fast);
+	    imp.mainFile(it->m_filenum, it->m_funcs);
+	}
+    }
+    void emitParallel() {
+#ifdef EMITC_FORK
+	// Flush so buffered output isn't duplicated into each worker
+	cout.flush(); cerr.flush(); fflush(stdout); fflush(stderr);
+	vector<pid_t> pids;
+	for (int worker=0; worker<m_workers; ++worker) {
+	    pid_t pid = fork();
+	    if (pid < 0) v3fatal("--output-jobs: fork failed: "<<strerror(errno));
+	    if (pid == 0) {  // Child
+		emitWorker(worker);
+		cout.flush(); cerr.flush(); fflush(stdout); fflush(stderr);
+		// Don't run destructors; the parent still owns the netlist
+		_exit((V3Error::errorCount() ? 1 : 0) | (V3Error::warnCount() ? 2 : 0));
+	    }
+	    UINFO(6,"Emit worker "<<worker<<" pid "<<pid<<endl);
+	    pids.push_back(pid);
+	}
+	for (vector<pid_t>::iterator it = pids.begin(); it != pids.end(); ++it) {
+	    int status = 0;
+	    while (waitpid(*it, &status, 0) < 0) {
+		if (errno != EINTR) v3fatal("--output-jobs: waitpid failed: "<<strerror(errno));
+	    }
+	    // Workers exit with 0-3 below; anything else, such as vlAbort's
+	    // exit after a fatal error, left files unwritten
+	    if (!WIFEXITED(status) || WEXITSTATUS(status) > 3) {
+		v3fatal("--output-jobs: emit worker terminated abnormally");
+	    }
+	    // Messages were printed by the worker; carry its counts into ours
+	    if (WEXITSTATUS(status) & 1) V3Error::incErrors();
+	    if (WEXITSTATUS(status) & 2) V3Error::incWarnings();
+	}
+#else
+	for (int worker=0; worker<m_workers; ++worker) emitWorker(worker);
+#endif
+    }
+public:
+    // CONSTUCTORS
+    explicit EmitCJobs(int workers) {
+	// Process each module in turn
+	for (AstNodeModule* nodep = v3Global.rootp()->modulesp(); nodep; nodep=nodep->nextp()->castNodeModule()) {
+	    if (v3Global.opt.outputSplit()) {
+		addModule(nodep, false, true);
+		addModule(nodep, true, false);
+	    } else {
+		addModule(nodep, true, true);
+	    }
+	}
+	m_workers = min(workers, (int)m_jobs.size());
+	UINFO(4,"Emitting "<<m_jobs.size()<<" files with "<<m_workers<<" workers"<<endl);
+	// Files in the same order a serial emit creates them
+	for (JobVec::iterator it = m_jobs.begin(); it != m_jobs.end(); ++it) {
+	    if (it->m_fast && it->m_filenum==0) {
+		newCFile(EmitCImp::outCFilename(it->m_modp, !it->m_fast, false, 0), !it->m_fast, false);
+	    }
+	    newCFile(EmitCImp::outCFilename(it->m_modp, !it->m_fast, true, it->m_filenum), !it->m_fast, true);
+	}
+	assignWorkers();
+	emitParallel();
+    }
+    ~EmitCJobs() {}
+};
+
 //######################################################################
 // EmitC class functions
 
 void V3EmitC::emitc() {
     UINFO(2,__FUNCTION__<<": "<<endl);
-    // Process each module in turn
-    for (AstNodeModule* nodep = v3Global.rootp()->modulesp(); nodep; nodep=nodep->nextp()->castNodeModule()) {
-	if (v3Global.opt.outputSplit()) {
-	    { EmitCImp imp; imp.main(nodep, false, true); }
-	    { EmitCImp imp; imp.main(nodep, true, false); }
-	} else {
-	    { EmitCImp imp; imp.main(nodep, true, true); }
+    AstUser1InUse	inuser1;
+    if (v3Global.opt.oHotCold()) {
+	EmitCHotVisitor visitor (v3Global.rootp());
+    }
+    if (v3Global.opt.outputJobs() > 1 && !v3Global.opt.lintOnly()) {
+	EmitCJobs jobs (v3Global.opt.outputJobs());
+    } else {
+	// Process each module in turn
+	for (AstNodeModule* nodep = v3Global.rootp()->modulesp(); nodep; nodep=nodep->nextp()->castNodeModule()) {
+	    if (v3Global.opt.outputSplit()) {
+		{ EmitCImp imp; imp.main(nodep, false, true); }
+		{ EmitCImp imp; imp.main(nodep, true, false); }
+	    } else {
+		{ EmitCImp imp; imp.main(nodep, true, true); }
+	    }
 	}
     }
+    if (v3Global.opt.stats()) EmitCCostReport::report();
 }
 
 void V3EmitC::emitcTrace() {
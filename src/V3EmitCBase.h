@@ -59,6 +59,15 @@ public:
     static string topClassName() {		// Return name of top wrapper module
 	return v3Global.opt.prefix();
     }
+    static bool batchVar(AstVar* varp) {	// Variable has one element per --batch lane
+	return v3Global.opt.batch() && !varp->isLaneShared();
+    }
+    static string batchIndex(AstVar* varp) {	// Index selecting the current --batch lane
+	return batchVar(varp) ? "[vlLane]" : "";
+    }
+    static string batchLoop() {		// Loop over each --batch lane
+	return "for (int vlLane=0; vlLane<"+cvtToStr(v3Global.opt.batch())+"; ++vlLane) {\n";
+    }
     AstCFile* newCFile(const string& filename, bool slow, bool source) {
 	AstCFile* cfilep = new AstCFile(v3Global.rootp()->fileline(), filename);
 	cfilep->slow(slow);
@@ -114,4 +123,49 @@ public:
     int count() const { return m_count; }
 };
 
+//######################################################################
+// Estimate the C++ compile cost of the given node, in the same units as
+// EmitCBaseCounterVisitor, for balancing split functions and files
+
+class EmitCBaseCostVisitor : public AstNVisitor {
+private:
+    // STATE
+    int			m_cost;		// Estimated cost
+    int			m_depth;	// Current expression depth
+    // VISITORS
+    virtual void visit(AstNodeMath* nodep) {
+	// Wide operations become per-word code or library calls, and each
+	// further level of a deep expression is slower for the compiler
+	m_cost += nodep->widthInstrs() + m_depth/4;
+	++m_depth;
+	nodep->iterateChildren(*this);
+	--m_depth;
+    }
+    virtual void visit(AstNodeIf* nodep) {
+	m_cost += 2;  // New basic blocks
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstWhile* nodep) {
+	m_cost += 2;
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstCReset* nodep) {
+	m_cost += nodep->widthInstrs() + 1;  // Each variable reset is a statement of its own
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstNode* nodep) {
+	m_cost += nodep->widthInstrs();
+	nodep->iterateChildren(*this);
+    }
+public:
+    // CONSTUCTORS
+    explicit EmitCBaseCostVisitor(AstNode* nodep) {
+	m_cost = 0;
+	m_depth = 0;
+	nodep->accept(*this);
+    }
+    virtual ~EmitCBaseCostVisitor() {}
+    int count() const { return m_cost; }
+};
+
 #endif // guard
@@ -33,6 +33,7 @@
 #include "V3EmitC.h"
 #include "V3EmitCBase.h"
 #include "V3LanguageWords.h"
+#include "V3ProfFeedback.h"
 
 //######################################################################
 // Symbol table emitting
@@ -91,8 +92,13 @@ class EmitCSyms : EmitCBaseVisitor {
     int		m_labelNum;		// Next label number
 
     // METHODS
+    static int profCounters() {
+	return v3Global.opt.profFeedbackGen()=="" ? 0 : V3ProfFeedback::counterNames().size();
+    }
     void emitSymHdr();
     void emitSymImp();
+    void emitSymProfWrite();
+    void emitPchHdr();
     void emitDpiHdr();
     void emitDpiImp();
 
@@ -175,6 +181,7 @@ class EmitCSyms : EmitCBaseVisitor {
 	// Output
 	emitSymHdr();
 	emitSymImp();
+	emitPchHdr();
 	if (v3Global.dpi()) {
 	    emitDpiHdr();
 	    emitDpiImp();
@@ -324,14 +331,23 @@ void EmitCSyms::emitSymHdr() {
 	puts("uint32_t\t__Vcoverage["); puts(cvtToStr(m_coverBins)); puts("];\n");
     }
 
+    if (profCounters()) {
+	puts("\n// PROFILE FEEDBACK\n");
+	puts("vluint64_t\t__Vm_profCounts["+cvtToStr(profCounters())+"];\t///< Calls of each function\n");
+    }
+
     puts("\n// SCOPE NAMES\n");
     for (ScopeNames::iterator it = m_scopeNames.begin(); it != m_scopeNames.end(); ++it) {
 	puts("VerilatedScope __Vscope_"+it->second.m_symName+";\n");
     }
 
     puts("\n// CREATORS\n");
-    puts(symClassName()+"("+topClassName()+"* topp, const char* namep);\n");
-    puts((string)"~"+symClassName()+"() {};\n");
+    puts(symClassName()+"("+topClassName()+"* topp, const char* namep, VerilatedContext* contextp);\n");
+    if (profCounters()) {
+	puts((string)"~"+symClassName()+"();\n");
+    } else {
+	puts((string)"~"+symClassName()+"() {};\n");
+    }
 
     puts("\n// METHODS\n");
     puts("inline const char* name() { return __Vm_namep; }\n");
@@ -346,6 +362,63 @@ void EmitCSyms::emitSymHdr() {
     puts("#endif  /*guard*/\n");
 }
 
+void EmitCSyms::emitPchHdr() {
+    UINFO(6,__FUNCTION__<<": "<<endl);
+    string filename = v3Global.opt.makeDir()+"/"+topClassName()+"__pch.h";
+    newCFile(filename, true/*slow*/, false/*source*/);
+    V3OutCFile hf (filename);
+    m_ofp = &hf;
+
+    ofp()->putsHeader();
+    puts("// DESCR" "IPTION: Verilator output: Precompiled header\n");
+    puts("//\n");
+    puts("// Internal details; includes the headers common to all generated .cpp files,\n");
+    puts("// so verilated.mk can compile them once as a precompiled header.\n");
+    puts("\n");
+
+    puts("#ifndef _"+topClassName()+"__pch_H_\n");
+    puts("#define _"+topClassName()+"__pch_H_\n");
+    puts("\n");
+
+    // The symbol table includes verilated.h and every module class
+    puts("#include \""+symClassName()+".h\"\n");
+    if (v3Global.dpi()) {
+	puts("#include \"verilated_dpi.h\"\n");
+    }
+    if (v3Global.opt.trace()) {
+	puts("#include \"verilated_vcd_c.h\"\n");
+    }
+    puts("\n");
+    puts("#endif  /*guard*/\n");
+}
+
+void EmitCSyms::emitSymProfWrite() {
+    // Destructor writes the --prof-feedback-gen counts for --prof-feedback-use
+    const vector<string>& names = V3ProfFeedback::counterNames();
+    puts("\n");
+    puts(symClassName()+"::~"+symClassName()+"() {\n");
+    puts("static const char* const names[] = {\n");
+    for (vector<string>::const_iterator it = names.begin(); it != names.end(); ++it) {
+	putsQuoted(*it); puts(",\n");
+    }
+    puts("};\n");
+    puts("FILE* fp = fopen(");
+    putsQuoted(v3Global.opt.profFeedbackGen());
+    puts(", \"w\");\n");
+    puts("if (VL_UNLIKELY(!fp)) {\n");
+    puts(   "VL_PRINTF(\"%%Warning: Can't write profile feedback file: %s\\n\", ");
+    putsQuoted(v3Global.opt.profFeedbackGen());
+    puts(");\n");
+    puts(   "return;\n");
+    puts("}\n");
+    puts("fputs(\"# Verilator profile feedback; use with --prof-feedback-use\\n\", fp);\n");
+    puts("for (int i=0; i<"+cvtToStr(names.size())+"; ++i) {\n");
+    puts(   "fprintf(fp, \"cfunc %s %\" VL_PRI64 \"u\\n\", names[i], __Vm_profCounts[i]);\n");
+    puts("}\n");
+    puts("fclose(fp);\n");
+    puts("}\n");
+}
+
 void EmitCSyms::emitSymImp() {
     UINFO(6,__FUNCTION__<<": "<<endl);
     string filename = v3Global.opt.makeDir()+"/"+symClassName()+".cpp";
@@ -366,9 +439,11 @@ void EmitCSyms::emitSymImp() {
     //puts("\n// GLOBALS\n");
 
     puts("\n// FUNCTIONS\n");
-    puts(symClassName()+"::"+symClassName()+"("+topClassName()+"* topp, const char* namep)\n");
+    puts(symClassName()+"::"+symClassName()+"("+topClassName()+"* topp, const char* namep,"
+	 " VerilatedContext* contextp)\n");
+    puts("\t: VerilatedSyms(contextp)\n");
     puts("\t// Setup locals\n");
-    puts("\t: __Vm_namep(namep)\n");	// No leak, as we get destroyed when the top is destroyed
+    puts("\t, __Vm_namep(namep)\n");	// No leak, as we get destroyed when the top is destroyed
     puts("\t, __Vm_activity(false)\n");
     puts("\t, __Vm_didInit(false)\n");
     puts("\t// Setup submodule names\n");
@@ -390,6 +465,10 @@ void EmitCSyms::emitSymImp() {
 
     puts("// Pointer to top level\n");
     puts("TOPp = topp;\n");
+    if (profCounters()) {
+	puts("// Clear profile feedback counts\n");
+	puts("for (int i=0; i<"+cvtToStr(profCounters())+"; ++i) __Vm_profCounts[i] = 0;\n");
+    }
     puts("// Setup each module's pointers to their submodules\n");
     for (vector<ScopeModPair>::iterator it = m_scopes.begin(); it != m_scopes.end(); ++it) {
 	AstScope* scopep = it->first;  AstNodeModule* modp = it->second;
@@ -503,6 +582,8 @@ void EmitCSyms::emitSymImp() {
 
     puts("}\n");
 
+    if (profCounters()) emitSymProfWrite();
+
     if (v3Global.opt.savable() ) {
 	puts("\n");
 	for (int de=0; de<2; ++de) {
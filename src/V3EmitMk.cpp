@@ -64,6 +64,8 @@ public:
 	of.puts("VM_COVERAGE = "); of.puts(v3Global.opt.coverage()?"1":"0"); of.puts("\n");
 	of.puts("# Tracing output mode?  0/1 (from --trace)\n");
 	of.puts("VM_TRACE = "); of.puts(v3Global.opt.trace()?"1":"0"); of.puts("\n");
+	of.puts("# Precompiled header for parallel builds, empty to disable\n");
+	of.puts("VM_PCH_H = "+v3Global.opt.prefix()+"__pch.h\n");
 
 	of.puts("\n### Object file lists...\n");
 	for (int support=0; support<3; support++) {
@@ -26,6 +26,9 @@
 //	    Note in this case that the widthMin is not correct for the MSW of
 //	    the vector.  This must be accounted for if doing later constant
 //	    propagation across signals.
+//	Wide bitwise, equality and reduction operations on signals of at least
+//	--wide-vector-words words are instead left for the vectorized
+//	VL_*_W helpers in verilated.h.
 //
 //*************************************************************************
 
@@ -38,6 +41,7 @@
 
 #include "V3Global.h"
 #include "V3Expand.h"
+#include "V3Stats.h"
 #include "V3Ast.h"
 
 //######################################################################
@@ -51,6 +55,7 @@ private:
 
     // STATE
     AstNode*		m_stmtp;	// Current statement
+    V3Double0		m_statWideVector;	// Statistic tracking
 
     // METHODS
     static int debug() {
@@ -59,6 +64,24 @@ private:
 	return level;
     }
 
+    bool vectorOperand (AstNode* nodep) {
+	// Operand the VL_*_W helpers can take by pointer without a temporary
+	return ((nodep->castVarRef() || nodep->castArraySel())
+		&& !AstVar::scVarRecurse(nodep));
+    }
+    bool keepWideVector (AstNode* lhsp, AstNode* rhsp) {
+	// True to leave the operation to the vectorized runtime helper
+	int minWords = v3Global.opt.wideVectorWords();
+	if (!minWords || lhsp->widthWords() < minWords) return false;
+	if (!vectorOperand(lhsp) || (rhsp && !vectorOperand(rhsp))) return false;
+	++m_statWideVector;
+	return true;
+    }
+    bool keepWideVector (AstNodeAssign* nodep, AstNode* lhsp, AstNode* rhsp) {
+	// The helper writes the result directly into the destination variable
+	return (nodep->lhsp()->castVarRef() && keepWideVector(lhsp, rhsp));
+    }
+
     int longOrQuadWidth (AstNode* nodep) {
 	// Return 32 or 64...
 	return (nodep->width()+(VL_WORDSIZE-1)) & ~(VL_WORDSIZE-1);
@@ -260,6 +283,7 @@ private:
     }
     //-------- Biops
     bool expandWide (AstNodeAssign* nodep, AstAnd* rhsp) {
+	if (keepWideVector(nodep, rhsp->lhsp(), rhsp->rhsp())) return false;
 	UINFO(8,"    Wordize ASSIGN(AND) "<<nodep<<endl);
 	for (int w=0; w<nodep->widthWords(); w++) {
 	    addWordAssign(nodep, w, new AstAnd (nodep->fileline(),
@@ -269,6 +293,7 @@ private:
 	return true;
     }
     bool expandWide (AstNodeAssign* nodep, AstOr* rhsp) {
+	if (keepWideVector(nodep, rhsp->lhsp(), rhsp->rhsp())) return false;
 	UINFO(8,"    Wordize ASSIGN(OR) "<<nodep<<endl);
 	for (int w=0; w<nodep->widthWords(); w++) {
 	    addWordAssign(nodep, w, new AstOr (nodep->fileline(),
@@ -278,6 +303,7 @@ private:
 	return true;
     }
     bool expandWide (AstNodeAssign* nodep, AstXor* rhsp) {
+	if (keepWideVector(nodep, rhsp->lhsp(), rhsp->rhsp())) return false;
 	UINFO(8,"    Wordize ASSIGN(XOR) "<<nodep<<endl);
 	for (int w=0; w<nodep->widthWords(); w++) {
 	    addWordAssign(nodep, w, new AstXor (nodep->fileline(),
@@ -752,6 +778,7 @@ private:
     virtual void visit(AstChangeXor* nodep) {
 	if (nodep->user1SetOnce()) return;  // Process once
 	nodep->iterateChildren(*this);
+	if (nodep->lhsp()->isWide() && keepWideVector(nodep->lhsp(), nodep->rhsp())) return;
 	UINFO(8,"    Wordize ChangeXor "<<nodep<<endl);
 	// -> (0=={or{for each_word{WORDSEL(lhs,#)^WORDSEL(rhs,#)}}}
 	AstNode* newp = NULL;
@@ -767,7 +794,8 @@ private:
     void visitEqNeq(AstNodeBiop* nodep) {
 	if (nodep->user1SetOnce()) return;  // Process once
 	nodep->iterateChildren(*this);
-	if (nodep->lhsp()->isWide()) {
+	if (nodep->lhsp()->isWide()
+	    && !keepWideVector(nodep->lhsp(), nodep->rhsp())) {
 	    UINFO(8,"    Wordize EQ/NEQ "<<nodep<<endl);
 	    // -> (0=={or{for each_word{WORDSEL(lhs,#)^WORDSEL(rhs,#)}}}
 	    AstNode* newp = NULL;
@@ -793,7 +821,9 @@ private:
     virtual void visit(AstRedOr* nodep) {
 	if (nodep->user1SetOnce()) return;  // Process once
 	nodep->iterateChildren(*this);
-	if (nodep->lhsp()->isWide()) {
+	if (nodep->lhsp()->isWide() && keepWideVector(nodep->lhsp(), NULL)) {
+	    UINFO(8,"    Vector REDOR "<<nodep<<endl);
+	} else if (nodep->lhsp()->isWide()) {
 	    UINFO(8,"    Wordize REDOR "<<nodep<<endl);
 	    // -> (0!={or{for each_word{WORDSEL(lhs,#)}}}
 	    AstNode* newp = NULL;
@@ -846,7 +876,8 @@ private:
     virtual void visit(AstRedXor* nodep) {
 	if (nodep->user1SetOnce()) return;  // Process once
 	nodep->iterateChildren(*this);
-	if (nodep->lhsp()->isWide()) {
+	if (nodep->lhsp()->isWide()
+	    && !keepWideVector(nodep->lhsp(), NULL)) {
 	    UINFO(8,"    Wordize REDXOR "<<nodep<<endl);
 	    // -> (0!={redxor{for each_word{XOR(WORDSEL(lhs,#))}}}
 	    AstNode* newp = NULL;
@@ -925,7 +956,9 @@ public:
 	m_stmtp=NULL;
 	nodep->accept(*this);
     }
-    virtual ~ExpandVisitor() {}
+    virtual ~ExpandVisitor() {
+	V3Stats::addStat("Optimizations, Wide vector ops", m_statWideVector);
+    }
 };
 
 //----------------------------------------------------------------------
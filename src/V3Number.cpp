@@ -1439,12 +1439,10 @@ V3Number& V3Number::opModDivGuts(const V3Number& lhs, const V3Number& rhs, bool
     }
 
     // +1 word as we may shift during normalization
-    uint32_t un[VL_MULS_MAX_WORDS+1]; // Fixed size, as MSVC++ doesn't allow [words] here
-    uint32_t vn[VL_MULS_MAX_WORDS+1]; // v normalized
-
     // Zero for ease of debugging and to save having to zero for shifts
+    vector<uint32_t> un (words+1, 0);  // +1 as vn may get extra word
+    vector<uint32_t> vn (words+1, 0);  // v normalized
     for (int i=0; i<words; i++) { m_value[i]=0; }
-    for (int i=0; i<words+1; i++) { un[i]=vn[i]=0; }  // +1 as vn may get extra word
 
     // Algorithm requires divisor MSB to be set
     // Copy and shift to normalize divisor so MSB of vn[vw-1] is set
@@ -242,6 +242,27 @@ string V3Options::allArgsString() {
     return out;
 }
 
+string V3Options::filePathString() {
+    // Everything filePath() and fileLanguage() look at, so a cache may tell if a
+    // filename could now resolve differently
+    string out;
+    for (list<string>::iterator it=m_impp->m_incDirUsers.begin(); it!=m_impp->m_incDirUsers.end(); ++it) {
+	out += " +incdir+"+*it;
+    }
+    for (list<string>::iterator it=m_impp->m_incDirFallbacks.begin(); it!=m_impp->m_incDirFallbacks.end(); ++it) {
+	out += " -y "+*it;
+    }
+    for (list<string>::iterator it=m_impp->m_libExtVs.begin(); it!=m_impp->m_libExtVs.end(); ++it) {
+	out += " +libext+"+*it;
+    }
+    for (map<string,V3LangCode>::iterator it=m_impp->m_langExts.begin(); it!=m_impp->m_langExts.end(); ++it) {
+	out += " +"+string(it->second.ascii())+"ext+"+it->first;
+    }
+    if (m_relativeIncludes) out += " --relative-includes";
+    out += " --default-language "+string(m_defaultLanguage.ascii());
+    return out;
+}
+
 //######################################################################
 // V3LangCode class functions
 
@@ -551,6 +572,24 @@ void V3Options::parseOpts (FileLine* fl, int argc, char** argv) {
     if (prefix()=="" && vFilesList.size()>=1) m_prefix = string("V")+V3Os::filenameNonExt(*(vFilesList.begin()));
     if (modPrefix()=="") m_modPrefix = prefix();
 
+    // Each signal is a lane mask; tables, tracing and coverage expect scalar values
+    if (bitParallel()) {
+	if (systemC()) v3fatal("--bit-parallel is not supported with --sc");
+	if (trace()) v3fatal("--bit-parallel is not supported with --trace");
+	if (coverage()) v3fatal("--bit-parallel is not supported with --coverage");
+	if (batch()) v3fatal("--bit-parallel is not supported with --batch");
+	if (domainGate()) v3fatal("--bit-parallel is not supported with --domain-gate");
+	m_oTable = false;
+    }
+    // Each signal is an array of lanes; tracing, coverage and saving expect one value
+    if (batch()) {
+	if (systemC()) v3fatal("--batch is not supported with --sc");
+	if (trace()) v3fatal("--batch is not supported with --trace");
+	if (coverage()) v3fatal("--batch is not supported with --coverage");
+	if (savable()) v3fatal("--batch is not supported with --savable");
+	if (domainGate()) v3fatal("--batch is not supported with --domain-gate");
+    }
+
     // Find files in makedir
     addIncDirFallback(makeDir());
 }
@@ -637,6 +676,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 	    else if ( onoff   (sw, "-autoflush", flag/*ref*/) )	{ m_autoflush = flag; }
 	    else if ( onoff   (sw, "-bbox-sys", flag/*ref*/) )	{ m_bboxSys = flag; }
 	    else if ( onoff   (sw, "-bbox-unsup", flag/*ref*/) ) { m_bboxUnsup = flag; }
+	    else if ( onoff   (sw, "-bit-parallel", flag/*ref*/) ) { m_bitParallel = flag; }
 	    else if ( !strcmp (sw, "-cc") )			{ m_outFormatOk = true; m_systemC = false; }
 	    else if ( onoff   (sw, "-cdc", flag/*ref*/) )	{ m_cdc = flag; }
 	    else if ( onoff   (sw, "-coverage", flag/*ref*/) )	{ coverage(flag); }
@@ -650,6 +690,7 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 	    else if ( !strcmp (sw, "-debug-sigsegv") )		{ throwSigsegv(); }  // Undocumented, see also --debug-abort
 	    else if ( !strcmp (sw, "-debug-fatalsrc") )		{ v3fatalSrc("--debug-fatal-src"); }  // Undocumented, see also --debug-abort
 	    else if ( onoff   (sw, "-decoration", flag/*ref*/) ) { m_decoration = flag; }
+	    else if ( onoff   (sw, "-domain-gate", flag/*ref*/) ) { m_domainGate = flag; }
 	    else if ( onoff   (sw, "-dump-tree", flag/*ref*/) )	{ m_dumpTree = flag ? 3 : 0; }  // Also see --dump-treei
 	    else if ( onoff   (sw, "-exe", flag/*ref*/) )	{ m_exe = flag; }
 	    else if ( onoff   (sw, "-ignc", flag/*ref*/) )	{ m_ignc = flag; }
@@ -670,8 +711,10 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 	    else if ( onoff   (sw, "-relative-includes", flag/*ref*/) )	{ m_relativeIncludes = flag; }
 	    else if ( onoff   (sw, "-savable", flag/*ref*/) )		{ m_savable = flag; }
 	    else if ( !strcmp (sw, "-sc") )				{ m_outFormatOk = true; m_systemC = true; }
+	    else if ( onoff   (sw, "-share-instances", flag/*ref*/) )	{ m_shareInstances = flag; }
 	    else if ( onoff   (sw, "-skip-identical", flag/*ref*/) )	{ m_skipIdentical = flag; }
 	    else if ( onoff   (sw, "-stats", flag/*ref*/) )		{ m_stats = flag; }
+	    else if ( onoff   (sw, "-stats-trace", flag/*ref*/) )	{ m_statsTrace = flag; m_stats |= flag; }
 	    else if ( onoff   (sw, "-stats-vars", flag/*ref*/) )	{ m_statsVars = flag; m_stats |= flag; }
 	    else if ( !strcmp (sw, "-sv") )				{ m_defaultLanguage = V3LangCode::L1800_2005; }
 	    else if ( onoff   (sw, "-trace", flag/*ref*/) )		{ m_trace = flag; }
@@ -700,14 +743,18 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 		    case 'e': m_oCase = flag; break;
 		    case 'f': m_oFlopGater = flag; break;
 		    case 'g': m_oGate = flag; break;
+		    case 'h': m_oHotCold = flag; break;
 		    case 'i': m_oInline = flag; break;
 		    case 'k': m_oSubstConst = flag; break;
 		    case 'l': m_oLife = flag; break;
 		    case 'p': m_public = !flag; break;  //With -Op so flag=0, we want public on so few optimizations done
+		    case 'q': m_oOrderLoop = flag; break;
 		    case 'r': m_oReorder = flag; break;
 		    case 's': m_oSplit = flag; break;
 		    case 't': m_oLifePost = flag; break;
 		    case 'u': m_oSubst = flag; break;
+		    case 'v': m_oCse = flag; break;
+		    case 'w': m_oSplitVar = flag; break;
 		    case 'x': m_oExpand = flag; break;
 		    case 'y': m_oAcycSimp = flag; break;
 		    case 'z': m_oLocalize = flag; break;
@@ -720,6 +767,11 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 		shift;
 		addCFlags(argv[i]);
 	    }
+	    else if ( !strcmp (sw, "-batch") && (i+1)<argc ) {
+		shift;
+		m_batch = atoi(argv[i]);
+		if (m_batch < 0) fl->v3fatal("--batch must be >= 0: "<<argv[i]);
+	    }
 	    else if ( !strcmp (sw, "-comp-limits-syms") && (i+1)<argc ) {  // Undocumented
 		shift;
 		VName::maxLength(atoi(argv[i]));
@@ -805,6 +857,11 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 	    else if ( !strcmp (sw, "-o") && (i+1)<argc ) {
 		shift; m_exeName = argv[i];
 	    }
+	    else if ( !strcmp (sw, "-output-jobs") && (i+1)<argc ) {
+		shift;
+		m_outputJobs = atoi(argv[i]);
+		if (m_outputJobs < 1) fl->v3fatal("--output-jobs must be >= 1: "<<argv[i]);
+	    }
 	    else if ( !strcmp (sw, "-output-split") && (i+1)<argc ) {
 		shift;
 		m_outputSplit = atoi(argv[i]);
@@ -821,6 +878,16 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 		shift;
 		m_outputSplitCTrace = atoi(argv[i]);
 	    }
+	    else if ( !strcmp (sw, "-table-cache-bytes") && (i+1)<argc ) {
+		shift;
+		m_tableCacheBytes = atoi(argv[i]);
+		if (m_tableCacheBytes < 0) fl->v3fatal("--table-cache-bytes must be >= 0: "<<argv[i]);
+	    }
+	    else if ( !strcmp (sw, "-table-max-bytes") && (i+1)<argc ) {
+		shift;
+		m_tableMaxBytes = atoi(argv[i]);
+		if (m_tableMaxBytes < 0) fl->v3fatal("--table-max-bytes must be >= 0: "<<argv[i]);
+	    }
 	    else if ( !strcmp (sw, "-trace-depth") && (i+1)<argc ) {
 		shift;
 		m_traceDepth = atoi(argv[i]);
@@ -844,6 +911,16 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 		shift;
 		m_unrollStmts = atoi(argv[i]);
 	    }
+	    else if ( !strcmp (sw, "-wide-template-words") && (i+1)<argc ) {
+		shift;
+		m_wideTemplateWords = atoi(argv[i]);
+		if (m_wideTemplateWords < 0) fl->v3fatal("--wide-template-words must be >= 0: "<<argv[i]);
+	    }
+	    else if ( !strcmp (sw, "-wide-vector-words") && (i+1)<argc ) {
+		shift;
+		m_wideVectorWords = atoi(argv[i]);
+		if (m_wideVectorWords < 0) fl->v3fatal("--wide-vector-words must be >= 0: "<<argv[i]);
+	    }
 	    else if ( !strcmp (sw, "-v") && (i+1)<argc ) {
 		shift;
 		V3Options::addLibraryFile(parseFileArg(optdir,argv[i]));
@@ -961,6 +1038,15 @@ void V3Options::parseOptsList(FileLine* fl, const string& optdir, int argc, char
 		shift; m_prefix = argv[i];
 		if (m_modPrefix=="") m_modPrefix = m_prefix;
 	    }
+	    else if ( !strcmp (sw, "-prof-feedback-gen") && (i+1)<argc ) {
+		shift; m_profFeedbackGen = argv[i];
+	    }
+	    else if ( !strcmp (sw, "-prof-feedback-use") && (i+1)<argc ) {
+		shift; m_profFeedbackUse = parseFileArg(optdir, argv[i]);
+	    }
+	    else if ( !strcmp (sw, "-preproc-cache") && (i+1)<argc ) {
+		shift; m_preprocCache = argv[i];
+	    }
 	    else if ( !strcmp (sw, "-top-module") && (i+1)<argc ) {
 		shift; m_topModule = argv[i];
 	    }
@@ -1155,6 +1241,7 @@ V3Options::V3Options() {
     m_autoflush = false;
     m_bboxSys = false;
     m_bboxUnsup = false;
+    m_bitParallel = false;
     m_cdc = false;
     m_coverageLine = false;
     m_coverageToggle = false;
@@ -1162,6 +1249,7 @@ V3Options::V3Options() {
     m_coverageUser = false;
     m_debugCheck = false;
     m_decoration = true;
+    m_domainGate = false;
     m_exe = false;
     m_ignc = false;
     m_inhibitSim = false;
@@ -1182,8 +1270,10 @@ V3Options::V3Options() {
     m_reportUnoptflat = false;
     m_relativeIncludes = false;
     m_savable = false;
+    m_shareInstances = false;
     m_skipIdentical = true;
     m_stats = false;
+    m_statsTrace = false;
     m_statsVars = false;
     m_systemC = false;
     m_trace = false;
@@ -1196,18 +1286,24 @@ V3Options::V3Options() {
     m_xInitialEdge = false;
     m_xmlOnly = false;
 
+    m_batch = 0;
     m_convergeLimit = 100;
     m_dumpTree = 0;
     m_ifDepth = 0;
     m_inlineMult = 2000;
+    m_outputJobs = 1;
     m_outputSplit = 0;
     m_outputSplitCFuncs = 0;
     m_outputSplitCTrace = 0;
+    m_tableCacheBytes = 256*1024;
+    m_tableMaxBytes = 1024*1024;
     m_traceDepth = 0;
     m_traceMaxArray = 32;
     m_traceMaxWidth = 256;
     m_unrollCount = 64;
     m_unrollStmts = 30000;
+    m_wideTemplateWords = 16;
+    m_wideVectorWords = 8;
 
     m_compLimitParens = 0;
     m_compLimitBlocks = 0;
@@ -1292,16 +1388,20 @@ void V3Options::optimize(int level) {
     m_oAcycSimp = flag;
     m_oCase = flag;
     m_oCombine = flag;
+    m_oCse = flag;
     m_oConst = flag;
     m_oExpand = flag;
     m_oFlopGater = flag;
     m_oGate = flag;
+    m_oHotCold = flag;
     m_oInline = flag;
     m_oLife = flag;
     m_oLifePost = flag;
     m_oLocalize = flag;
+    m_oOrderLoop = flag;
     m_oReorder = flag;
     m_oSplit = flag;
+    m_oSplitVar = flag;
     m_oSubst = flag;
     m_oSubstConst = flag;
     m_oTable = flag;
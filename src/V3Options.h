@@ -70,6 +70,7 @@ class V3Options {
     bool	m_autoflush;	// main switch: --autoflush
     bool	m_bboxSys;	// main switch: --bbox-sys
     bool	m_bboxUnsup;	// main switch: --bbox-unsup
+    bool	m_bitParallel;	// main switch: --bit-parallel
     bool	m_cdc;		// main switch: --cdc
     bool	m_coverageLine;	// main switch: --coverage-block
     bool	m_coverageToggle;// main switch: --coverage-toggle
@@ -77,6 +78,7 @@ class V3Options {
     bool	m_coverageUser;	// main switch: --coverage-func
     bool	m_debugCheck;	// main switch: --debug-check
     bool	m_decoration;	// main switch: --decoration
+    bool	m_domainGate;	// main switch: --domain-gate
     bool	m_exe;		// main switch: --exe
     bool	m_ignc;		// main switch: --ignc
     bool	m_inhibitSim;	// main switch: --inhibit-sim
@@ -93,8 +95,10 @@ class V3Options {
     bool	m_relativeIncludes; // main switch: --relative-includes
     bool	m_savable;	// main switch: --savable
     bool	m_systemC;	// main switch: --sc: System C instead of simple C++
+    bool	m_shareInstances;// main switch: --share-instances
     bool	m_skipIdentical;// main switch: --skip-identical
     bool	m_stats;	// main switch: --stats
+    bool	m_statsTrace;	// main switch: --stats-trace
     bool	m_statsVars;	// main switch: --stats-vars
     bool	m_trace;	// main switch: --trace
     bool	m_traceDups;	// main switch: --trace-dups
@@ -106,19 +110,25 @@ class V3Options {
     bool	m_xInitialEdge;	// main switch: --x-initial-edge
     bool	m_xmlOnly;	// main switch: --xml-netlist
 
+    int		m_batch;	// main switch: --batch
     int		m_convergeLimit;// main switch: --converge-limit
     int		m_dumpTree;	// main switch: --dump-tree
     int		m_ifDepth;	// main switch: --if-depth
     int		m_inlineMult;	// main switch: --inline-mult
+    int		m_outputJobs;	// main switch: --output-jobs
     int		m_outputSplit;	// main switch: --output-split
     int		m_outputSplitCFuncs;// main switch: --output-split-cfuncs
     int		m_outputSplitCTrace;// main switch: --output-split-ctrace
     int		m_pinsBv;	// main switch: --pins-bv
+    int		m_tableCacheBytes;// main switch: --table-cache-bytes
+    int		m_tableMaxBytes;// main switch: --table-max-bytes
     int		m_traceDepth;	// main switch: --trace-depth
     int		m_traceMaxArray;// main switch: --trace-max-array
     int		m_traceMaxWidth;// main switch: --trace-max-width
     int		m_unrollCount;	// main switch: --unroll-count
     int		m_unrollStmts;	// main switch: --unroll-stmts
+    int		m_wideTemplateWords;// main switch: --wide-template-words
+    int		m_wideVectorWords;// main switch: --wide-vector-words
 
     int		m_compLimitBlocks;	// compiler selection options
     int		m_compLimitParens;	// compiler selection options
@@ -131,6 +141,9 @@ class V3Options {
     string	m_modPrefix;	// main switch: --mod-prefix
     string	m_pipeFilter;	// main switch: --pipe-filter
     string	m_prefix;	// main switch: --prefix
+    string	m_profFeedbackGen;	// main switch: --prof-feedback-gen
+    string	m_profFeedbackUse;	// main switch: --prof-feedback-use
+    string	m_preprocCache;	// main switch: --preproc-cache
     string	m_topModule;	// main switch: --top-module
     string	m_unusedRegexp;	// main switch: --unused-regexp
     string	m_xAssign;	// main switch: --x-assign
@@ -145,17 +158,21 @@ class V3Options {
     bool	m_oCase;	// main switch: -Oe: case tree conversion
     bool	m_oCombine;	// main switch: -Ob: common icode packing
     bool	m_oConst;	// main switch: -Oc: constant folding
+    bool	m_oCse;	// main switch: -Ov: common subexpression elimination
     bool	m_oDedupe;	// main switch: -Od: logic deduplication
     bool	m_oAssemble;	// main switch: -Om: assign assemble
     bool	m_oExpand;	// main switch: -Ox: expansion of C macros
     bool	m_oFlopGater;	// main switch: -Of: flop gater detection
     bool	m_oGate;	// main switch: -Og: gate wire elimination
+    bool	m_oHotCold;	// main switch: -Oh: hot/cold member layout
     bool	m_oLife;	// main switch: -Ol: variable lifetime
     bool	m_oLifePost;	// main switch: -Ot: delayed assignment elimination
     bool	m_oLocalize;	// main switch: -Oz: convert temps to local variables
+    bool	m_oOrderLoop;	// main switch: -Oq: settle comb loops locally, not by whole model
     bool	m_oInline;	// main switch: -Oi: module inlining
     bool	m_oReorder;	// main switch: -Or: reorder assignments in blocks
     bool	m_oSplit;	// main switch: -Os: always assignment splitting
+    bool	m_oSplitVar;	// main switch: -Ow: split variables into separately assigned bit ranges
     bool	m_oSubst;	// main switch: -Ou: substitute expression temp values
     bool	m_oSubstConst;	// main switch: -Ok: final constant substitution
     bool	m_oTable;	// main switch: -Oa: lookup table creation
@@ -212,13 +229,16 @@ class V3Options {
     bool systemC() const { return m_systemC; }
     bool usingSystemCLibs() const { return !lintOnly() && systemC(); }
     bool savable() const { return m_savable; }
+    bool shareInstances() const { return m_shareInstances; }
     bool skipIdentical() const { return m_skipIdentical; }
     bool stats() const { return m_stats; }
+    bool statsTrace() const { return m_statsTrace; }
     bool statsVars() const { return m_statsVars; }
     bool assertOn() const { return m_assert; }  // assertOn as __FILE__ may be defined
     bool autoflush() const { return m_autoflush; }
     bool bboxSys() const { return m_bboxSys; }
     bool bboxUnsup() const { return m_bboxUnsup; }
+    bool bitParallel() const { return m_bitParallel; }
     bool cdc() const { return m_cdc; }
     bool coverage() const { return m_coverageLine || m_coverageToggle || m_coverageUser; }
     bool coverageLine() const { return m_coverageLine; }
@@ -227,6 +247,7 @@ class V3Options {
     bool coverageUser() const { return m_coverageUser; }
     bool debugCheck() const { return m_debugCheck; }
     bool decoration() const { return m_decoration; }
+    bool domainGate() const { return m_domainGate; }
     bool exe() const { return m_exe; }
     bool trace() const { return m_trace; }
     bool traceDups() const { return m_traceDups; }
@@ -250,19 +271,25 @@ class V3Options {
     bool xInitialEdge() const { return m_xInitialEdge; }
     bool xmlOnly() const { return m_xmlOnly; }
 
+    int	   batch() const { return m_batch; }
     int	   convergeLimit() const { return m_convergeLimit; }
     int    dumpTree() const { return m_dumpTree; }
     int	   ifDepth() const { return m_ifDepth; }
     int	   inlineMult() const { return m_inlineMult; }
+    int	   outputJobs() const { return m_outputJobs; }
     int	   outputSplit() const { return m_outputSplit; }
     int	   outputSplitCFuncs() const { return m_outputSplitCFuncs; }
     int	   outputSplitCTrace() const { return m_outputSplitCTrace; }
     int	   pinsBv() const { return m_pinsBv; }
+    int	   tableCacheBytes() const { return m_tableCacheBytes; }
+    int	   tableMaxBytes() const { return m_tableMaxBytes; }
     int	   traceDepth() const { return m_traceDepth; }
     int	   traceMaxArray() const { return m_traceMaxArray; }
     int	   traceMaxWidth() const { return m_traceMaxWidth; }
     int	   unrollCount() const { return m_unrollCount; }
     int	   unrollStmts() const { return m_unrollStmts; }
+    int	   wideTemplateWords() const { return m_wideTemplateWords; }
+    int	   wideVectorWords() const { return m_wideVectorWords; }
 
     int    compLimitBlocks() const { return m_compLimitBlocks; }
     int    compLimitParens() const { return m_compLimitParens; }
@@ -273,6 +300,9 @@ class V3Options {
     string modPrefix() const { return m_modPrefix; }
     string pipeFilter() const { return m_pipeFilter; }
     string prefix() const { return m_prefix; }
+    string profFeedbackGen() const { return m_profFeedbackGen; }
+    string profFeedbackUse() const { return m_profFeedbackUse; }
+    string preprocCache() const { return m_preprocCache; }
     string topModule() const { return m_topModule; }
     string unusedRegexp() const { return m_unusedRegexp; }
     string xAssign() const { return m_xAssign; }
@@ -299,18 +329,22 @@ class V3Options {
     bool oCase() const { return m_oCase; }
     bool oCombine() const { return m_oCombine; }
     bool oConst() const { return m_oConst; }
+    bool oCse() const { return m_oCse; }
     bool oDedupe() const { return m_oDedupe; }
     bool oAssemble() const { return m_oAssemble; }
     bool oExpand() const { return m_oExpand; }
     bool oFlopGater() const { return m_oFlopGater; }
     bool oGate() const { return m_oGate; }
     bool oDup() const { return oLife(); }
+    bool oHotCold() const { return m_oHotCold; }
     bool oLife() const { return m_oLife; }
     bool oLifePost() const { return m_oLifePost; }
     bool oLocalize() const { return m_oLocalize; }
+    bool oOrderLoop() const { return m_oOrderLoop; }
     bool oInline() const { return m_oInline; }
     bool oReorder() const { return m_oReorder; }
     bool oSplit() const { return m_oSplit; }
+    bool oSplitVar() const { return m_oSplitVar; }
     bool oSubst() const { return m_oSubst; }
     bool oSubstConst() const { return m_oSubstConst; }
     bool oTable() const { return m_oTable; }
@@ -322,6 +356,7 @@ class V3Options {
     static string version();
     static string argString(int argc, char** argv);	///< Return list of arguments as simple string
     string allArgsString();	///< Return all passed arguments as simple string
+    string filePathString();	///< Return all settings affecting filePath as simple string
     void bin(const string& flag) { m_bin = flag; }
     void parseOpts(FileLine* fl, int argc, char** argv);
     void parseOptsList (FileLine* fl, const string& optdir, int argc, char** argv);
@@ -66,6 +66,12 @@
 //
 //   Rank the graph starting at INPUTS (see V3Graph)
 //
+//   For each loop (strongly connected component) of only comb logic
+//	Make a LoopBegin vertex with an UNTILSTABLE of the cut signals
+//	Move the loop's logic under the UNTILSTABLE, ordered by rank
+//	Don't mark the cut signals circular; the loop settles itself
+//	    rather than making the whole model evaluate again
+//
 //   Visit the graph's logic vertices in ranked order
 //	For all logic vertices with all inputs already ordered
 //	   Make ordered block for this module
@@ -73,6 +79,8 @@
 //		Move logic to ordered activation
 //	When we have no more choices, we move to the next module
 //	and make a new block.  Add that new activation block to the list of calls to make.
+//	A LoopBegin is moved as a whole, as a WHILE in its own function that
+//	    repeats the loop's logic until the cut signals stop changing.
 //
 //*************************************************************************
 
@@ -482,7 +490,7 @@ private:
     // STATE... for inside process
     OrderLoopId			m_loopIdMax;	// Maximum BeginLoop id number assigned
     vector<OrderLoopEndVertex*> m_pmlLoopEndps;	// processInsLoop: End vertex for each color
-    vector<OrderLoopBeginVertex*> m_pomLoopMoveps;// processMoveLoop: Loops next nodes are under
+    vector<OrderLoopBeginVertex*> m_pomLoopMoveps;// processLoops: Begin vertex of each loop, by loopId
 
     AstCFunc*			m_pomNewFuncp;	// Current function being created
     int				m_pomNewStmts;	// Statements in function being created
@@ -496,6 +504,8 @@ protected:
 private:
     // STATS
     V3Double0		m_statCut[OrderVEdgeType::_ENUM_END];	// Count of each edge type cut
+    V3Double0		m_statLoops;	// Loops settled locally
+    V3Double0		m_statCircularClocks;	// Clocks needing another eval loop
 
     // TYPES
     enum VarUsage { VU_NONE=0, VU_CON=1, VU_GEN=2 };
@@ -531,6 +541,16 @@ private:
 	    }
 	    nodep->user1p(m_modp);
 	    nodep->iterateChildren(*this);
+	    if (m_inClocked && !m_inPre && !m_inPost) {
+		// A gated domain tests its gate with each statement, so the gate
+		// must see the same pre-update values as the statement's own reads
+		for (AstNodeSenItem* senp = m_activep->sensesp()->sensesp();
+		     senp; senp=senp->nextp()->castNodeSenItem()) {
+		    if (AstSenGate* gatep = senp->castSenGate()) {
+			gatep->rhsp()->iterateAndNext(*this);
+		    }
+		}
+	    }
 	    m_logicVxp = NULL;
 	}
     }
@@ -577,6 +597,8 @@ private:
     void processSensitive();
     void processDomains();
     void processDomainsIterate(OrderEitherVertex* vertexp);
+    void processLoops();
+    AstVarScope* processLoopNewVarSc(AstScope* scopep, AstVar* varp);
     void processEdgeReport();
 
     void processMove();
@@ -588,6 +610,7 @@ private:
     void processMoveReadyOne(OrderMoveVertex* vertexp);
     void processMoveDoneOne(OrderMoveVertex* vertexp);
     void processMoveOne(OrderMoveVertex* vertexp, OrderMoveDomScope* domScopep, int level);
+    void processMoveLoop(OrderLoopBeginVertex* beginp);
 
     string cfuncName(AstNodeModule* modp, AstSenTree* domainp, AstScope* scopep, AstNode* forWhatp) {
 	modp->user3Inc();
@@ -967,6 +990,12 @@ private:
 	    m_inSenTree = false;
 	}
     }
+    virtual void visit(AstSenGate* nodep) {
+	// Only the gated clock triggers the domain.  The enable is read with
+	// each statement (see iterateNewStmt), so it must not become a clock;
+	// a registered enable would be circular and cost an extra eval loop.
+	nodep->sensesp()->iterateAndNext(*this);
+    }
     virtual void visit(AstAlways* nodep) {
 	iterateNewStmt(nodep);
     }
@@ -1088,6 +1117,7 @@ public:
 	m_logicVxp = NULL;
 	m_pomNewFuncp = NULL;
 	m_pomNewStmts = 0;
+	m_loopIdMax = LOOPID_FIRST;
 	if (debug()) m_graph.debug(5); // 3 is default if global debug; we want acyc debugging
     }
     virtual ~OrderVisitor() {
@@ -1097,6 +1127,8 @@ public:
 		V3Stats::addStat(string("Order, cut, ")+OrderVEdgeType(type).ascii(), count);
 	    }
 	}
+	V3Stats::addStat("Optimizations, Order loops settled locally", m_statLoops);
+	V3Stats::addStat("Order, circular clocks", m_statCircularClocks);
 	// Destruction
 	for (deque<OrderUser*>::iterator it=m_orderUserps.begin(); it!=m_orderUserps.end(); ++it) {
 	    delete *it;
@@ -1207,10 +1239,12 @@ void OrderVisitor::processCircular() {
 		if (!v3Global.opt.orderClockDly()) {
 		    UINFO(5,"Circular Clock, no-order-clock-delay "<<vvertexp<<endl);
 		    nodeMarkCircular(vvertexp, NULL);
+		    ++m_statCircularClocks;
 		}
 		else if (vvertexp->isDelayed()) {
 		    UINFO(5,"Circular Clock, delayed "<<vvertexp<<endl);
 		    nodeMarkCircular(vvertexp, NULL);
+		    ++m_statCircularClocks;
 		}
 		else {
 		    UINFO(5,"Circular Clock, not delayed "<<vvertexp<<endl);
@@ -1357,6 +1391,79 @@ void OrderVisitor::processDomainsIterate(OrderEitherVertex* vertexp) {
     }
 }
 
+//######################################################################
+// Loop settling
+
+void OrderVisitor::processLoops() {
+    // The acyclic colors still mark each strongly connected component, see reportLoopVars.
+    // A loop can settle locally if it's all comb logic, and has no clocks nor public signals.
+    typedef std::map<uint32_t,bool> ColorOkMap;
+    ColorOkMap colorOk;
+    for (V3GraphVertex* itp = m_graph.verticesBeginp(); itp; itp=itp->verticesNextp()) {
+	if (!itp->color()) continue;
+	bool& okr = colorOk.insert(make_pair(itp->color(), true)).first->second;
+	if (OrderLogicVertex* lvertexp = dynamic_cast<OrderLogicVertex*>(itp)) {
+	    if (lvertexp->domainp() != m_comboDomainp
+		|| lvertexp->nodep()->castSenTree()) okr = false;
+	} else if (OrderVarStdVertex* vvertexp = dynamic_cast<OrderVarStdVertex*>(itp)) {
+	    AstVar* varp = vvertexp->varScp()->varp();
+	    if (vvertexp->isClock() || varp->isSigPublic()
+		|| varp->isDouble() || varp->isString()
+		|| varp->dtypep()->skipRefp()->castUnpackArrayDType()) okr = false;
+	} else {
+	    okr = false;
+	}
+    }
+    // Move each loop's logic under its own UNTILSTABLE, in rank order
+    typedef std::map<uint32_t,OrderLoopBeginVertex*> ColorBeginMap;
+    ColorBeginMap colorBegins;
+    for (V3GraphVertex* itp = m_graph.verticesBeginp(); itp; itp=itp->verticesNextp()) {
+	if (!itp->color() || !colorOk[itp->color()]) continue;
+	if (OrderLogicVertex* lvertexp = dynamic_cast<OrderLogicVertex*>(itp)) {
+	    OrderLoopBeginVertex*& beginpr = colorBegins[itp->color()];
+	    if (!beginpr) {
+		AstUntilStable* untilp = new AstUntilStable(lvertexp->nodep()->fileline(), NULL, NULL);
+		beginpr = new OrderLoopBeginVertex(&m_graph, lvertexp->scopep(), m_comboDomainp, untilp,
+						   m_loopIdMax, itp->color());
+		beginpr->inLoop(m_loopIdMax);
+		m_pomLoopMoveps.push_back(beginpr);
+		m_loopIdMax = (OrderLoopId)(m_loopIdMax+1);
+		++m_statLoops;
+		UINFO(4,"    Loop "<<beginpr<<endl);
+	    }
+	    lvertexp->inLoop(beginpr->loopId());
+	    beginpr->untilp()->addBodysp(lvertexp->nodep()->unlinkFrBack());
+	}
+    }
+    // The signals read before they're written must be stable to leave the loop
+    for (V3GraphVertex* itp = m_graph.verticesBeginp(); itp; itp=itp->verticesNextp()) {
+	if (!itp->color() || !colorOk[itp->color()]) continue;
+	if (OrderVarStdVertex* vvertexp = dynamic_cast<OrderVarStdVertex*>(itp)) {
+	    OrderLoopBeginVertex* beginp = colorBegins[itp->color()];
+	    if (!beginp) continue;
+	    AstVarScope* vscp = vvertexp->varScp();
+	    bool cut = false;
+	    for (V3GraphEdge* edgep = vvertexp->outBeginp(); edgep; edgep=edgep->outNextp()) {
+		if (edgep->weight()==0) cut = true;
+	    }
+	    for (V3GraphEdge* edgep = vvertexp->inBeginp(); edgep; edgep=edgep->inNextp()) {
+		if (edgep->weight()==0) cut = true;
+	    }
+	    if (cut) {
+		beginp->untilp()->addStablesp(new AstVarRef(vscp->fileline(), vscp, false));
+	    }
+	    vscp->circular(false);
+	}
+    }
+}
+
+AstVarScope* OrderVisitor::processLoopNewVarSc(AstScope* scopep, AstVar* varp) {
+    scopep->modp()->addStmtp(varp);
+    AstVarScope* vscp = new AstVarScope(varp->fileline(), scopep, varp);
+    scopep->addVarp(vscp);
+    return vscp;
+}
+
 //######################################################################
 // Move graph construction
 
@@ -1412,12 +1519,23 @@ void OrderVisitor::processMoveBuildGraph() {
     // For each logic node, make a graph node
     for (V3GraphVertex* itp = m_graph.verticesBeginp(); itp; itp=itp->verticesNextp()) {
 	if (OrderLogicVertex* lvertexp = dynamic_cast<OrderLogicVertex*>(itp)) {
+	    if (lvertexp->inLoop() >= LOOPID_FIRST
+		&& !dynamic_cast<OrderLoopBeginVertex*>(lvertexp)) continue;  // Moves with its loop
 	    OrderMoveVertex* moveVxp = new OrderMoveVertex(&m_pomGraph, lvertexp);
 	    moveVxp->m_pomWaitingE.pushBack(m_pomWaiting, moveVxp);
 	    // Cross link so we can find it later
 	    lvertexp->moveVxp(moveVxp);
 	}
     }
+    // Logic under a loop is a single graph node, so the loop is ordered as a whole
+    for (V3GraphVertex* itp = m_graph.verticesBeginp(); itp; itp=itp->verticesNextp()) {
+	if (OrderLogicVertex* lvertexp = dynamic_cast<OrderLogicVertex*>(itp)) {
+	    if (lvertexp->inLoop() >= LOOPID_FIRST
+		&& !dynamic_cast<OrderLoopBeginVertex*>(lvertexp)) {
+		lvertexp->moveVxp(m_pomLoopMoveps[lvertexp->inLoop() - LOOPID_FIRST]->moveVxp());
+	    }
+	}
+    }
     // Build edges between logic vertices
     for (V3GraphVertex* itp = m_graph.verticesBeginp(); itp; itp=itp->verticesNextp()) {
 	if (OrderLogicVertex* lvertexp = dynamic_cast<OrderLogicVertex*>(itp)) {
@@ -1436,7 +1554,9 @@ void OrderVisitor::processMoveBuildGraphIterate (OrderMoveVertex* moveVxp, V3Gra
 	    if (OrderLogicVertex* toLVertexp = dynamic_cast<OrderLogicVertex*>(edgep->top())) {
 		// Path from vertexp to a logic vertex; new edge
 		// Note we use the last edge's weight, not some function of multiple edges
-		new OrderEdge(&m_pomGraph, moveVxp, toLVertexp->moveVxp(), weight);
+		if (toLVertexp->moveVxp() != moveVxp) {  // Else inside same loop
+		    new OrderEdge(&m_pomGraph, moveVxp, toLVertexp->moveVxp(), weight);
+		}
 	    }
 	    else { // Keep hunting forward for a logic node
 		processMoveBuildGraphIterate(moveVxp, edgep->top(), weight);
@@ -1564,15 +1684,13 @@ void OrderVisitor::processMoveOne(OrderMoveVertex* vertexp, OrderMoveDomScope* d
     AstSenTree* domainp = lvertexp->domainp();
     AstNode* nodep = lvertexp->nodep();
     AstNodeModule* modp = scopep->user1p()->castNodeModule();  UASSERT(modp,"NULL"); // Stashed by visitor func
-    if (nodep->castUntilStable()) {
-	nodep->v3fatalSrc("Not implemented");
-    }
-    else if (nodep->castSenTree()) {
+    if (nodep->castSenTree()) {
 	// Just ignore sensitivities, we'll deal with them when we move statements that need them
     }
-    else {  // Normal logic
+    else {  // Normal logic, or a loop of it
 	// Make or borrow a CFunc to contain the new statements
-	if (v3Global.opt.profileCFuncs()
+	if (nodep->castUntilStable()
+	    || v3Global.opt.profileCFuncs()
 	    || (v3Global.opt.outputSplitCFuncs()
 		&& v3Global.opt.outputSplitCFuncs() < m_pomNewStmts)) {
 	    // Put every statement into a unique function to ease profiling or reduce function size
@@ -1596,23 +1714,73 @@ void OrderVisitor::processMoveOne(OrderMoveVertex* vertexp, OrderMoveDomScope* d
 	    UINFO(6,"      New "<<m_pomNewFuncp<<endl);
 	}
 
-	// Move the logic to the function we're creating
-	nodep->unlinkFrBack();
-	if (domainp == m_deleteDomainp) {
-	    UINFO(4," Ordering deleting pre-settled "<<nodep<<endl);
-	    pushDeletep(nodep); VL_DANGLING(nodep);
+	if (OrderLoopBeginVertex* beginp = dynamic_cast<OrderLoopBeginVertex*>(lvertexp)) {
+	    // Loop gets a function to itself
+	    processMoveLoop(beginp);
+	    m_pomNewFuncp = NULL;
 	} else {
-	    m_pomNewFuncp->addStmtsp(nodep);
-	    if (v3Global.opt.outputSplitCFuncs()) {
-		// Add in the number of nodes we're adding
-		EmitCBaseCounterVisitor visitor(nodep);
-		m_pomNewStmts += visitor.count();
+	    // Move the logic to the function we're creating
+	    nodep->unlinkFrBack();
+	    if (domainp == m_deleteDomainp) {
+		UINFO(4," Ordering deleting pre-settled "<<nodep<<endl);
+		pushDeletep(nodep); VL_DANGLING(nodep);
+	    } else {
+		m_pomNewFuncp->addStmtsp(nodep);
+		if (v3Global.opt.outputSplitCFuncs()) {
+		    // Add in the estimated cost of the nodes we're adding
+		    EmitCBaseCostVisitor visitor(nodep);
+		    m_pomNewStmts += visitor.count();
+		}
 	    }
 	}
     }
     processMoveDoneOne (vertexp);
 }
 
+void OrderVisitor::processMoveLoop(OrderLoopBeginVertex* beginp) {
+    // Repeat the loop's logic until the signals it reads before writing are stable
+    //	 chg = 1; iter = 0;
+    //	 while (chg) { if (iter > limit) fatal; iter++; prev = sig; LOGIC; chg = (sig != prev); }
+    AstUntilStable* untilp = beginp->untilp();
+    AstScope* scopep = beginp->scopep();
+    FileLine* fl = untilp->fileline();
+    string prefix = "__Vloop"+cvtToStr(beginp->loopId() - LOOPID_FIRST);
+    AstVarScope* chgVscp = processLoopNewVarSc(scopep, new AstVar(fl, AstVarType::BLOCKTEMP, prefix+"chg",
+								  VFlagBitPacked(), 1));
+    AstVarScope* iterVscp = processLoopNewVarSc(scopep, new AstVar(fl, AstVarType::BLOCKTEMP, prefix+"iter",
+								   VFlagBitPacked(), 32));
+    AstNode* bodysp = new AstIf(fl, new AstGt(fl, new AstVarRef(fl, iterVscp, false),
+					      new AstConst(fl, V3Number(fl, 32, v3Global.opt.convergeLimit()))),
+				new AstCStmt(fl, "vl_fatal(__FILE__,__LINE__,__FILE__,\"Verilated model didn't converge\");\n"),
+				NULL);
+    bodysp->addNext(new AstAssign(fl, new AstVarRef(fl, iterVscp, true),
+				  new AstAdd(fl, new AstVarRef(fl, iterVscp, false),
+					     new AstConst(fl, V3Number(fl, 32, 1)))));
+    AstNode* chgp = NULL;
+    int prevnum = 0;
+    for (AstNode* nextp = untilp->stablesp(); nextp; nextp = nextp->nextp()) {
+	AstVarScope* vscp = nextp->castVarRef()->varScopep();
+	AstVarScope* prevVscp = processLoopNewVarSc(scopep, new AstVar(fl, AstVarType::BLOCKTEMP,
+								       prefix+"prev"+cvtToStr(prevnum++)
+								       +"__"+vscp->varp()->shortName(),
+								       vscp->varp()->dtypep()));
+	bodysp->addNext(new AstAssign(fl, new AstVarRef(fl, prevVscp, true),
+				      new AstVarRef(fl, vscp, false)));
+	AstNode* neqp = new AstNeq(fl, new AstVarRef(fl, vscp, false),
+				   new AstVarRef(fl, prevVscp, false));
+	chgp = chgp ? new AstLogOr(fl, chgp, neqp) : neqp;
+    }
+    if (!chgp) chgp = new AstConst(fl, V3Number(fl, 1, 0));
+    if (untilp->bodysp()) bodysp->addNext(untilp->bodysp()->unlinkFrBackWithNext());
+    bodysp->addNext(new AstAssign(fl, new AstVarRef(fl, chgVscp, true), chgp));
+    m_pomNewFuncp->addStmtsp(new AstAssign(fl, new AstVarRef(fl, chgVscp, true),
+					   new AstConst(fl, V3Number(fl, 1, 1))));
+    m_pomNewFuncp->addStmtsp(new AstAssign(fl, new AstVarRef(fl, iterVscp, true),
+					   new AstConst(fl, V3Number(fl, 32, 0))));
+    m_pomNewFuncp->addStmtsp(new AstWhile(fl, new AstVarRef(fl, chgVscp, false), bodysp));
+    pushDeletep(untilp); VL_DANGLING(untilp);
+}
+
 inline void OrderMoveDomScope::ready(OrderVisitor* ovp) {	// Check the domScope is on ready list, add if not
     if (!m_onReadyList) {
 	m_onReadyList = true;
@@ -1644,38 +1812,64 @@ void OrderVisitor::process() {
     // original graph. However the new graph will be acyclic (the removed
     // edges are actually still there, just with weight 0).
     UINFO(2,"  Acyclic & Order...\n");
-    m_graph.acyclic(&V3GraphEdge::followAlwaysTrue);
+    {
+	V3StatsTraceScope trace ("order, acyclic");
+	m_graph.acyclic(&V3GraphEdge::followAlwaysTrue);
+    }
     m_graph.dumpDotFilePrefixed("orderg_acyc");
 
     // Assign ranks so we know what to follow
     // Then, sort vertices and edges by that ordering
-    m_graph.order();
+    {
+	V3StatsTraceScope trace ("order, rank");
+	m_graph.order();
+    }
     m_graph.dumpDotFilePrefixed("orderg_order");
 
     // This finds everything that can be traced from an input (which by
     // definition are the source clocks). After this any vertex which was
     // traced has isFromInput() true.
-    UINFO(2,"  Process Clocks...\n");
-    processInputs();  // must be before processCircular
+    {
+	V3StatsTraceScope trace ("order, inputs");
+	UINFO(2,"  Process Clocks...\n");
+	processInputs();  // must be before processCircular
 
-    UINFO(2,"  Process Circulars...\n");
-    processCircular();  // must be before processDomains
+	UINFO(2,"  Process Circulars...\n");
+	processCircular();  // must be before processDomains
+    }
 
     // Assign logic verticesto new domains
     UINFO(2,"  Domains...\n");
-    processDomains();
+    {
+	V3StatsTraceScope trace ("order, domains");
+	processDomains();
+    }
     m_graph.dumpDotFilePrefixed("orderg_domain");
 
+    // Settle comb loops locally, after domains so we know they're comb
+    if (v3Global.opt.oOrderLoop()) {
+	UINFO(2,"  Loops...\n");
+	V3StatsTraceScope trace ("order, loops");
+	processLoops();
+	m_graph.dumpDotFilePrefixed("orderg_loops");
+    }
+
     if (debug() && v3Global.opt.dumpTree()) processEdgeReport();
 
     UINFO(2,"  Construct Move Graph...\n");
-    processMoveBuildGraph();
-    if (debug()>=4) m_pomGraph.dumpDotFilePrefixed("ordermv_start");  // Different prefix (ordermv) as it's not the same graph
-    m_pomGraph.removeRedundantEdges(&V3GraphEdge::followAlwaysTrue);
+    {
+	V3StatsTraceScope trace ("order, move graph");
+	processMoveBuildGraph();
+	if (debug()>=4) m_pomGraph.dumpDotFilePrefixed("ordermv_start");  // Different prefix (ordermv) as it's not the same graph
+	m_pomGraph.removeRedundantEdges(&V3GraphEdge::followAlwaysTrue);
+    }
     m_pomGraph.dumpDotFilePrefixed("ordermv_simpl");
 
     UINFO(2,"  Move...\n");
-    processMove();
+    {
+	V3StatsTraceScope trace ("order, move");
+	processMove();
+    }
 
     // Any SC inputs feeding a combo domain must be marked, so we can make them sc_sensitive
     UINFO(2,"  Sensitive...\n");
@@ -36,6 +36,7 @@
 #include "V3PreLex.h"
 #include "V3PreProc.h"
 #include "V3PreShell.h"
+#include "V3String.h"
 
 //======================================================================
 // Build in LEX script
@@ -115,6 +116,8 @@ public:
 
     // Defines list
     DefinesMap	m_defines;	///< Map of defines
+    typedef map<pair<string,int>,FileLine*> RestoredFilelines;
+    RestoredFilelines m_restoredFilelines;	///< Filelines owned for definesRestore
 
     // STATE
     V3PreProc*	m_preprocp;	///< Object we're holding data for
@@ -221,6 +224,7 @@ private:
 public:
     // METHODS, called from upper level shell
     void openFile(FileLine* fl, V3InFilter* filterp, const string& filename);
+    void openFile(FileLine* fl, const string& filename, StrList& wholefile);
     bool isEof() const { return m_lexp->curStreamp()->m_eof; }
     string getline();
     void insertUnreadback(const string& text) { m_lineCmt += text; }
@@ -235,6 +239,10 @@ public:
     virtual void define (FileLine* fl, const string& name, const string& value,
 			 const string& params, bool cmdline);
     virtual string removeDefines(const string& text);	// Remove defines in a text string
+    virtual string definesString();
+    virtual void definesRestore(const string& encoded);
+    FileLine* definesFileline(const DefinesMap& oldDefines, const string& name,
+			      const string& filename, int lineno);
 
     // CONSTRUCTORS
     V3PreProcImp() : V3PreProc() {
@@ -268,6 +276,10 @@ public:
     }
     ~V3PreProcImp() {
 	if (m_lexp) { delete m_lexp; m_lexp = NULL; }
+	for (RestoredFilelines::iterator it = m_restoredFilelines.begin();
+	     it != m_restoredFilelines.end(); ++it) {
+	    delete it->second;
+	}
     }
 };
 
@@ -348,6 +360,52 @@ string V3PreProcImp::removeDefines(const string& sym) {
     return rtnsym;  // NA
 }
 
+string V3PreProcImp::definesString() {
+    string out;
+    for (DefinesMap::iterator it = m_defines.begin(); it != m_defines.end(); ++it) {
+	VString::encodeField(out, it->first);
+	VString::encodeField(out, it->second.value());
+	VString::encodeField(out, it->second.params());
+	VString::encodeField(out, it->second.cmdline()?"1":"0");
+	VString::encodeField(out, it->second.fileline()->filename());
+	VString::encodeField(out, cvtToStr(it->second.fileline()->lineno()));
+    }
+    return out;
+}
+void V3PreProcImp::definesRestore(const string& encoded) {
+    DefinesMap oldDefines;
+    oldDefines.swap(m_defines);
+    size_t pos = 0;
+    while (pos < encoded.length()) {
+	string name, value, params, cmdline, filename, lineno;
+	if (!VString::decodeField(encoded, pos, name)
+	    || !VString::decodeField(encoded, pos, value)
+	    || !VString::decodeField(encoded, pos, params)
+	    || !VString::decodeField(encoded, pos, cmdline)
+	    || !VString::decodeField(encoded, pos, filename)
+	    || !VString::decodeField(encoded, pos, lineno)) {
+	    fatalSrc("Malformed defines from definesString");
+	}
+	m_defines.insert(make_pair(name, V3Define(definesFileline(oldDefines, name, filename,
+								  atoi(lineno.c_str())),
+						  value, params, cmdline == "1")));
+    }
+}
+FileLine* V3PreProcImp::definesFileline(const DefinesMap& oldDefines, const string& name,
+					const string& filename, int lineno) {
+    // Most defines are unchanged by a file, so reuse where they were declared
+    DefinesMap::const_iterator it = oldDefines.find(name);
+    if (it != oldDefines.end()
+	&& it->second.fileline()->filename() == filename
+	&& it->second.fileline()->lineno() == lineno) {
+	return it->second.fileline();
+    }
+    // Others are owned here, one per location
+    FileLine*& flr = m_restoredFilelines[make_pair(filename, lineno)];
+    if (!flr) flr = new FileLine(filename, lineno);
+    return flr;
+}
+
 //**********************************************************************
 // Comments
 
@@ -713,15 +771,19 @@ string V3PreProcImp::defineSubst(V3DefineRef* refp) {
 
 void V3PreProcImp::openFile(FileLine* fl, V3InFilter* filterp, const string& filename) {
     // Open a new file, possibly overriding the current one which is active.
-    V3File::addSrcDepend(filename);
-
     // Read a list<string> with the whole file.
     StrList wholefile;
     bool ok = filterp->readWholefile(filename, wholefile/*ref*/);
     if (!ok) {
+	V3File::addSrcDepend(filename);
 	error("File not found: "+filename+"\n");
 	return;
     }
+    openFile(fl, filename, wholefile);
+}
+
+void V3PreProcImp::openFile(FileLine* fl, const string& filename, StrList& wholefile) {
+    V3File::addSrcDepend(filename);
 
     if (!m_preprocp->isEof()) {  // IE not the first file.
 	// We allow the same include file twice, because occasionally it pops
@@ -57,6 +57,8 @@ public:
     // ACCESSORS
     // Insert given file into this point in input stream
     virtual void openFile(FileLine* fileline, V3InFilter* filterp, const string& filename)=0;
+    // Same, with the file's lines already read through the filter; consumes the lines
+    virtual void openFile(FileLine* fileline, const string& filename, list<string>& wholefile)=0;
     virtual string getline()=0;		// Return next line/lines. (Null if done.)
     virtual bool isEof() const =0;		// Return true on EOF.
     virtual void insertUnreadback(const string& text) = 0;
@@ -88,6 +90,9 @@ public:
 	define(fileline, name, value, "", true);
     }
     virtual string removeDefines(const string& text)=0;	// Remove defines in a text string
+    // For V3PreShell's cache of preprocessed files
+    virtual string definesString()=0;	// Return all defines, encoded for definesRestore
+    virtual void definesRestore(const string& encoded)=0;	// Replace all defines with definesString()'s
 
     // UTILITIES
     void error(const string& msg) { fileline()->v3error(msg); }	///< Report a error
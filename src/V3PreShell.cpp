@@ -27,6 +27,8 @@
 #include <algorithm>
 #include <list>
 #include <set>
+#include <vector>
+#include <fstream>
 
 #include "V3Global.h"
 #include "V3PreShell.h"
@@ -34,6 +36,111 @@
 #include "V3File.h"
 #include "V3Parse.h"
 #include "V3Os.h"
+#include "V3Stats.h"
+#include "V3String.h"
+
+//######################################################################
+// Cache of preprocessor output for --preproc-cache
+
+class V3PreShellCache {
+    // Each entry is keyed by a file's contents, plus the defines and
+    // options in effect when it is read.  An entry holds the preprocessed
+    // text, the defines in effect afterwards, and the contents hash of
+    // each file it `included, which must all still match to be reused.
+public:
+    typedef vector<pair<string,string> > DepList;	// Filename, contents hash
+
+private:
+    static string entryFilename(const string& key) {
+	// Entries hold their whole key, so a name collision only costs a miss
+	return v3Global.opt.preprocCache()+"/"+hash(key)+".vpc";
+    }
+    static string magic() { return "// Verilator preprocessor cache 2\n"; }
+
+public:
+    static string hash(const string& data) {
+	return VHashSha1(data).digestHex();
+    }
+    static string contents(const V3InFilter::StrList& lines) {
+	string out;
+	for (V3InFilter::StrList::const_iterator it=lines.begin(); it!=lines.end(); ++it) {
+	    out += *it;
+	}
+	return out;
+    }
+    static bool readContents(V3InFilter* filterp, const string& filename, string& contentsr) {
+	V3InFilter::StrList lines;
+	if (!filterp->readWholefile(filename, lines/*ref*/)) return false;
+	contentsr = contents(lines);
+	return true;
+    }
+    static string key(const string& filename, const string& contents, const string& defines) {
+	string out = magic();
+	VString::encodeField(out, V3Options::version());
+	VString::encodeField(out, filename);
+	VString::encodeField(out, hash(contents));
+	VString::encodeField(out, v3Global.opt.fileLanguage(filename).ascii());
+	VString::encodeField(out, v3Global.opt.filePathString());
+	VString::encodeField(out, v3Global.opt.pipeFilter());
+	VString::encodeField(out, defines);
+	return out;
+    }
+    static bool read(const string& key, V3InFilter* filterp,
+		     string& textr, string& definesr, DepList& depsr) {
+	string filename = entryFilename(key);
+	ifstream* ifp = V3File::new_ifstream_nodepend(filename);
+	if (ifp->fail()) { delete ifp; return false; }
+	string entry;
+	{
+	    char buf[65536];
+	    while (ifp->read(buf, sizeof(buf)) || ifp->gcount()) entry.append(buf, ifp->gcount());
+	}
+	delete ifp; VL_DANGLING(ifp);
+
+	size_t pos = 0;
+	string field;
+	if (!VString::decodeField(entry, pos, field) || field != key) return false;
+	if (!VString::decodeField(entry, pos, textr)) return false;
+	if (!VString::decodeField(entry, pos, definesr)) return false;
+	depsr.clear();
+	while (pos < entry.length()) {
+	    string depname, dephash;
+	    if (!VString::decodeField(entry, pos, depname)
+		|| !VString::decodeField(entry, pos, dephash)) return false;
+	    string depContents;
+	    if (!readContents(filterp, depname, depContents/*ref*/)) return false;
+	    if (hash(depContents) != dephash) {
+		UINFO(2,"    Cache stale from "<<depname<<endl);
+		return false;
+	    }
+	    depsr.push_back(make_pair(depname, dephash));
+	}
+	return true;
+    }
+    static void write(const string& key, const string& text, const string& defines,
+		      const DepList& deps) {
+	V3Os::createDir(v3Global.opt.preprocCache());
+	string entry;
+	VString::encodeField(entry, key);
+	VString::encodeField(entry, text);
+	VString::encodeField(entry, defines);
+	for (DepList::const_iterator it = deps.begin(); it != deps.end(); ++it) {
+	    VString::encodeField(entry, it->first);
+	    VString::encodeField(entry, it->second);
+	}
+	// Write then rename, so a concurrent run never reads a partial entry
+	string filename = entryFilename(key);
+	string tmpFilename = filename+".tmp"+cvtToStr(getpid());
+	ofstream* ofp = V3File::new_ofstream_nodepend(tmpFilename);
+	ofp->write(entry.data(), entry.length());
+	bool ok = !ofp->fail();
+	delete ofp; VL_DANGLING(ofp);
+	if (!ok || rename(tmpFilename.c_str(), filename.c_str())) {
+	    unlink(tmpFilename.c_str());
+	    UINFO(1,"    Cannot write preprocessor cache: "<<filename<<endl);
+	}
+    }
+};
 
 //######################################################################
 
@@ -44,6 +151,7 @@ protected:
     static V3PreShellImp s_preImp;
     static V3PreProc*	s_preprocp;
     static V3InFilter*	s_filterp;
+    static V3PreShellCache::DepList* s_cacheDepsp;	// Files read, when filling cache
 
     //---------------------------------------
     // METHODS
@@ -103,6 +211,9 @@ protected:
 
 	// Preprocess
 	s_filterp = filterp;
+	if (v3Global.opt.preprocCache()!="" && !v3Global.opt.preprocOnly()) {
+	    return preprocCached(fl, modname, parsep, errmsg);
+	}
 	bool ok = preprocOpen(fl, s_filterp, modname, "", errmsg);
 	if (!ok) return false;
 
@@ -113,6 +224,53 @@ protected:
 	return true;
     }
 
+    bool preprocCached(FileLine* fl, const string& modname, V3ParseImp* parsep,
+		       const string& errmsg) {
+	string filename = v3Global.opt.filePath(fl, s_preprocp->removeDefines(modname), "", errmsg);
+	if (filename=="") return false;  // Not found
+	// Read once; on a miss these same lines feed the preprocessor, so
+	// --pipe-filter runs only once per file
+	V3InFilter::StrList lines;
+	if (!s_filterp->readWholefile(filename, lines/*ref*/)) {
+	    return preprocOpen(fl, s_filterp, modname, "", errmsg);  // Let preprocessor report it
+	}
+	string key = V3PreShellCache::key(filename, V3PreShellCache::contents(lines),
+					  s_preprocp->definesString());
+
+	string text;
+	string defines;
+	V3PreShellCache::DepList deps;
+	if (V3PreShellCache::read(key, s_filterp, text/*ref*/, defines/*ref*/, deps/*ref*/)) {
+	    UINFO(2,"    Reading "<<filename<<" from preprocessor cache"<<endl);
+	    V3File::addSrcDepend(filename);
+	    for (V3PreShellCache::DepList::iterator it = deps.begin(); it != deps.end(); ++it) {
+		V3File::addSrcDepend(it->first);
+	    }
+	    s_preprocp->definesRestore(defines);
+	    V3Parse::ppPushText(parsep, text);
+	    if (v3Global.opt.stats()) V3Stats::addStatSum("Preprocess, Cache hits", 1);
+	    return true;
+	}
+
+	// Miss; preprocess as usual, collecting what's needed to make an entry
+	int msgsBefore = V3Error::errorCount() + V3Error::warnCount();
+	s_cacheDepsp = &deps;
+	UINFO(2,"    Reading "<<filename<<endl);
+	s_preprocp->openFile(fl, filename, lines);
+	while (!s_preprocp->isEof()) {
+	    string line = s_preprocp->getline();
+	    text += line;
+	    V3Parse::ppPushText(parsep, line);
+	}
+	s_cacheDepsp = NULL;
+	if (v3Global.opt.stats()) V3Stats::addStatSum("Preprocess, Cache misses", 1);
+	// Messages would be lost on a later hit, so only cache clean files
+	if (msgsBefore == V3Error::errorCount() + V3Error::warnCount()) {
+	    V3PreShellCache::write(key, text, s_preprocp->definesString(), deps);
+	}
+	return true;
+    }
+
     void preprocInclude (FileLine* fl, const string& modname) {
 	if (modname[0]=='/' || modname[0]=='\\') {
 	    fl->v3warn(INCABSPATH,"Suggest `include with absolute path be made relative, and use +include: "<<modname);
@@ -132,6 +290,15 @@ protected:
 	if (filename=="") return false;  // Not found
 
 	UINFO(2,"    Reading "<<filename<<endl);
+	if (s_cacheDepsp) {
+	    V3InFilter::StrList lines;
+	    if (filterp->readWholefile(filename, lines/*ref*/)) {
+		string contents = V3PreShellCache::contents(lines);
+		s_cacheDepsp->push_back(make_pair(filename, V3PreShellCache::hash(contents)));
+		s_preprocp->openFile(fl, filename, lines);
+		return true;
+	    }
+	}
 	s_preprocp->openFile(fl, filterp, filename);
 	return true;
     }
@@ -144,6 +311,7 @@ protected:
 V3PreShellImp V3PreShellImp::s_preImp;
 V3PreProc* V3PreShellImp::s_preprocp = NULL;
 V3InFilter* V3PreShellImp::s_filterp = NULL;
+V3PreShellCache::DepList* V3PreShellImp::s_cacheDepsp = NULL;
 
 //######################################################################
 // Perl class functions
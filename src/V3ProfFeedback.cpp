@@ -0,0 +1,291 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Profile feedback counting and use
+//
+// Code available from: http://www.veripool.org/verilator
+//
+//*************************************************************************
+//
+// Copyright 2003-2017 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3ProfFeedback's Transformations:
+//
+// With --prof-feedback-gen:
+//	Each non-slow function gets a call counter in the symbol table
+//	The symbol table's destructor writes the counts to the feedback file
+//
+// With --prof-feedback-use:
+//	Read the counts written by a --prof-feedback-gen model
+//	Each non-slow function never called in the profile
+//	    Mark slow, so it moves to the __Slow files
+//	Each IF whose body starts by calling a function only called from there
+//	    Callee count / caller count is how often the IF was true
+//	    If nearly always or nearly never, add VL_LIKELY/VL_UNLIKELY
+//	Each module's called functions
+//	    Move to the end of the module, most called first, so they emit together
+//
+// Functions are matched by module and function name, so the profiled model
+// must be Verilated from the same sources and options.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+#include <cstdio>
+#include <cstdarg>
+#include <unistd.h>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+
+#include "V3Global.h"
+#include "V3ProfFeedback.h"
+#include "V3EmitCBase.h"
+#include "V3File.h"
+#include "V3Stats.h"
+#include "V3Ast.h"
+
+//######################################################################
+
+#define PROF_MIN_CALLS	64	// Min caller count before trusting a branch ratio
+#define PROF_LIKELY_PCT	90	// Taken at least this percent to predict likely
+
+static vector<string> s_counterNames;	// Names of --prof-feedback-gen counters
+
+//######################################################################
+
+class ProfFeedbackBaseVisitor : public AstNVisitor {
+protected:
+    // STATE
+    AstNodeModule*	m_modp;		// Current module
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+    string funcKey(AstCFunc* funcp) const {
+	return m_modp->name()+"::"+funcp->name();
+    }
+    static bool isCountable(AstCFunc* funcp) {
+	// Called every evaluation, with the symbol table available to count in
+	return (!funcp->slow() && !funcp->dpiImport()
+		&& funcp->argTypes().find(EmitCBaseVisitor::symClassVar()) != string::npos);
+    }
+    virtual ~ProfFeedbackBaseVisitor() {}
+};
+
+//######################################################################
+// Add call counters
+
+class ProfFeedbackGenVisitor : public ProfFeedbackBaseVisitor {
+private:
+    // STATE
+    V3Double0	m_statCounters;	// Statistic tracking
+
+    // VISITORS
+    virtual void visit(AstNodeModule* nodep) {
+	m_modp = nodep;
+	nodep->iterateChildren(*this);
+	m_modp = NULL;
+    }
+    virtual void visit(AstCFunc* nodep) {
+	if (isCountable(nodep)) {
+	    string text = "++vlSymsp->__Vm_profCounts["+cvtToStr(s_counterNames.size())+"];\n";
+	    nodep->addInitsp(new AstCStmt(nodep->fileline(), text));
+	    s_counterNames.push_back(funcKey(nodep));
+	    ++m_statCounters;
+	}
+    }
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+public:
+    // CONSTRUCTORS
+    explicit ProfFeedbackGenVisitor(AstNetlist* nodep) {
+	m_modp = NULL;
+	s_counterNames.clear();
+	nodep->accept(*this);
+    }
+    virtual ~ProfFeedbackGenVisitor() {
+	V3Stats::addStat("Profile feedback, Counted functions", m_statCounters);
+    }
+};
+
+//######################################################################
+// Apply counts
+
+class ProfFeedbackUseVisitor : public ProfFeedbackBaseVisitor {
+private:
+    // NODE STATE
+    // Entire netlist:
+    //  AstCFunc::user1()	-> int.  Number of calls to the function
+    AstUser1InUse	m_inuser1;
+
+    // TYPES
+    typedef map<string,vluint64_t> CountMap;
+    struct CmpCountDesc {
+	const map<AstCFunc*,vluint64_t>& m_counts;
+	explicit CmpCountDesc(const map<AstCFunc*,vluint64_t>& counts) : m_counts(counts) {}
+	inline bool operator () (AstCFunc* lhsp, AstCFunc* rhsp) const {
+	    return m_counts.find(lhsp)->second > m_counts.find(rhsp)->second;
+	}
+    };
+
+    // STATE
+    CountMap	m_counts;	// Call count of each profiled function
+    bool	m_callCounting;	// Counting call sites, not applying
+    AstCFunc*	m_funcp;	// Current function
+    map<AstCFunc*,vluint64_t>	m_funcCounts;	// Counts of functions in current module
+    V3Double0	m_statCold;	// Statistic tracking
+    V3Double0	m_statLikely;	// Statistic tracking
+    V3Double0	m_statUnlikely;	// Statistic tracking
+    V3Double0	m_statMoved;	// Statistic tracking
+
+    // METHODS
+    void readCounts(const string& filename) {
+	ifstream* ifp = V3File::new_ifstream(filename);
+	if (ifp->fail()) {
+	    v3fatal("Can't read --prof-feedback-use file: "<<filename);
+	    return;
+	}
+	V3File::addSrcDepend(filename);
+	string line;
+	while (getline(*ifp, line)) {
+	    if (line.empty() || line[0]=='#') continue;
+	    istringstream is (line);
+	    string kwd, key;  vluint64_t count = 0;
+	    is>>kwd>>key>>count;
+	    if (kwd != "cfunc" || is.fail()) {
+		v3fatal("Malformed --prof-feedback-use file: "<<filename<<": "<<line);
+		break;
+	    }
+	    m_counts[key] += count;
+	}
+	ifp->close(); delete ifp; VL_DANGLING(ifp);
+    }
+    bool lookup(AstCFunc* funcp, vluint64_t& countr) const {
+	CountMap::const_iterator it = m_counts.find(funcKey(funcp));
+	if (it == m_counts.end()) return false;
+	countr = it->second;
+	return true;
+    }
+    void reorderFuncs() {
+	// Emit the profiled functions together, most called first
+	vector<AstCFunc*> funcps;
+	for (AstNode* stmtp = m_modp->stmtsp(); stmtp; stmtp = stmtp->nextp()) {
+	    if (AstCFunc* funcp = stmtp->castCFunc()) {
+		if (m_funcCounts.find(funcp) != m_funcCounts.end()) funcps.push_back(funcp);
+	    }
+	}
+	stable_sort(funcps.begin(), funcps.end(), CmpCountDesc(m_funcCounts));
+	for (vector<AstCFunc*>::iterator it = funcps.begin(); it != funcps.end(); ++it) {
+	    m_modp->addStmtp((*it)->unlinkFrBack());
+	    ++m_statMoved;
+	}
+    }
+
+    // VISITORS
+    virtual void visit(AstNodeModule* nodep) {
+	m_modp = nodep;
+	m_funcCounts.clear();
+	nodep->iterateChildren(*this);
+	if (!m_callCounting) reorderFuncs();
+	m_modp = NULL;
+    }
+    virtual void visit(AstCFunc* nodep) {
+	m_funcp = nodep;
+	if (!m_callCounting && isCountable(nodep)) {
+	    vluint64_t count = 0;
+	    if (lookup(nodep, count/*ref*/)) {
+		if (count) {
+		    m_funcCounts[nodep] = count;
+		} else if (!nodep->entryPoint() && !nodep->funcPublic() && !nodep->dpiExport()) {
+		    UINFO(4,"  Cold "<<nodep<<endl);
+		    nodep->slow(true);
+		    ++m_statCold;
+		}
+	    }
+	}
+	nodep->iterateChildren(*this);
+	m_funcp = NULL;
+    }
+    virtual void visit(AstCCall* nodep) {
+	if (m_callCounting) nodep->funcp()->user1Inc();
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstIf* nodep) {
+	if (!m_callCounting && m_funcp && nodep->branchPred() == AstBranchPred::BP_UNKNOWN) {
+	    AstCCall* callp = nodep->ifsp() ? nodep->ifsp()->castCCall() : NULL;
+	    vluint64_t callerCount = 0;
+	    vluint64_t calleeCount = 0;
+	    if (callp && callp->funcp()->user1() == 1
+		&& lookup(m_funcp, callerCount/*ref*/) && callerCount >= PROF_MIN_CALLS
+		&& lookup(callp->funcp(), calleeCount/*ref*/)) {
+		// The callee only runs when this IF is true, so its count is the taken count
+		if (calleeCount*100 >= callerCount*PROF_LIKELY_PCT) {
+		    UINFO(4,"  Likely "<<nodep<<endl);
+		    nodep->branchPred(AstBranchPred::BP_LIKELY);
+		    ++m_statLikely;
+		} else if (calleeCount*100 <= callerCount*(100-PROF_LIKELY_PCT)) {
+		    UINFO(4,"  Unlikely "<<nodep<<endl);
+		    nodep->branchPred(AstBranchPred::BP_UNLIKELY);
+		    ++m_statUnlikely;
+		}
+	    }
+	}
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstNodeMath* nodep) {}  // Accelerate
+    virtual void visit(AstVar* nodep) {}  // Accelerate
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+public:
+    // CONSTRUCTORS
+    explicit ProfFeedbackUseVisitor(AstNetlist* nodep) {
+	m_modp = NULL;
+	m_funcp = NULL;
+	readCounts(v3Global.opt.profFeedbackUse());
+	m_callCounting = true;
+	nodep->accept(*this);
+	m_callCounting = false;
+	nodep->accept(*this);
+    }
+    virtual ~ProfFeedbackUseVisitor() {
+	V3Stats::addStat("Optimizations, Profile feedback cold functions", m_statCold);
+	V3Stats::addStat("Optimizations, Profile feedback likely branches", m_statLikely);
+	V3Stats::addStat("Optimizations, Profile feedback unlikely branches", m_statUnlikely);
+	V3Stats::addStat("Optimizations, Profile feedback reordered functions", m_statMoved);
+    }
+};
+
+//######################################################################
+// ProfFeedback class functions
+
+const vector<string>& V3ProfFeedback::counterNames() {
+    return s_counterNames;
+}
+
+void V3ProfFeedback::profFeedbackAll(AstNetlist* nodep) {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    if (v3Global.opt.profFeedbackUse() != "") {
+	ProfFeedbackUseVisitor visitor (nodep);
+    }
+    if (v3Global.opt.profFeedbackGen() != "") {
+	ProfFeedbackGenVisitor visitor (nodep);
+    }
+    V3Global::dumpCheckGlobalTree("proffeedback", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
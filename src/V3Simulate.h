@@ -44,7 +44,10 @@
 #include "V3Task.h"
 
 #include <deque>
+#include <map>
+#include <set>
 #include <sstream>
+#include <vector>
 
 //============================================================================
 
@@ -971,4 +974,627 @@ public:
     }
 };
 
+//######################################################################
+// Compiled simulation
+//
+// SimulateProgram lowers the subtrees SimulateVisitor emulates into a flat
+// instruction list over preallocated V3Number slots, so a tree evaluated
+// many times (V3Table's input enumeration, loops in constant functions) is
+// walked once.  The compiler mirrors SimulateVisitor's dispatch, and refuses
+// anything where it couldn't give the identical result.  At run time,
+// anything SimulateVisitor would complain about (an unset variable, a
+// runaway loop) makes run() return false; callers then use SimulateVisitor,
+// which also produces the error message.
+
+class SimulateProgram : public AstNVisitor {
+private:
+    // TYPES
+    enum Opcode {
+	OP_END,		// Done
+	OP_UNIOP,	// m_dst = m_nodep op m_a
+	OP_BIOP,	// m_dst = m_a m_nodep m_b
+	OP_TRIOP,	// m_dst = m_nodep(m_a, m_b, m_c)
+	OP_COPY,	// m_dst = m_a, keeping m_dst's width
+	OP_COPYNUM,	// m_dst = m_a, including width
+	OP_LSBADD,	// m_dst = m_a + m_b, in m_a's width
+	OP_CHECK,	// Fail if variable m_a unset
+	OP_SETVAR,	// Variable m_dst = m_a
+	OP_ASSIGN,	// Variable m_dst and its output m_b = m_a
+	OP_ASSIGNDLY,	// Output m_b = m_a
+	OP_SELINTO,	// As OP_ASSIGN, of m_a into bits m_c of output m_b/variable m_dst
+	OP_SELINTODLY,	// As OP_ASSIGNDLY, of m_a into bits m_c of output m_b/variable m_dst
+	OP_JUMP,	// Go to m_a
+	OP_JUMPNZ,	// Go to m_b if m_a isNeqZero
+	OP_JUMPNNZ,	// Go to m_b unless m_a isNeqZero
+	OP_JUMPEQZ,	// Go to m_b if m_a isEqZero
+	OP_CASEEQ,	// m_dst = m_a == m_b, go to m_c if true
+	OP_LOOPINIT,	// Loop counter m_a = 0
+	OP_LOOPCHK	// Fail if loop counter m_a passes m_width
+    };
+    struct Instr {
+	Opcode		m_op;
+	int		m_dst, m_a, m_b, m_c;
+	int		m_width;
+	AstNode*	m_nodep;
+	Instr(Opcode op, int dst, int a, int b=0, int c=0, AstNode* nodep=NULL, int width=0)
+	    : m_op(op), m_dst(dst), m_a(a), m_b(b), m_c(c), m_width(width), m_nodep(nodep) {}
+    };
+    typedef map<AstNode*,int> SlotMap;
+    typedef vector<pair<int,AstConst*> > ParamInits;
+
+    // STATE
+    bool		m_scoped;	///< Running with AstVarScopes instead of AstVars
+    bool		m_params;	///< Doing parameter propagation
+    bool		m_failed;	///< Compile refused
+    vector<Instr>	m_instrs;	///< Program
+    vector<V3Number>	m_nums;		///< Value slots
+    vector<char>	m_set;		///< Variable slot has a value
+    vector<int>		m_loops;	///< Loop counters
+    SlotMap		m_nodeSlots;	///< Slot with each expression's value
+    SlotMap		m_varSlots;	///< Slot with each variable's value (SimulateVisitor's user3p)
+    SlotMap		m_outSlots;	///< Slot with each variable's output (SimulateVisitor's user2p)
+    ParamInits		m_paramInits;	///< Parameters read, and their values
+    V3Number		m_selNum;	///< Scratch for OP_SELINTO
+    // Compiling:
+    map<AstJumpLabel*,int> m_labelForDepth;	///< Labels being compiled, and m_forDepth at each
+    map<AstJumpLabel*,vector<int> > m_labelGos;	///< Jumps to patch to each label's end
+    int			m_forDepth;	///< AstNodeFor loops being compiled
+    set<AstNodeFTask*>	m_funcps;	///< Functions being compiled
+    bool		m_anyFor;	///< Found an AstNodeFor
+    bool		m_anyJump;	///< Found an AstJumpGo
+    bool		m_anyAssignDly;	///< Found a delayed assignment
+    bool		m_anyAssignComb; ///< Found a non-delayed assignment
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+
+    void fail(AstNode* nodep, const char* why) {
+	if (!m_failed) UINFO(8,"   Not compiling simulation, "<<why<<": "<<nodep<<endl);
+	m_failed = true;
+    }
+    bool predictable(AstNode* nodep) {
+	// Where SimulateVisitor calls checkNodeInfo
+	if (!nodep->isPredictOptimizable()) fail(nodep, "not predictable");
+	return !m_failed;
+    }
+    int newSlot(FileLine* fl, int width, bool isDouble) {
+	m_nums.push_back(V3Number(fl, width, 0));
+	m_nums.back().isDouble(isDouble);
+	m_set.push_back(false);
+	return m_nums.size()-1;
+    }
+    int slotFor(SlotMap& map, AstNode* nodep) {
+	SlotMap::iterator it = map.find(nodep);
+	if (it != map.end()) return it->second;
+	int slot = newSlot(nodep->fileline(), nodep->width(), nodep->isDouble());
+	map.insert(make_pair(nodep, slot));
+	return slot;
+    }
+    int nodeSlot(AstNode* nodep) { return slotFor(m_nodeSlots, nodep); }
+    int varSlot(AstNode* vscp) { return slotFor(m_varSlots, vscp); }
+    int outSlot(AstNode* vscp) { return slotFor(m_outSlots, vscp); }
+    int pc() const { return m_instrs.size(); }
+    void emit(const Instr& instr) { m_instrs.push_back(instr); }
+    int compileExpr(AstNode* nodep) {
+	// Emit code to evaluate the expression, and return the slot with its value
+	nodep->accept(*this);
+	if (m_failed) return 0;
+	SlotMap::iterator it = m_nodeSlots.find(nodep);
+	if (it == m_nodeSlots.end()) { fail(nodep, "no value"); return 0; }
+	return it->second;
+    }
+    int compileExprAndNext(AstNode* nodep) {
+	// As SimulateVisitor's iterateAndNext, return the slot of the first
+	int slot = compileExpr(nodep);
+	for (AstNode* nextp = nodep->nextp(); nextp && !m_failed; nextp=nextp->nextp()) {
+	    compileExpr(nextp);
+	}
+	return slot;
+    }
+    bool onlyOps(AstNode* nodep, int ops) {
+	// SimulateVisitor iterates all children; refuse those with more than the operands
+	if ((ops < 1 && nodep->op1p()) || (ops < 2 && nodep->op2p())
+	    || (ops < 3 && nodep->op3p()) || nodep->op4p()) {
+	    fail(nodep, "extra children");
+	}
+	return !m_failed;
+    }
+    AstNode* varOrScope(AstVarRef* nodep) {
+	AstNode* vscp;
+	if (m_scoped) vscp = nodep->varScopep();
+	else vscp = nodep->varp();
+	if (!vscp) nodep->v3fatalSrc("Not linked");
+	return vscp;
+    }
+    int unrollCount() {
+	return m_params ? v3Global.opt.unrollCount()*16
+	    : v3Global.opt.unrollCount();
+    }
+
+    // VISITORS - statements
+    virtual void visit(AstAlways* nodep) {
+	if (!predictable(nodep)) return;
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstSenTree* nodep) {}
+    virtual void visit(AstComment*) {}
+    virtual void visit(AstBegin* nodep) {
+	if (!predictable(nodep)) return;
+	nodep->iterateChildren(*this);
+    }
+    virtual void visit(AstNodeIf* nodep) {
+	if (m_failed || !predictable(nodep)) return;
+	int cond = compileExprAndNext(nodep->condp());
+	int elseJump = pc();
+	emit(Instr(OP_JUMPNNZ, 0, cond));
+	nodep->ifsp()->iterateAndNext(*this);
+	int endJump = pc();
+	emit(Instr(OP_JUMP, 0, 0));
+	m_instrs[elseJump].m_b = pc();
+	nodep->elsesp()->iterateAndNext(*this);
+	m_instrs[endJump].m_a = pc();
+    }
+    virtual void visit(AstNodeCase* nodep) {
+	if (m_failed || !predictable(nodep)) return;
+	int expr = compileExprAndNext(nodep->exprp());
+	int match = newSlot(nodep->fileline(), 1, false);
+	vector<pair<int,AstCaseItem*> > hits;	// Jump to patch, item it hits
+	for (AstCaseItem* itemp = nodep->itemsp(); itemp; itemp=itemp->nextp()->castCaseItem()) {
+	    if (!itemp->isDefault()) {
+		for (AstNode* ep = itemp->condsp(); ep; ep=ep->nextp()) {
+		    int cond = compileExprAndNext(ep);
+		    hits.push_back(make_pair(pc(), itemp));
+		    emit(Instr(OP_CASEEQ, match, expr, cond));
+		}
+	    }
+	}
+	AstCaseItem* defaultp = NULL;
+	for (AstCaseItem* itemp = nodep->itemsp(); itemp; itemp=itemp->nextp()->castCaseItem()) {
+	    if (itemp->isDefault()) { defaultp = itemp; break; }
+	}
+	vector<int> endJumps;
+	if (defaultp) {
+	    defaultp->bodysp()->iterateAndNext(*this);
+	}
+	endJumps.push_back(pc());
+	emit(Instr(OP_JUMP, 0, 0));
+	for (AstCaseItem* itemp = nodep->itemsp(); itemp; itemp=itemp->nextp()->castCaseItem()) {
+	    if (itemp->isDefault()) continue;
+	    int bodyPc = pc();
+	    for (vector<pair<int,AstCaseItem*> >::iterator it = hits.begin(); it != hits.end(); ++it) {
+		if (it->second == itemp) m_instrs[it->first].m_c = bodyPc;
+	    }
+	    itemp->bodysp()->iterateAndNext(*this);
+	    endJumps.push_back(pc());
+	    emit(Instr(OP_JUMP, 0, 0));
+	}
+	for (vector<int>::iterator it = endJumps.begin(); it != endJumps.end(); ++it) {
+	    m_instrs[*it].m_a = pc();
+	}
+    }
+    virtual void visit(AstJumpGo* nodep) {
+	if (m_failed || !predictable(nodep)) return;
+	m_anyJump = true;
+	map<AstJumpLabel*,int>::iterator it = m_labelForDepth.find(nodep->labelp());
+	if (it == m_labelForDepth.end()) { fail(nodep, "jump outside tree"); return; }
+	// SimulateVisitor keeps iterating a for loop it's jumping out of
+	if (it->second != m_forDepth) { fail(nodep, "jump out of for"); return; }
+	m_labelGos[nodep->labelp()].push_back(pc());
+	emit(Instr(OP_JUMP, 0, 0));
+    }
+    virtual void visit(AstJumpLabel* nodep) {
+	if (m_failed || !predictable(nodep)) return;
+	m_labelForDepth.insert(make_pair(nodep, m_forDepth));
+	nodep->iterateChildren(*this);
+	vector<int>& gos = m_labelGos[nodep];
+	for (vector<int>::iterator it = gos.begin(); it != gos.end(); ++it) {
+	    m_instrs[*it].m_a = pc();
+	}
+	m_labelForDepth.erase(nodep);
+	m_labelGos.erase(nodep);
+    }
+    virtual void visit(AstNodeFor* nodep) {
+	if (m_failed) return;
+	if (!m_params) { fail(nodep, "for"); return; }
+	if (!predictable(nodep)) return;
+	m_anyFor = true;
+	m_forDepth++;
+	int loop = m_loops.size(); m_loops.push_back(0);
+	emit(Instr(OP_LOOPINIT, 0, loop));
+	nodep->initsp()->iterateAndNext(*this);
+	int topPc = pc();
+	int cond = compileExprAndNext(nodep->condp());
+	int exitJump = pc();
+	emit(Instr(OP_JUMPNNZ, 0, cond));
+	nodep->bodysp()->iterateAndNext(*this);
+	nodep->incsp()->iterateAndNext(*this);
+	emit(Instr(OP_LOOPCHK, 0, loop, 0, 0, NULL, unrollCount()*16));
+	emit(Instr(OP_JUMP, 0, topPc));
+	m_instrs[exitJump].m_b = pc();
+	m_forDepth--;
+    }
+    virtual void visit(AstWhile* nodep) {
+	if (m_failed) return;
+	if (!m_params) { fail(nodep, "while"); return; }
+	if (!predictable(nodep)) return;
+	int loop = m_loops.size(); m_loops.push_back(0);
+	emit(Instr(OP_LOOPINIT, 0, loop));
+	int topPc = pc();
+	nodep->precondsp()->iterateAndNext(*this);
+	int cond = compileExprAndNext(nodep->condp());
+	int exitJump = pc();
+	emit(Instr(OP_JUMPNNZ, 0, cond));
+	nodep->bodysp()->iterateAndNext(*this);
+	nodep->incsp()->iterateAndNext(*this);
+	emit(Instr(OP_LOOPCHK, 0, loop, 0, 0, NULL, unrollCount()*16));
+	emit(Instr(OP_JUMP, 0, topPc));
+	m_instrs[exitJump].m_b = pc();
+    }
+    int compileSelLsb(AstSel* selp, AstVarRef*& outVarrefpRef) {
+	// As SimulateVisitor::handleAssignSelRecurse
+	if (!predictable(selp)) return 0;
+	int lsb = compileExprAndNext(selp->lsbp());
+	if (m_failed) return 0;
+	if (AstVarRef* varrefp = selp->fromp()->castVarRef()) {
+	    outVarrefpRef = varrefp;
+	    int dst = newSlot(selp->fileline(), 1, false);
+	    emit(Instr(OP_COPYNUM, dst, lsb));
+	    return dst;
+	} else if (AstSel* subselp = selp->lhsp()->castSel()) {
+	    int sublsb = compileSelLsb(subselp, outVarrefpRef);
+	    int dst = newSlot(selp->fileline(), 1, false);
+	    emit(Instr(OP_LSBADD, dst, sublsb, lsb));
+	    return dst;
+	} else {
+	    fail(selp, "select LHS isn't simple variable");
+	    return 0;
+	}
+    }
+    virtual void visit(AstNodeAssign* nodep) {
+	if (m_failed) return;
+	bool dly = nodep->castAssignDly();
+	if (dly) {
+	    if (m_anyAssignComb) { fail(nodep, "mix of dly/non-dly assigns"); return; }
+	    m_anyAssignDly = true;
+	} else {
+	    if (m_anyAssignDly) { fail(nodep, "mix of dly/non-dly assigns"); return; }
+	    m_anyAssignComb = true;
+	}
+	if (AstSel* selp = nodep->lhsp()->castSel()) {
+	    if (!m_params) { fail(nodep, "LHS has select"); return; }
+	    int rhs = compileExprAndNext(nodep->rhsp());
+	    AstVarRef* varrefp = NULL;
+	    int lsb = compileSelLsb(selp, varrefp/*ref*/);
+	    if (m_failed) return;
+	    AstNode* vscp = varOrScope(varrefp);
+	    emit(Instr(dly ? OP_SELINTODLY : OP_SELINTO, varSlot(vscp), rhs, outSlot(vscp), lsb,
+		       varrefp, selp->widthConst()));
+	} else if (AstVarRef* varrefp = nodep->lhsp()->castVarRef()) {
+	    int rhs = compileExprAndNext(nodep->rhsp());
+	    if (m_failed) return;
+	    AstNode* vscp = varOrScope(varrefp);
+	    emit(Instr(dly ? OP_ASSIGNDLY : OP_ASSIGN, varSlot(vscp), rhs, outSlot(vscp)));
+	} else {
+	    fail(nodep, "LHS isn't simple variable");
+	}
+    }
+    virtual void visit(AstVar* nodep) {
+	if (!m_params) fail(nodep, "var");
+    }
+    virtual void visit(AstScopeName* nodep) {
+	if (!m_params) fail(nodep, "scope name");
+    }
+
+    // VISITORS - expressions
+    virtual void visit(AstVarRef* nodep) {
+	if (m_failed) return;
+	AstVar* varp = nodep->varp();
+	// SimulateVisitor iterates the variable's children; allow only a constant value
+	if (varp->op1p() || varp->op2p() || varp->op4p()
+	    || (varp->valuep() && (!varp->valuep()->castConst() || varp->valuep()->nextp()))) {
+	    fail(nodep, "variable with children"); return;
+	}
+	if (!varp->dtypeSkipRefp()->castBasicDType()
+	    && !varp->dtypeSkipRefp()->castPackArrayDType()
+	    && !varp->dtypeSkipRefp()->castStructDType()) {
+	    fail(nodep, "array references/not basic"); return;
+	}
+	if (nodep->lvalue()) { fail(nodep, "lvalue"); return; }
+	AstNode* vscp = varOrScope(nodep);
+	int slot = varSlot(vscp);
+	if (varp->isParam() && varp->valuep()) {
+	    // Set on the first read; nothing may write a parameter beforehand
+	    bool found = false;
+	    for (ParamInits::iterator it = m_paramInits.begin(); it != m_paramInits.end(); ++it) {
+		if (it->first == slot) found = true;
+	    }
+	    if (!found) m_paramInits.push_back(make_pair(slot, varp->valuep()->castConst()));
+	} else {
+	    emit(Instr(OP_CHECK, 0, slot));
+	}
+	m_nodeSlots[nodep] = slot;  // By reference, as SimulateVisitor
+    }
+    virtual void visit(AstConst* nodep) {
+	if (!predictable(nodep)) return;
+	SlotMap::iterator it = m_nodeSlots.find(nodep);
+	if (it == m_nodeSlots.end()) {
+	    m_nums.push_back(nodep->num());
+	    m_set.push_back(false);
+	    m_nodeSlots.insert(make_pair(nodep, (int)(m_nums.size()-1)));
+	}
+    }
+    virtual void visit(AstEnumItemRef* nodep) {
+	if (m_failed || !predictable(nodep)) return;
+	if (!nodep->itemp()) nodep->v3fatalSrc("Not linked");
+	AstNode* valuep = nodep->itemp()->valuep();
+	if (!valuep) { fail(nodep, "no value for enum item"); return; }
+	int value = compileExprAndNext(valuep);
+	emit(Instr(OP_COPY, nodeSlot(nodep), value));
+    }
+    virtual void visit(AstNodeUniop* nodep) {
+	if (m_failed || !predictable(nodep) || !onlyOps(nodep, 1)) return;
+	int lhs = compileExprAndNext(nodep->lhsp());
+	emit(Instr(OP_UNIOP, nodeSlot(nodep), lhs, 0, 0, nodep));
+    }
+    virtual void visit(AstNodeBiop* nodep) {
+	if (m_failed || !predictable(nodep) || !onlyOps(nodep, 2)) return;
+	int lhs = compileExprAndNext(nodep->lhsp());
+	int rhs = compileExprAndNext(nodep->rhsp());
+	emit(Instr(OP_BIOP, nodeSlot(nodep), lhs, rhs, 0, nodep));
+    }
+    virtual void visit(AstNodeTriop* nodep) {
+	if (m_failed || !predictable(nodep) || !onlyOps(nodep, 3)) return;
+	int lhs = compileExprAndNext(nodep->lhsp());
+	int rhs = compileExprAndNext(nodep->rhsp());
+	int ths = compileExprAndNext(nodep->thsp());
+	emit(Instr(OP_TRIOP, nodeSlot(nodep), lhs, rhs, ths, nodep));
+    }
+    void compileShortCircuit(AstNodeBiop* nodep, Opcode skipOp, bool skipToOne) {
+	// lhs; if skipOp(lhs) result=(skipToOne ? 1 : lhs) else result=rhs
+	if (m_failed || !predictable(nodep)) return;
+	int result = nodeSlot(nodep);
+	int lhs = compileExpr(nodep->lhsp());
+	int skipJump = pc();
+	emit(Instr(skipOp, 0, lhs));
+	int rhs = compileExpr(nodep->rhsp());
+	emit(Instr(OP_COPY, result, rhs));
+	int endJump = pc();
+	emit(Instr(OP_JUMP, 0, 0));
+	m_instrs[skipJump].m_b = pc();
+	if (skipToOne) {
+	    m_nums.push_back(V3Number(nodep->fileline(), 1, 1));
+	    m_set.push_back(false);
+	    emit(Instr(OP_COPY, result, m_nums.size()-1));
+	} else {
+	    emit(Instr(OP_COPY, result, lhs));
+	}
+	m_instrs[endJump].m_a = pc();
+    }
+    virtual void visit(AstLogAnd* nodep) { compileShortCircuit(nodep, OP_JUMPNNZ, false); }
+    virtual void visit(AstLogOr* nodep) { compileShortCircuit(nodep, OP_JUMPNZ, false); }
+    virtual void visit(AstLogIf* nodep) { compileShortCircuit(nodep, OP_JUMPEQZ, true); }
+    virtual void visit(AstNodeCond* nodep) {
+	if (m_failed || !predictable(nodep)) return;
+	int result = nodeSlot(nodep);
+	int cond = compileExpr(nodep->condp());
+	int elseJump = pc();
+	emit(Instr(OP_JUMPNNZ, 0, cond));
+	int expr1 = compileExpr(nodep->expr1p());
+	emit(Instr(OP_COPY, result, expr1));
+	int endJump = pc();
+	emit(Instr(OP_JUMP, 0, 0));
+	m_instrs[elseJump].m_b = pc();
+	int expr2 = compileExpr(nodep->expr2p());
+	emit(Instr(OP_COPY, result, expr2));
+	m_instrs[endJump].m_a = pc();
+    }
+    virtual void visit(AstFuncRef* nodep) {
+	if (m_failed) return;
+	if (!m_params) { fail(nodep, "function call"); return; }
+	AstNodeFTask* funcp = nodep->taskp()->castNodeFTask(); if (!funcp) nodep->v3fatalSrc("Not linked");
+	// SimulateVisitor widths the function when called; leave that to it
+	if (!funcp->didWidth()) { fail(nodep, "function not yet widthed"); return; }
+	if (funcp->dpiImport()) { fail(nodep, "DPI import"); return; }
+	if (!funcp->fvarp()) { fail(nodep, "not a function"); return; }
+	if (m_funcps.find(funcp) != m_funcps.end()) { fail(nodep, "recursive call"); return; }
+	V3TaskConnects tconnects = V3Task::taskConnects(nodep, nodep->taskp()->stmtsp());
+	// Evaluate all arguments, then apply them
+	vector<pair<AstVar*,int> > args;
+	for (V3TaskConnects::iterator it=tconnects.begin(); it!=tconnects.end(); ++it) {
+	    AstVar* portp = it->first;
+	    AstNode* pinp = it->second->exprp();
+	    if (pinp) {  // Else too few arguments in function call - ignore it
+		if (portp->isOutput()) { fail(nodep, "output argument"); return; }
+		args.push_back(make_pair(portp, compileExpr(pinp)));
+	    }
+	}
+	for (vector<pair<AstVar*,int> >::iterator it = args.begin(); it != args.end(); ++it) {
+	    emit(Instr(OP_SETVAR, varSlot(it->first), it->second));
+	}
+	// Evaluate the function, inline
+	if (!predictable(funcp)) return;
+	m_funcps.insert(funcp);
+	funcp->iterateChildren(*this);
+	m_funcps.erase(funcp);
+	// Grab return value from output variable
+	int fvar = varSlot(funcp->fvarp());
+	emit(Instr(OP_CHECK, 0, fvar));
+	emit(Instr(OP_COPY, nodeSlot(nodep), fvar));
+    }
+    // default
+    // Anything else, including anything SimulateVisitor only checks
+    virtual void visit(AstNode* nodep) {
+	fail(nodep, "unsupported node");
+    }
+
+    // METHODS - running
+    void assignVar(const Instr& instr, const V3Number& num, bool dly) {
+	// As SimulateVisitor::assignOutNumber
+	if (!dly) {
+	    m_nums[instr.m_dst].opAssign(num);
+	    m_set[instr.m_dst] = true;
+	}
+	m_nums[instr.m_b].opAssign(num);
+	m_set[instr.m_b] = true;
+    }
+    void selInto(const Instr& instr, bool dly) {
+	// As SimulateVisitor::handleAssignSel
+	if (m_set[instr.m_b]) {
+	    m_selNum = m_nums[instr.m_b];
+	} else if (m_set[instr.m_dst]) {
+	    m_selNum = m_nums[instr.m_dst];
+	} else {  // Assignment to unassigned variable, all bits are X or 0
+	    AstVarRef* varrefp = static_cast<AstVarRef*>(instr.m_nodep);
+	    m_selNum = V3Number(varrefp->fileline(), varrefp->varp()->widthMin());
+	    if (varrefp->varp()->basicp() && varrefp->varp()->basicp()->isZeroInit()) {
+		m_selNum.setAllBits0();
+	    } else {
+		m_selNum.setAllBitsX();
+	    }
+	}
+	m_selNum.opSelInto(m_nums[instr.m_a], m_nums[instr.m_c], instr.m_width);
+	assignVar(instr, m_selNum, dly);
+    }
+
+public:
+    // CONSTRUCTORS
+    SimulateProgram()
+	: m_scoped(false), m_params(false), m_failed(false)
+	, m_selNum(NULL), m_forDepth(0)
+	, m_anyFor(false), m_anyJump(false), m_anyAssignDly(false), m_anyAssignComb(false) {}
+    virtual ~SimulateProgram() {}
+
+    // METHODS
+    /// Compile as SimulateVisitor::mainTableEmulate, false if can't
+    bool compileTable(AstNode* nodep) { return compile(nodep, true/*scoped*/, false/*params*/); }
+    /// Compile as SimulateVisitor::mainParamEmulate, false if can't
+    bool compileParam(AstNode* nodep) { return compile(nodep, false/*scoped*/, true/*params*/); }
+    bool compile(AstNode* nodep, bool scoped, bool params) {
+	m_scoped = scoped;
+	m_params = params;
+	nodep->accept(*this);
+	// SimulateVisitor evaluates for loop conditions while jumping over them
+	if (m_anyFor && m_anyJump) fail(nodep, "jump and for");
+	emit(Instr(OP_END, 0, 0));
+	if (!m_failed) {
+	    UINFO(8,"   Compiled simulation, "<<m_instrs.size()<<" instrs "
+		  <<m_nums.size()<<" slots: "<<nodep<<endl);
+	}
+	clear();
+	return !m_failed;
+    }
+    /// Forget variable values, before setting inputs and running again
+    void clear() {
+	m_set.assign(m_set.size(), false);
+	for (ParamInits::iterator it = m_paramInits.begin(); it != m_paramInits.end(); ++it) {
+	    m_nums[it->first].opAssign(it->second->num());
+	    m_set[it->first] = true;
+	}
+    }
+    /// Set an input variable's value
+    V3Number* newNumber(AstNode* nodep, uint32_t value=0) {
+	int slot = varSlot(nodep);
+	if (!m_set[slot]) {
+	    m_nums[slot].setLong(value);
+	    m_set[slot] = true;
+	}
+	return &m_nums[slot];
+    }
+    /// Value of a variable (as set by non-delayed assignment) or the expression simulated
+    V3Number* fetchNumberNull(AstNode* nodep) {
+	SlotMap::iterator it = m_nodeSlots.find(nodep);
+	if (it != m_nodeSlots.end()) {
+	    if (nodep->castVarRef() && !m_set[it->second]) return NULL;
+	    return &m_nums[it->second];
+	}
+	it = m_varSlots.find(nodep);
+	if (it == m_varSlots.end() || !m_set[it->second]) return NULL;
+	return &m_nums[it->second];
+    }
+    /// Output value of a variable, NULL if not assigned
+    V3Number* fetchOutNumberNull(AstNode* nodep) {
+	SlotMap::iterator it = m_outSlots.find(nodep);
+	if (it == m_outSlots.end() || !m_set[it->second]) return NULL;
+	return &m_nums[it->second];
+    }
+    /// Simulate; false if must use SimulateVisitor instead
+    bool run() {
+	for (vector<int>::iterator it = m_loops.begin(); it != m_loops.end(); ++it) *it = 0;
+	for (int pc = 0; true; ) {
+	    const Instr& instr = m_instrs[pc++];
+	    switch (instr.m_op) {
+	    case OP_END:
+		return true;
+	    case OP_UNIOP:
+		static_cast<AstNodeUniop*>(instr.m_nodep)->numberOperate(
+		    m_nums[instr.m_dst], m_nums[instr.m_a]);
+		break;
+	    case OP_BIOP:
+		static_cast<AstNodeBiop*>(instr.m_nodep)->numberOperate(
+		    m_nums[instr.m_dst], m_nums[instr.m_a], m_nums[instr.m_b]);
+		break;
+	    case OP_TRIOP:
+		static_cast<AstNodeTriop*>(instr.m_nodep)->numberOperate(
+		    m_nums[instr.m_dst], m_nums[instr.m_a], m_nums[instr.m_b], m_nums[instr.m_c]);
+		break;
+	    case OP_COPY:
+		m_nums[instr.m_dst].opAssign(m_nums[instr.m_a]);
+		break;
+	    case OP_COPYNUM:
+		m_nums[instr.m_dst] = m_nums[instr.m_a];
+		break;
+	    case OP_LSBADD:
+		m_nums[instr.m_dst] = m_nums[instr.m_a];
+		m_nums[instr.m_dst].opAdd(m_nums[instr.m_a], m_nums[instr.m_b]);
+		break;
+	    case OP_CHECK:
+		if (VL_UNLIKELY(!m_set[instr.m_a])) return false;
+		break;
+	    case OP_SETVAR:
+		m_nums[instr.m_dst].opAssign(m_nums[instr.m_a]);
+		m_set[instr.m_dst] = true;
+		break;
+	    case OP_ASSIGN:
+		assignVar(instr, m_nums[instr.m_a], false);
+		break;
+	    case OP_ASSIGNDLY:
+		assignVar(instr, m_nums[instr.m_a], true);
+		break;
+	    case OP_SELINTO:
+		selInto(instr, false);
+		break;
+	    case OP_SELINTODLY:
+		selInto(instr, true);
+		break;
+	    case OP_JUMP:
+		pc = instr.m_a;
+		break;
+	    case OP_JUMPNZ:
+		if (m_nums[instr.m_a].isNeqZero()) pc = instr.m_b;
+		break;
+	    case OP_JUMPNNZ:
+		if (!m_nums[instr.m_a].isNeqZero()) pc = instr.m_b;
+		break;
+	    case OP_JUMPEQZ:
+		if (m_nums[instr.m_a].isEqZero()) pc = instr.m_b;
+		break;
+	    case OP_CASEEQ:
+		m_nums[instr.m_dst].opEq(m_nums[instr.m_a], m_nums[instr.m_b]);
+		if (m_nums[instr.m_dst].isNeqZero()) pc = instr.m_c;
+		break;
+	    case OP_LOOPINIT:
+		m_loops[instr.m_a] = 0;
+		break;
+	    case OP_LOOPCHK:
+		if (VL_UNLIKELY(m_loops[instr.m_a]++ > instr.m_width)) return false;
+		break;
+	    }
+	}
+    }
+};
+
 #endif // Guard
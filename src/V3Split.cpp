@@ -233,7 +233,9 @@ private:
     SplitPliVertex*	m_pliVertexp;	// Element specifying PLI ordering
     V3Graph		m_graph;	// Scoreboard of var usages/dependencies
     bool		m_inDly;	// Inside ASSIGNDLY
+    bool		m_inGated;	// Under ACTIVE gated by a SenGate
     V3Double0		m_statSplits;	// Statistic tracking
+    V3Double0		m_statGated;	// Statistic tracking
 
     // METHODS
     static int debug() {
@@ -366,6 +368,12 @@ private:
     void reorderBlock(AstNode* nodep) {
 	// Reorder statements in the completed graph
 	AstAlways* splitAlwaysp = nodep->backp()->castAlways();
+	// A clock gated bank stays in one always, so it's one contiguous
+	// function entered once per enable, rather than one test per flop
+	if (splitAlwaysp && m_inGated) {
+	    ++m_statGated;
+	    splitAlwaysp = NULL;
+	}
 
 	// Map the rank numbers into nodes they associate with
 	typedef multimap<uint32_t,AstNode*> RankNodeMap;
@@ -466,6 +474,14 @@ private:
     }
 
     // VISITORS
+    virtual void visit(AstActive* nodep) {
+	m_inGated = false;
+	for (AstNodeSenItem* senp = nodep->sensesp()->sensesp(); senp; senp=senp->nextp()->castNodeSenItem()) {
+	    if (senp->castSenGate()) m_inGated = true;
+	}
+	nodep->iterateChildren(*this);
+	m_inGated = false;
+    }
     virtual void visit(AstAlways* nodep) {
 	UINFO(4,"   ALW   "<<nodep<<endl);
 	if (debug()>=9) nodep->dumpTree(cout,"   alwIn:: ");
@@ -565,11 +581,13 @@ public:
     // CONSTUCTORS
     SplitVisitor(AstNetlist* nodep, bool reorder)
 	: m_reorder(reorder) {
+	m_inGated = false;
 	scoreboardClear();
 	nodep->accept(*this);
     }
     virtual ~SplitVisitor() {
 	V3Stats::addStat("Optimizations, Split always", m_statSplits);
+	V3Stats::addStat("Optimizations, Split always gated kept", m_statGated);
     }
 };
 
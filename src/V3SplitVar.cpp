@@ -0,0 +1,301 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//*************************************************************************
+// DESCRIPTION: Verilator: Split piecewise assigned variables into bit ranges
+//
+// Code available from: http://www.veripool.org/verilator
+//
+//*************************************************************************
+//
+// Copyright 2003-2017 by Wilson Snyder.  This program is free software; you can
+// redistribute it and/or modify it under the terms of either the GNU
+// Lesser General Public License Version 3 or the Perl Artistic License
+// Version 2.0.
+//
+// Verilator is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+//*************************************************************************
+// V3SplitVar's Transformations:
+//
+// Ordering considers each variable as a whole, so
+//	assign b[3:0] = b[7:4];  assign b[7:4] = in;
+// appears circular, though no bit depends on itself.
+//
+// Each VARSCOPE:
+//	If every write is ASSIGN/ASSIGNW(SEL(VARREF, const, const)),
+//	    with two or more different, non overlapping bit ranges,
+//	    and the variable isn't public, a primary IO, nor a clock:
+//	Make a new VARSCOPE for each range written, and each gap between
+//	Replace each write with a write to the range's VARSCOPE
+//	Replace each read with a CONCAT of the pieces it covers;
+//	    tracing reads the concatenation so still shows the whole variable.
+//
+//*************************************************************************
+
+#include "config_build.h"
+#include "verilatedos.h"
+#include <cstdio>
+#include <cstdarg>
+#include <unistd.h>
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include "V3Global.h"
+#include "V3SplitVar.h"
+#include "V3Stats.h"
+#include "V3Ast.h"
+
+//######################################################################
+
+class SplitVarBaseVisitor : public AstNVisitor {
+public:
+    // TYPES
+    typedef pair<int,int> BitRange;	// lsb, width
+    struct SplitVarInfo {
+	AstVarScope*		m_vscp;		// Variable
+	bool			m_bad;		// Can't split, some reference isn't a simple range
+	vector<BitRange>	m_writes;	// Ranges written
+	vector<BitRange>	m_segs;		// Ranges split into, ascending
+	vector<AstVarScope*>	m_segVscps;	// Variable for each of m_segs
+	explicit SplitVarInfo(AstVarScope* vscp) : m_vscp(vscp), m_bad(false) {}
+	bool split() const { return !m_segVscps.empty(); }
+    };
+
+    // METHODS
+    static int debug() {
+	static int level = -1;
+	if (VL_UNLIKELY(level < 0)) level = v3Global.opt.debugSrcLevel(__FILE__);
+	return level;
+    }
+    static AstSel* constSelOf(AstNodeVarRef* nodep) {
+	// Return SEL that is selecting a constant range from this VARREF, if any
+	AstSel* selp = nodep->backp()->castSel();
+	if (selp && selp->fromp() == nodep
+	    && selp->lsbp()->castConst() && selp->widthp()->castConst()
+	    && selp->lsbConst() >= 0 && selp->widthConst() > 0
+	    && selp->msbConst() < nodep->varp()->width()) {
+	    return selp;
+	}
+	return NULL;
+    }
+};
+
+//######################################################################
+// Find how each variable is written
+
+class SplitVarFindVisitor : public SplitVarBaseVisitor {
+private:
+    // NODE STATE
+    //  AstVarScope::user1p()	-> SplitVarInfo*.  How variable is referenced
+    // STATE
+    vector<SplitVarInfo*>	m_infops;	// All variables referenced
+    bool			m_inSens;	// Under a sensitivity list
+
+    // VISITORS
+    virtual void visit(AstSenTree* nodep) {
+	m_inSens = true;
+	nodep->iterateChildren(*this);
+	m_inSens = false;
+    }
+    virtual void visit(AstNodeVarRef* nodep) {
+	AstVarScope* vscp = nodep->varScopep();
+	if (!vscp) return;
+	SplitVarInfo* infop = (SplitVarInfo*)(vscp->user1p());
+	if (!infop) {
+	    infop = new SplitVarInfo(vscp);
+	    m_infops.push_back(infop);
+	    vscp->user1p(infop);
+	}
+	AstSel* selp = constSelOf(nodep);
+	if (m_inSens) {
+	    infop->m_bad = true;
+	} else if (nodep->lvalue()) {
+	    AstNodeAssign* assp = selp ? selp->backp()->castNodeAssign() : NULL;
+	    if (assp && assp->lhsp() == selp
+		&& (assp->castAssign() || assp->castAssignW())) {
+		infop->m_writes.push_back(make_pair(selp->lsbConst(), selp->widthConst()));
+	    } else {
+		infop->m_bad = true;
+	    }
+	}
+    }
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+
+public:
+    // CONSTUCTORS
+    explicit SplitVarFindVisitor(AstNetlist* nodep) {
+	m_inSens = false;
+	nodep->accept(*this);
+    }
+    virtual ~SplitVarFindVisitor() {}
+    const vector<SplitVarInfo*>& infops() const { return m_infops; }
+};
+
+//######################################################################
+// Split variables
+
+class SplitVarVisitor : public SplitVarBaseVisitor {
+private:
+    // NODE STATE
+    // Entire netlist:
+    //  AstVarScope::user1p()	-> SplitVarInfo*.  How variable is referenced (SplitVarFindVisitor)
+    AstUser1InUse	m_inuser1;
+
+    // TYPES
+    typedef std::map<pair<AstNodeModule*,string>,AstVar*> VarMap;
+
+    // STATE
+    VarMap		m_modVarMap;	// Table of new var names created under module
+    V3Double0		m_statSplits;	// Statistic tracking
+    V3Double0		m_statSegs;	// Statistic tracking
+
+    // METHODS
+    bool splittable(SplitVarInfo* infop) {
+	AstVar* varp = infop->m_vscp->varp();
+	AstBasicDType* basicp = varp->dtypep()->skipRefp()->castBasicDType();
+	if (infop->m_bad || !basicp || !basicp->isBitLogic()
+	    || varp->isSigned() || varp->width() < 2
+	    || varp->isPrimaryIO() || varp->isSigPublic() || varp->isSc()
+	    || varp->isUsedClock() || varp->isParam() || varp->valuep()) {
+	    return false;
+	}
+	// Need distinct ranges that don't overlap
+	vector<BitRange>& writes = infop->m_writes;
+	sort(writes.begin(), writes.end());
+	writes.erase(unique(writes.begin(), writes.end()), writes.end());
+	if (writes.size() < 2) return false;
+	for (vector<BitRange>::iterator it = writes.begin(); it+1 != writes.end(); ++it) {
+	    if (it->first + it->second > (it+1)->first) return false;
+	}
+	return true;
+    }
+    AstVarScope* createSegVarSc(AstVarScope* oldvscp, const BitRange& seg) {
+	AstScope* scopep = oldvscp->scopep();
+	AstNodeModule* addmodp = scopep->modp();
+	FileLine* fl = oldvscp->fileline();
+	string name = "__Vsplit__"+oldvscp->varp()->name()
+	    +"__"+cvtToStr(seg.first+seg.second-1)+"_"+cvtToStr(seg.first);
+	// Each instance of a module splits the same, so share the AstVar
+	AstVar* varp;
+	VarMap::iterator it = m_modVarMap.find(make_pair(addmodp, name));
+	if (it != m_modVarMap.end()) {
+	    varp = it->second;
+	} else {
+	    varp = new AstVar(fl, AstVarType::MODULETEMP, name,
+			      oldvscp->findLogicDType(seg.second, seg.second, AstNumeric::UNSIGNED));
+	    addmodp->addStmtp(varp);
+	    m_modVarMap.insert(make_pair(make_pair(addmodp, name), varp));
+	}
+	AstVarScope* vscp = new AstVarScope(fl, scopep, varp);
+	scopep->addVarp(vscp);
+	return vscp;
+    }
+    void splitVar(SplitVarInfo* infop) {
+	AstVarScope* vscp = infop->m_vscp;
+	UINFO(4,"  Split "<<vscp<<endl);
+	++m_statSplits;
+	int pos = 0;
+	for (vector<BitRange>::const_iterator it = infop->m_writes.begin();
+	     it != infop->m_writes.end(); ++it) {
+	    if (it->first > pos) infop->m_segs.push_back(make_pair(pos, it->first - pos));
+	    infop->m_segs.push_back(*it);
+	    pos = it->first + it->second;
+	}
+	if (pos < vscp->varp()->width()) {
+	    infop->m_segs.push_back(make_pair(pos, vscp->varp()->width() - pos));
+	}
+	for (vector<BitRange>::const_iterator it = infop->m_segs.begin();
+	     it != infop->m_segs.end(); ++it) {
+	    infop->m_segVscps.push_back(createSegVarSc(vscp, *it));
+	    ++m_statSegs;
+	}
+    }
+    AstNode* newRead(FileLine* fl, SplitVarInfo* infop, int lsb, int width) {
+	// Concatenate the pieces of each segment within the range
+	AstNode* resultp = NULL;
+	for (size_t i=0; i<infop->m_segs.size(); ++i) {
+	    int seglsb = infop->m_segs[i].first;
+	    int segend = seglsb + infop->m_segs[i].second;
+	    int lo = max(lsb, seglsb);
+	    int hi = min(lsb + width, segend);
+	    if (lo >= hi) continue;
+	    AstNode* piecep = new AstVarRef(fl, infop->m_segVscps[i], false);
+	    if (lo != seglsb || hi != segend) {
+		piecep = new AstSel(fl, piecep, lo - seglsb, hi - lo);
+	    }
+	    resultp = resultp ? new AstConcat(fl, piecep, resultp) : piecep;
+	}
+	return resultp;
+    }
+    AstVarScope* segVscp(SplitVarInfo* infop, int lsb) {
+	for (size_t i=0; i<infop->m_segs.size(); ++i) {
+	    if (infop->m_segs[i].first == lsb) return infop->m_segVscps[i];
+	}
+	infop->m_vscp->v3fatalSrc("Split variable written at non-segment bit "<<lsb);
+	return NULL;
+    }
+
+    // VISITORS
+    virtual void visit(AstSel* nodep) {
+	AstNodeVarRef* varrefp = nodep->fromp()->castNodeVarRef();
+	SplitVarInfo* infop = (varrefp && varrefp->varScopep()
+			       ? (SplitVarInfo*)(varrefp->varScopep()->user1p()) : NULL);
+	if (infop && infop->split() && constSelOf(varrefp)) {
+	    AstNode* newp;
+	    if (varrefp->lvalue()) {
+		newp = new AstVarRef(nodep->fileline(), segVscp(infop, nodep->lsbConst()), true);
+	    } else {
+		newp = newRead(nodep->fileline(), infop, nodep->lsbConst(), nodep->widthConst());
+	    }
+	    nodep->replaceWith(newp);
+	    pushDeletep(nodep); VL_DANGLING(nodep);
+	} else {
+	    nodep->iterateChildren(*this);
+	}
+    }
+    virtual void visit(AstNodeVarRef* nodep) {
+	SplitVarInfo* infop = (nodep->varScopep()
+			       ? (SplitVarInfo*)(nodep->varScopep()->user1p()) : NULL);
+	if (infop && infop->split()) {
+	    if (nodep->lvalue()) nodep->v3fatalSrc("Split variable written as a whole");
+	    nodep->replaceWith(newRead(nodep->fileline(), infop, 0, nodep->varp()->width()));
+	    pushDeletep(nodep); VL_DANGLING(nodep);
+	}
+    }
+    virtual void visit(AstNode* nodep) {
+	nodep->iterateChildren(*this);
+    }
+
+public:
+    // CONSTUCTORS
+    explicit SplitVarVisitor(AstNetlist* nodep) {
+	SplitVarFindVisitor findVisitor (nodep);
+	for (vector<SplitVarInfo*>::const_iterator it = findVisitor.infops().begin();
+	     it != findVisitor.infops().end(); ++it) {
+	    if (splittable(*it)) splitVar(*it);
+	}
+	if (m_statSplits != 0) nodep->accept(*this);
+	for (vector<SplitVarInfo*>::const_iterator it = findVisitor.infops().begin();
+	     it != findVisitor.infops().end(); ++it) {
+	    delete *it;
+	}
+    }
+    virtual ~SplitVarVisitor() {
+	V3Stats::addStat("Optimizations, Split var bit ranges", m_statSplits);
+	V3Stats::addStat("Optimizations, Split var pieces", m_statSegs);
+    }
+};
+
+//######################################################################
+// SplitVar class functions
+
+void V3SplitVar::splitVarAll(AstNetlist* nodep) {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    SplitVarVisitor visitor (nodep);
+    V3Global::dumpCheckGlobalTree("splitvar", 0, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
+}
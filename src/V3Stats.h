@@ -93,6 +93,8 @@ public:
 	addStat(V3Statistic("*",name,count,true,true)); }
     /// Called each stage
     static void statsStage(const string& name);
+    /// Called by the top level to dump the --stats-trace timeline
+    static void statsTraceReport();
     /// Called by the top level to collect statistics
     static void statsStageAll(AstNetlist* nodep, const string& stage, bool fast=false);
     static void statsFinalAll(AstNetlist* nodep);
@@ -101,4 +103,16 @@ public:
 };
 
 
+//============================================================================
+
+class V3StatsTraceScope {
+    // For --stats-trace, records a step nested inside the current pass,
+    // from construction until destruction
+    string	m_name;		///< Name of step
+    double	m_startUsecs;	///< Wall time at construction
+public:
+    explicit V3StatsTraceScope(const string& name);
+    ~V3StatsTraceScope();
+};
+
 #endif // Guard
@@ -202,6 +202,110 @@ public:
 
 StatsReport::StatColl	StatsReport::s_allStats;
 
+//######################################################################
+// Timeline for --stats-trace, in Chrome trace-event format
+
+class StatsTraceCountVisitor : public AstNVisitor {
+    // Count all nodes in the tree
+    vluint64_t	m_count;
+    virtual void visit(AstNode* nodep) {
+	++m_count;
+	nodep->iterateChildren(*this);
+    }
+public:
+    explicit StatsTraceCountVisitor(AstNode* nodep) : m_count(0) { nodep->accept(*this); }
+    vluint64_t count() const { return m_count; }
+};
+
+class StatsTrace {
+    // TYPES
+    struct Event {
+	string		m_name;		// Pass or step name
+	bool		m_pass;		// Pass, versus step inside a pass
+	double		m_startUsecs;	// Wall time at start, relative to s_startUsecs
+	double		m_durUsecs;	// Duration
+	double		m_memoryMB;	// Memory usage at end
+	vluint64_t	m_nodes;	// Node count at end (passes only)
+	vluint64_t	m_edits;	// Tree edits during event (passes only)
+    };
+    typedef vector<Event> EventColl;
+
+    // STATE
+    static EventColl	s_events;	// All events, in order completed
+    static double	s_startUsecs;	// Wall time at startup
+    static double	s_lastUsecs;	// Wall time at end of last pass
+    static vluint64_t	s_lastEdits;	// Edit count at end of last pass
+
+    static string jsonString(const string& in) {
+	string out = "\"";
+	for (string::const_iterator it = in.begin(); it != in.end(); ++it) {
+	    if (*it == '"' || *it == '\\') out += '\\';
+	    out += *it;
+	}
+	return out + "\"";
+    }
+public:
+    static double nowUsecs() { return V3Os::timeUsecs() - s_startUsecs; }
+    static void addPass(const string& name) {
+	// A pass runs from the end of the previous pass until now
+	Event event;
+	event.m_name = name;
+	event.m_pass = true;
+	event.m_startUsecs = s_lastUsecs;
+	s_lastUsecs = nowUsecs();
+	event.m_durUsecs = s_lastUsecs - event.m_startUsecs;
+	event.m_memoryMB = V3Os::memUsageBytes()/1024.0/1024.0;
+	event.m_nodes = v3Global.rootp() ? StatsTraceCountVisitor(v3Global.rootp()).count() : 0;
+	event.m_edits = AstNode::editCountGbl() - s_lastEdits;
+	s_lastEdits = AstNode::editCountGbl();
+	s_events.push_back(event);
+    }
+    static void addStep(const string& name, double startUsecs) {
+	Event event;
+	event.m_name = name;
+	event.m_pass = false;
+	event.m_startUsecs = startUsecs;
+	event.m_durUsecs = nowUsecs() - startUsecs;
+	event.m_memoryMB = V3Os::memUsageBytes()/1024.0/1024.0;
+	event.m_nodes = 0;
+	event.m_edits = 0;
+	s_events.push_back(event);
+    }
+    static void report(ostream& os) {
+	os<<"{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	os<<"{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+	  <<"\"args\":{\"name\":"<<jsonString("Verilator "+v3Global.opt.prefix())<<"}}";
+	os<<fixed<<setprecision(0);
+	for (EventColl::const_iterator it = s_events.begin(); it != s_events.end(); ++it) {
+	    os<<",\n{\"name\":"<<jsonString(it->m_name)
+	      <<",\"cat\":\""<<(it->m_pass ? "pass" : "step")<<"\""
+	      <<",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+	      <<",\"ts\":"<<it->m_startUsecs<<",\"dur\":"<<it->m_durUsecs
+	      <<",\"args\":{";
+	    if (it->m_pass) os<<"\"nodes\":"<<it->m_nodes<<",\"edits\":"<<it->m_edits<<",";
+	    os<<"\"memory_mb\":"<<setprecision(1)<<it->m_memoryMB<<setprecision(0)<<"}}";
+	    // Counter track so memory growth shows as a graph under the timeline
+	    os<<",\n{\"name\":\"Memory (MB)\",\"ph\":\"C\",\"pid\":1,\"tid\":1"
+	      <<",\"ts\":"<<(it->m_startUsecs + it->m_durUsecs)
+	      <<",\"args\":{\"memory\":"<<setprecision(1)<<it->m_memoryMB<<setprecision(0)<<"}}";
+	}
+	os<<"\n]}\n";
+    }
+};
+
+StatsTrace::EventColl	StatsTrace::s_events;
+double		StatsTrace::s_startUsecs = V3Os::timeUsecs();
+double		StatsTrace::s_lastUsecs = 0;
+vluint64_t	StatsTrace::s_lastEdits = 0;
+
+V3StatsTraceScope::V3StatsTraceScope(const string& name)
+    : m_name(name), m_startUsecs(0) {
+    if (v3Global.opt.statsTrace()) m_startUsecs = StatsTrace::nowUsecs();
+}
+V3StatsTraceScope::~V3StatsTraceScope() {
+    if (v3Global.opt.statsTrace()) StatsTrace::addStep(m_name, m_startUsecs);
+}
+
 //######################################################################
 // V3Statstic class
 
@@ -235,6 +339,17 @@ void V3Stats::statsStage(const string& name) {
 
     double memory = V3Os::memUsageBytes()/1024.0/1024.0;
     V3Stats::addStatPerf("Stage, Memory (MB), "+digitName, memory);
+
+    if (v3Global.opt.statsTrace()) StatsTrace::addPass(name);
+}
+
+void V3Stats::statsTraceReport() {
+    UINFO(2,__FUNCTION__<<": "<<endl);
+    string filename = v3Global.opt.makeDir()+"/"+v3Global.opt.prefix()+"__stats_trace.json";
+    ofstream* ofp (V3File::new_ofstream(filename));
+    if (ofp->fail()) v3fatalSrc("Can't write "<<filename);
+    StatsTrace::report(*ofp);
+    ofp->close(); delete ofp; VL_DANGLING(ofp);
 }
 
 void V3Stats::statsReport() {
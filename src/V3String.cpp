@@ -86,6 +86,20 @@ string VString::quotePercent(const string& str) {
     return out;
 }
 
+void VString::encodeField(string& out, const string& field) {
+    out += cvtToStr(field.length())+":"+field;
+}
+
+bool VString::decodeField(const string& in, size_t& posr, string& fieldr) {
+    size_t colon = in.find(':', posr);
+    if (colon == string::npos) return false;
+    size_t len = atol(in.substr(posr, colon-posr).c_str());
+    if (colon+1+len > in.length()) return false;
+    fieldr = in.substr(colon+1, len);
+    posr = colon+1+len;
+    return true;
+}
+
 //######################################################################
 // VHashSha1
 
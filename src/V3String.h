@@ -36,6 +36,10 @@ public:
     static bool wildmatch(const char* s, const char* p);
     static string downcase(const string& str);
     static string quotePercent(const string& str);
+    // Append a field as "<length>:<bytes>", so it may hold any character
+    static void encodeField(string& out, const string& field);
+    // Read a field written by encodeField at posr, advancing it.  False if malformed.
+    static bool decodeField(const string& in, size_t& posr, string& fieldr);
 };
 
 //######################################################################
@@ -22,6 +22,9 @@
 //	Count # of input bits and # of output bits, and # of statements
 //	If high # of statements relative to inpbits*outbits,
 //	replace with lookup table
+//	Narrow outputs are packed into a single table so one lookup fetches all.
+//	Identical blocks (e.g. each instance of a module) share tables,
+//	and identical table contents are only stored once.
 //
 //*************************************************************************
 
@@ -32,20 +35,25 @@
 #include <unistd.h>
 #include <cmath>
 #include <deque>
+#include <map>
+#include <vector>
 
 #include "V3Global.h"
 #include "V3Table.h"
 #include "V3Simulate.h"
 #include "V3Stats.h"
 #include "V3Ast.h"
+#include "V3Hashed.h"
 
 //######################################################################
 // Table class functions
 
 // CONFIG
-static const double TABLE_MAX_BYTES = 1*1024*1024;	// 1MB is max table size (better be lots of instructs to be worth it!)
+// Maximum single table size is --table-max-bytes
+// Tables beyond --table-cache-bytes in total are presumed to miss in the cache
 static const double TABLE_TOTAL_BYTES = 64*1024*1024;	// 64MB is close to max memory of some systems (256MB or so), so don't get out of control
-static const double TABLE_SPACE_TIME_MULT = 8;		// Worth 8 bytes of data to replace a instruction
+static const double TABLE_SPACE_TIME_MULT = 8;		// Worth 8 bytes of data to replace a instruction, when cached
+static const double TABLE_SPACE_TIME_MULT_UNCACHED = 1;	// Worth 1 byte of data to replace a instruction, when not cached
 static const int TABLE_MIN_NODE_COUNT = 32;	// If < 32 instructions, not worth the effort
 
 //######################################################################
@@ -72,16 +80,40 @@ public:
 class TableVisitor : public AstNVisitor {
 private:
     // NODE STATE
-    // Cleared on each always/assignw
+    // Cleared on each module
+    //  AstInitArray::user4()	-> V3Hash.  Hash of table values, for V3Hashed
+    //AstUser4InUse	part of V3Hashed
+
+    // TYPES
+    struct TableCache {
+	// Tables made from a block, for reuse by identical blocks
+	AstNode*	m_bodysp;	// Clone of the statements the tables were simulated from
+	deque<AstVarScope*> m_inVarps;	// Input variable list
+	deque<AstVarScope*> m_outVarps;	// Output variable list
+	deque<AstVarScope*> m_tableVarps;	// Output tables
+	AstVarScope*	m_chgVscp;	// Change table
+	deque<bool>	m_outNotSet;	// True if output variable is not set at some point
+    };
+    typedef multimap<vector<int>,TableCache*> TableCacheMap;
+    typedef map<pair<AstNodeDType*,int>,AstNodeArrayDType*> TableDTypeMap;
+    typedef map<AstVarScope*,AstVarScope*> VscMap;
 
     // STATE
     double	m_totalBytes;		// Total bytes in tables created
     V3Double0	m_statTablesCre;	// Statistic tracking
+    V3Double0	m_statTablesCompiled;	// Statistic tracking
+    V3Double0	m_statTablesShared;	// Statistic tracking
+    V3Double0	m_statTablesDups;	// Statistic tracking
+    V3Double0	m_statTablesPacked;	// Statistic tracking
+    V3Double0	m_statTablesUncached;	// Statistic tracking
+    TableDTypeMap m_tableDTypes;	// Array dtype for each element type and table depth
 
     //  State cleared on each module
     AstNodeModule*	m_modp;		// Current MODULE
     int			m_modTables;	// Number of tables created in this module
-    deque<AstVarScope*> m_modTableVscs;	// All tables created
+    V3Hashed		m_modTableHashed;	// Values of all tables created
+    map<AstNode*,AstVarScope*> m_modTableInitVscs;	// Table created with each hashed value
+    TableCacheMap	m_modCaches;	// Tables created, by signature of the block they came from
 
     //  State cleared on each scope
     AstScope*	m_scopep;		// Current SCOPE
@@ -93,9 +125,15 @@ private:
     deque<AstVarScope*> m_inVarps;	// Input variable list
     deque<AstVarScope*> m_outVarps;	// Output variable list
     deque<bool>    m_outNotSet;		// True if output variable is not set at some point
+    int		m_packWidth;		// Width of packed output table, or 0 for table per output
+    deque<int>	m_packLsbs;		// LSB of each output in packed table
+    vector<int>	m_cacheKey;		// Signature of block, for finding identical blocks
+    TableCache*	m_cachep;		// Tables of identical block, if any
 
     // When creating a table
     deque<AstVarScope*> m_tableVarps;	// Table being created
+    VscMap	m_sameVscs;		// For sameScopedTree, variable mapping found
+    VscMap	m_sameRevVscs;		// For sameScopedTree, reverse of m_sameVscs
 
     // METHODS
     static int debug() {
@@ -111,6 +149,10 @@ private:
 	m_inVarps.clear();
 	m_outVarps.clear();
 	m_outNotSet.clear();
+	m_packWidth = 0;
+	m_packLsbs.clear();
+	m_cacheKey.clear();
+	m_cachep = NULL;
 
 	// Collect stats
 	TableSimulateVisitor chkvis (this);
@@ -120,42 +162,204 @@ private:
 	// Also sets m_outWidth
 	// Also sets m_inVarps
 	// Also sets m_outVarps
+	if (!m_outWidth || !m_inWidth) {
+	    chkvis.clearOptimizable(nodep,"Table has no outputs");
+	}
+	if (chkvis.optimizable()) {
+	    computePacking(nodep);
+	    m_cacheKey.push_back(chkvis.instrCount());
+	    m_cachep = findCachedTable(nodep);
+	}
 
 	// Calc data storage in bytes
-	size_t chgWidth = m_outVarps.size();	// Width of one change-it-vector
-	if (chgWidth<8) chgWidth = 8;
-	double space = (pow((double)2,((double)(m_inWidth)))
-			*(double)(m_outWidth+chgWidth));
+	double entries = pow((double)2,((double)(m_inWidth)));
+	double outBytes = (m_packWidth
+			   ? nodep->findBitDType(m_packWidth, m_packWidth,
+						 AstNumeric::UNSIGNED)->widthTotalBytes()
+			   : m_outWidth);
+	int chgWidth = m_outVarps.size();	// Width of one change-it-vector
+	double chgBytes = (chgWidth ? nodep->findBitDType(chgWidth, chgWidth,
+							  AstNumeric::UNSIGNED)->widthTotalBytes()
+			   : 0);
+	double space = entries * (outBytes + chgBytes);
+	// The space/time tradeoff keeps its own weighting, unpacked outputs
+	// plus at least 8 per entry, which also covers the lookup's overhead
+	size_t chgWeight = m_outVarps.size();
+	if (chgWeight<8) chgWeight = 8;
+	double tradeSpace = entries * (m_outWidth + chgWeight);
+	// An identical block's tables are reused, so take no more memory
+	double newSpace = m_cachep ? 0 : space;
+	// Once all tables won't fit in the cache, most lookups are misses,
+	// so require more logic be replaced for each byte
+	double spaceTimeMult = TABLE_SPACE_TIME_MULT;
+	if (!m_cachep && (m_totalBytes + newSpace) > v3Global.opt.tableCacheBytes()) {
+	    spaceTimeMult = TABLE_SPACE_TIME_MULT_UNCACHED;
+	}
 	// Instruction count bytes (ok, it's space also not time :)
 	double bytesPerInst = 4;
 	double time  = (chkvis.instrCount()*bytesPerInst + chkvis.dataCount()) + 1;  // +1 so won't div by zero
 	if (chkvis.instrCount() < TABLE_MIN_NODE_COUNT) {
 	    chkvis.clearOptimizable(nodep,"Table has too few nodes involved");
 	}
-	if (space > TABLE_MAX_BYTES) {
+	if (space > v3Global.opt.tableMaxBytes()) {
 	    chkvis.clearOptimizable(nodep,"Table takes too much space");
 	}
-	if (space > time * TABLE_SPACE_TIME_MULT) {
+	if (tradeSpace > time * spaceTimeMult) {
+	    if (chkvis.optimizable() && tradeSpace <= time * TABLE_SPACE_TIME_MULT) {
+		++m_statTablesUncached;  // Would have been made if it fit in the cache
+	    }
 	    chkvis.clearOptimizable(nodep,"Table has bad tradeoff");
 	}
-	if (m_totalBytes > TABLE_TOTAL_BYTES) {
+	if (m_totalBytes + newSpace > TABLE_TOTAL_BYTES) {
 	    chkvis.clearOptimizable(nodep,"Table out of memory");
 	}
-	if (!m_outWidth || !m_inWidth) {
-	    chkvis.clearOptimizable(nodep,"Table has no outputs");
-	}
 	UINFO(4, "  Test: Opt="<<(chkvis.optimizable()?"OK":"NO")
 	      <<", Instrs="<<chkvis.instrCount()<<" Data="<<chkvis.dataCount()
-	      <<" inw="<<m_inWidth<<" outw="<<m_outWidth
-	      <<" Spacetime="<<(space/time)<<"("<<space<<"/"<<time<<")"
+	      <<" inw="<<m_inWidth<<" outw="<<m_outWidth<<" packw="<<m_packWidth
+	      <<" shared="<<(m_cachep?"Y":"N")
+	      <<" Bytes="<<space
+	      <<" Spacetime="<<(tradeSpace/time)<<"("<<tradeSpace<<"/"<<time<<")"
 	      <<": "<<nodep<<endl);
 	if (chkvis.optimizable()) {
-	    UINFO(3, " Table Optimize spacetime="<<(space/time)<<" "<<nodep<<endl);
-	    m_totalBytes += space;
+	    UINFO(3, " Table Optimize spacetime="<<(tradeSpace/time)<<" "<<nodep<<endl);
+	    m_totalBytes += newSpace;
 	}
 	return chkvis.optimizable();
     }
 
+    void computePacking(AstNode* nodep) {
+	// Narrow outputs are packed side by side into one table, so a
+	// single lookup fetches them all and the table has fewer bytes of padding
+	m_packWidth = 0;
+	if (m_outVarps.size() < 2) return;
+	int lsb = 0;
+	for (deque<AstVarScope*>::iterator it = m_outVarps.begin(); it!=m_outVarps.end(); ++it) {
+	    AstVar* varp = (*it)->varp();
+	    if (!varp->dtypeSkipRefp()->castBasicDType() || varp->isDouble()) {
+		m_packLsbs.clear();
+		return;
+	    }
+	    m_packLsbs.push_back(lsb);
+	    lsb += varp->width();
+	}
+	if (lsb > VL_QUADSIZE) {
+	    m_packLsbs.clear();
+	    return;
+	}
+	UINFO(8,"   Packing outputs into width "<<lsb<<endl);
+	m_packWidth = lsb;
+    }
+
+    bool sameScopedTree(AstNode* node1p, AstNode* node2p, bool ignNext) {
+	// As AstNode::sameTree, but variables may differ, as long as each
+	// variable in one tree consistently maps to a single variable in the other.
+	// This finds the same block in each instance of a module, inlined or not.
+	if (!node1p && !node2p) return true;
+	if (!node1p || !node2p) return false;
+	if (node1p->type() != node2p->type()
+	    || node1p->dtypep() != node2p->dtypep()) {
+	    return false;
+	}
+	if (AstVarRef* ref1p = node1p->castVarRef()) {
+	    AstVarRef* ref2p = node2p->castVarRef();
+	    AstVarScope* vsc1p = ref1p->varScopep();
+	    AstVarScope* vsc2p = ref2p->varScopep();
+	    if (!vsc1p || !vsc2p
+		|| ref1p->lvalue() != ref2p->lvalue()
+		|| vsc1p->varp()->dtypep() != vsc2p->varp()->dtypep()) {
+		return false;
+	    }
+	    VscMap::iterator it = m_sameVscs.find(vsc1p);
+	    VscMap::iterator revit = m_sameRevVscs.find(vsc2p);
+	    if (it == m_sameVscs.end() && revit == m_sameRevVscs.end()) {
+		m_sameVscs.insert(make_pair(vsc1p, vsc2p));
+		m_sameRevVscs.insert(make_pair(vsc2p, vsc1p));
+	    } else if (it == m_sameVscs.end() || it->second != vsc2p) {
+		return false;
+	    }
+	} else if (!node1p->same(node2p)) {
+	    return false;
+	}
+	return (sameScopedTree(node1p->op1p(), node2p->op1p(), false)
+		&& sameScopedTree(node1p->op2p(), node2p->op2p(), false)
+		&& sameScopedTree(node1p->op3p(), node2p->op3p(), false)
+		&& sameScopedTree(node1p->op4p(), node2p->op4p(), false)
+		&& (ignNext || sameScopedTree(node1p->nextp(), node2p->nextp(), false)));
+    }
+
+    bool sameVarList(const deque<AstVarScope*>& ours, const deque<AstVarScope*>& theirs) {
+	// Cached block's variables must map in order to ours, so table indexes agree
+	if (ours.size() != theirs.size()) return false;
+	for (size_t i=0; i<ours.size(); ++i) {
+	    VscMap::iterator it = m_sameVscs.find(theirs[i]);
+	    if (it == m_sameVscs.end() || it->second != ours[i]) return false;
+	}
+	return true;
+    }
+
+    TableCache* findCachedTable(AstAlways* nodep) {
+	// Find tables made from an identical block, which we may use too
+	// Key on the variable widths, so most non-identical blocks are never compared
+	for (deque<AstVarScope*>::iterator it = m_inVarps.begin(); it!=m_inVarps.end(); ++it) {
+	    m_cacheKey.push_back((*it)->width());
+	}
+	m_cacheKey.push_back(-1);
+	for (deque<AstVarScope*>::iterator it = m_outVarps.begin(); it!=m_outVarps.end(); ++it) {
+	    m_cacheKey.push_back((*it)->width());
+	}
+	pair<TableCacheMap::iterator,TableCacheMap::iterator> eqrange = m_modCaches.equal_range(m_cacheKey);
+	for (TableCacheMap::iterator eqit = eqrange.first; eqit != eqrange.second; ++eqit) {
+	    TableCache* cachep = eqit->second;
+	    m_sameVscs.clear();
+	    m_sameRevVscs.clear();
+	    bool same = (sameScopedTree(cachep->m_bodysp, nodep->bodysp(), false)
+			 && sameVarList(m_inVarps, cachep->m_inVarps)
+			 && sameVarList(m_outVarps, cachep->m_outVarps));
+	    m_sameVscs.clear();
+	    m_sameRevVscs.clear();
+	    if (same) {
+		UINFO(8,"   Identical block, sharing tables of "<<cachep->m_chgVscp<<endl);
+		return cachep;
+	    }
+	}
+	return NULL;
+    }
+
+    void cacheTable(AstAlways* nodep, AstVarScope* chgVscp) {
+	// Remember tables, before the block is replaced, for later identical blocks
+	TableCache* cachep = new TableCache;
+	cachep->m_bodysp = nodep->bodysp()->cloneTree(true);
+	cachep->m_inVarps = m_inVarps;
+	cachep->m_outVarps = m_outVarps;
+	cachep->m_tableVarps = m_tableVarps;
+	cachep->m_chgVscp = chgVscp;
+	cachep->m_outNotSet = m_outNotSet;
+	m_modCaches.insert(make_pair(m_cacheKey, cachep));
+    }
+
+    void clearCaches() {
+	for (TableCacheMap::iterator it = m_modCaches.begin(); it != m_modCaches.end(); ++it) {
+	    it->second->m_bodysp->deleteTree();
+	    delete it->second;
+	}
+	m_modCaches.clear();
+    }
+
+    AstNodeArrayDType* findTableDType(AstNode* nodep, AstNodeDType* elemDTypep) {
+	// Tables of the same depth and element type share the array type,
+	// so identical tables compare as identical
+	pair<AstNodeDType*,int> key = make_pair(elemDTypep, m_inWidth);
+	TableDTypeMap::iterator it = m_tableDTypes.find(key);
+	if (it != m_tableDTypes.end()) return it->second;
+	FileLine* fl = nodep->fileline();
+	AstNodeArrayDType* dtypep
+	    = new AstUnpackArrayDType (fl, elemDTypep,
+				       new AstRange (fl, VL_MASK_I(m_inWidth), 0));
+	v3Global.rootp()->typeTablep()->addTypesp(dtypep);
+	m_tableDTypes.insert(make_pair(key, dtypep));
+	return dtypep;
+    }
+
 public:
     void simulateVarRefCb(AstVarRef* nodep) {
 	// Called by TableSimulateVisitor on each unique varref enountered
@@ -186,32 +390,39 @@ private:
 	AstVarScope* indexVscp = new AstVarScope (indexVarp->fileline(), m_scopep, indexVarp);
 	m_scopep->addVarp(indexVscp);
 
-	// Change it variable
-	FileLine* fl = nodep->fileline();
-	AstNodeArrayDType* dtypep
-	    = new AstUnpackArrayDType (fl,
-				       nodep->findBitDType(m_outVarps.size(),
-							   m_outVarps.size(), AstNumeric::UNSIGNED),
-				       new AstRange (fl, VL_MASK_I(m_inWidth), 0));
-	v3Global.rootp()->typeTablep()->addTypesp(dtypep);
-	AstVar* chgVarp
-	    = new AstVar (fl, AstVarType::MODULETEMP,
-			  "__Vtablechg" + cvtToStr(m_modTables),
-			  dtypep);
-	chgVarp->isConst(true);
-	chgVarp->valuep(new AstInitArray (nodep->fileline(), dtypep, NULL));
-	m_modp->addStmtp(chgVarp);
-	AstVarScope* chgVscp = new AstVarScope (chgVarp->fileline(), m_scopep, chgVarp);
-	m_scopep->addVarp(chgVscp);
-
-	createTableVars(nodep);
 	AstNode* stmtsp = createLookupInput(nodep, indexVscp);
-	createTableValues(nodep, chgVscp);
-
-	// Collapse duplicate tables
-	chgVscp = findDuplicateTable(chgVscp);
-	for (deque<AstVarScope*>::iterator it = m_tableVarps.begin(); it!=m_tableVarps.end(); ++it) {
-	    *it = findDuplicateTable(*it);
+	AstVarScope* chgVscp;
+	if (m_cachep) {
+	    // Identical block was already simulated, so its tables have our values
+	    ++m_statTablesShared;
+	    chgVscp = m_cachep->m_chgVscp;
+	    m_tableVarps = m_cachep->m_tableVarps;
+	    m_outNotSet = m_cachep->m_outNotSet;
+	} else {
+	    // Change it variable
+	    FileLine* fl = nodep->fileline();
+	    AstNodeArrayDType* dtypep
+		= findTableDType(nodep, nodep->findBitDType(m_outVarps.size(),
+							    m_outVarps.size(), AstNumeric::UNSIGNED));
+	    AstVar* chgVarp
+		= new AstVar (fl, AstVarType::MODULETEMP,
+			      "__Vtablechg" + cvtToStr(m_modTables),
+			      dtypep);
+	    chgVarp->isConst(true);
+	    chgVarp->valuep(new AstInitArray (nodep->fileline(), dtypep, NULL));
+	    m_modp->addStmtp(chgVarp);
+	    chgVscp = new AstVarScope (chgVarp->fileline(), m_scopep, chgVarp);
+	    m_scopep->addVarp(chgVscp);
+
+	    createTableVars(nodep);
+	    createTableValues(nodep, chgVscp);
+
+	    // Collapse duplicate tables
+	    chgVscp = findDuplicateTable(chgVscp);
+	    for (deque<AstVarScope*>::iterator it = m_tableVarps.begin(); it!=m_tableVarps.end(); ++it) {
+		*it = findDuplicateTable(*it);
+	    }
+	    cacheTable(nodep, chgVscp);
 	}
 
 	createOutputAssigns(nodep, stmtsp, indexVscp, chgVscp);
@@ -230,27 +441,42 @@ private:
 	m_tableVarps.clear();
     }
 
+    void createTableVar(AstNode* nodep, const string& name, AstNodeDType* elemDTypep) {
+	FileLine* fl = nodep->fileline();
+	AstNodeArrayDType* dtypep = findTableDType(nodep, elemDTypep);
+	AstVar* tablevarp
+	    = new AstVar (fl, AstVarType::MODULETEMP,
+			  "__Vtable" + cvtToStr(m_modTables) +"_"+name,
+			  dtypep);
+	tablevarp->isConst(true);
+	tablevarp->isStatic(true);
+	tablevarp->valuep(new AstInitArray (nodep->fileline(), dtypep, NULL));
+	m_modp->addStmtp(tablevarp);
+	AstVarScope* tablevscp = new AstVarScope(tablevarp->fileline(), m_scopep, tablevarp);
+	m_scopep->addVarp(tablevscp);
+	m_tableVarps.push_back(tablevscp);
+    }
+
     void createTableVars(AstNode* nodep) {
+	if (m_packWidth) {
+	    // Single table for all outputs
+	    ++m_statTablesPacked;
+	    createTableVar(nodep, "packed",
+			   nodep->findBitDType(m_packWidth, m_packWidth, AstNumeric::UNSIGNED));
+	    return;
+	}
 	// Create table for each output
 	for (deque<AstVarScope*>::iterator it = m_outVarps.begin(); it!=m_outVarps.end(); ++it) {
 	    AstVarScope* outvscp = *it;
 	    AstVar* outvarp = outvscp->varp();
-	    FileLine* fl = nodep->fileline();
-	    AstNodeArrayDType* dtypep
-		= new AstUnpackArrayDType (fl, outvarp->dtypep(),
-					   new AstRange (fl, VL_MASK_I(m_inWidth), 0));
-	    v3Global.rootp()->typeTablep()->addTypesp(dtypep);
-	    AstVar* tablevarp
-		= new AstVar (fl, AstVarType::MODULETEMP,
-			      "__Vtable" + cvtToStr(m_modTables) +"_"+outvarp->name(),
-			      dtypep);
-	    tablevarp->isConst(true);
-	    tablevarp->isStatic(true);
-	    tablevarp->valuep(new AstInitArray (nodep->fileline(), dtypep, NULL));
-	    m_modp->addStmtp(tablevarp);
-	    AstVarScope* tablevscp = new AstVarScope(tablevarp->fileline(), m_scopep, tablevarp);
-	    m_scopep->addVarp(tablevscp);
-	    m_tableVarps.push_back(tablevscp);
+	    // Plain vectors use the shared type of their width, so tables of
+	    // different instances' variables may be found identical
+	    AstNodeDType* elemDTypep = outvarp->dtypep();
+	    if (outvarp->dtypeSkipRefp()->castBasicDType() && !outvarp->isDouble()) {
+		elemDTypep = nodep->findBitDType(outvarp->width(), outvarp->width(),
+						 AstNumeric::UNSIGNED);
+	    }
+	    createTableVar(nodep, outvarp->name(), elemDTypep);
 	}
     }
 
@@ -273,6 +499,20 @@ private:
 	return stmtsp;
     }
 
+    template <class T_Sim> void simulateInputs(AstAlways* nodep, T_Sim& sim, uint32_t inValue) {
+	// Set all inputs to the constant
+	uint32_t shift = 0;
+	for (deque<AstVarScope*>::iterator it = m_inVarps.begin(); it!=m_inVarps.end(); ++it) {
+	    AstVarScope* invscp = *it;
+	    // LSB is first variable, so extract it that way
+	    V3Number* nump = sim.newNumber(invscp, VL_MASK_I(invscp->width()) & (inValue>>shift));
+	    shift += invscp->width();
+	    // We're just using32 bit arithmetic, because there's no way the input table can be 2^32 bytes!
+	    if (shift>31) nodep->v3fatalSrc("shift overflow");
+	    UINFO(8,"   Input "<<invscp->name()<<" = "<<*nump<<endl);
+	}
+    }
+
     void createTableValues(AstAlways* nodep, AstVarScope* chgVscp) {
 	// Create table
 	// There may be a simulation path by which the output doesn't change value.
@@ -283,36 +523,38 @@ private:
 	}
 	uint32_t inValueNextInitArray=0;
 	TableSimulateVisitor simvis (this);
+	// Compile the tree once, rather than walking it for every input value
+	SimulateProgram prog;
+	bool compiled = prog.compileTable(nodep);
+	if (compiled) ++m_statTablesCompiled;
 	for (uint32_t inValue=0; inValue <= VL_MASK_I(m_inWidth); inValue++) {
 	    // Make a new simulation structure so we can set new input values
 	    UINFO(8," Simulating "<<hex<<inValue<<endl);
 
-	    // Above simulateVisitor clears user 3, so
-	    // all outputs default to NULL to mean 'recirculating'.
-	    simvis.clear();
-
-	    // Set all inputs to the constant
-	    uint32_t shift = 0;
-	    for (deque<AstVarScope*>::iterator it = m_inVarps.begin(); it!=m_inVarps.end(); ++it) {
-		AstVarScope* invscp = *it;
-		// LSB is first variable, so extract it that way
-		simvis.newNumber(invscp, VL_MASK_I(invscp->width()) & (inValue>>shift));
-		shift += invscp->width();
-		// We're just using32 bit arithmetic, because there's no way the input table can be 2^32 bytes!
-		if (shift>31) nodep->v3fatalSrc("shift overflow");
-		UINFO(8,"   Input "<<invscp->name()<<" = "<<*(simvis.fetchNumber(invscp))<<endl);
+	    // Simulate, falling back to the visitor if the program can't
+	    bool useProg = compiled;
+	    if (useProg) {
+		prog.clear();
+		simulateInputs(nodep, prog, inValue);
+		useProg = prog.run();
+	    }
+	    if (!useProg) {
+		// Above simulateVisitor clears user 3, so
+		// all outputs default to NULL to mean 'recirculating'.
+		simvis.clear();
+		simulateInputs(nodep, simvis, inValue);
+		simvis.mainTableEmulate(nodep);
+		if (!simvis.optimizable()) simvis.whyNotNodep()->v3fatalSrc("Optimizable cleared, even though earlier test run said not: "<<simvis.whyNotMessage());
 	    }
-
-	    // Simulate
-	    simvis.mainTableEmulate(nodep);
-	    if (!simvis.optimizable()) simvis.whyNotNodep()->v3fatalSrc("Optimizable cleared, even though earlier test run said not: "<<simvis.whyNotMessage());
 
 	    // If a output changed, add it to table
 	    int outnum = 0;
 	    V3Number outputChgMask (nodep->fileline(), m_outVarps.size(), 0);
+	    V3Number packed (nodep->fileline(), m_packWidth ? m_packWidth : 1, 0);
 	    for (deque<AstVarScope*>::iterator it = m_outVarps.begin(); it!=m_outVarps.end(); ++it) {
 		AstVarScope* outvscp = *it;
-		V3Number* outnump = simvis.fetchOutNumberNull(outvscp);
+		V3Number* outnump = (useProg ? prog.fetchOutNumberNull(outvscp)
+				     : simvis.fetchOutNumberNull(outvscp));
 		AstNode* setp;
 		if (!outnump) {
 		    UINFO(8,"   Output "<<outvscp->name()<<" never set\n");
@@ -327,10 +569,19 @@ private:
 		    outputChgMask.setBit(outnum, 1);
 		    setp = new AstConst (outnump->fileline(), *outnump);
 		}
-		// Note InitArray requires us to have the values in inValue order
-		m_tableVarps[outnum]->varp()->valuep()->castInitArray()->addValuep(setp);
+		if (m_packWidth) {
+		    packed.opSelInto(setp->castConst()->num(), m_packLsbs[outnum], outvscp->width());
+		    setp->deleteTree(); VL_DANGLING(setp);
+		} else {
+		    // Note InitArray requires us to have the values in inValue order
+		    m_tableVarps[outnum]->varp()->valuep()->castInitArray()->addValuep(setp);
+		}
 		outnum++;
 	    }
+	    if (m_packWidth) {
+		AstNode* setp = new AstConst (nodep->fileline(), packed);
+		m_tableVarps[0]->varp()->valuep()->castInitArray()->addValuep(setp);
+	    }
 
 	    {   // Set changed table
 		if (inValue != inValueNextInitArray++)
@@ -343,24 +594,19 @@ private:
 
     AstVarScope* findDuplicateTable(AstVarScope* vsc1p) {
 	// See if another table we've created is identical, if so use it for both.
-	// (A more 'modern' way would be to instead use V3Hashed::findDuplicate)
-	AstVar* var1p = vsc1p->varp();
-	for (deque<AstVarScope*>::iterator it = m_modTableVscs.begin(); it!=m_modTableVscs.end(); ++it) {
-	    AstVarScope* vsc2p= *it;
-	    AstVar* var2p = vsc2p->varp();
-	    if (var1p->width() == var2p->width()
-		&& (var1p->dtypep()->arrayUnpackedElements()
-		    == var2p->dtypep()->arrayUnpackedElements())) {
-		AstNode* init1p = var1p->valuep()->castInitArray();
-		AstNode* init2p = var2p->valuep()->castInitArray();
-		if (init1p->sameGateTree(init2p)) {
-		    UINFO(8,"   Duplicate table var "<<vsc2p<<" == "<<vsc1p<<endl);
-		    vsc1p->unlinkFrBack()->deleteTree();
-		    return vsc2p;
-		}
-	    }
+	AstNode* init1p = vsc1p->varp()->valuep()->castInitArray();
+	m_modTableHashed.hash(init1p);
+	V3Hashed::iterator dupit = m_modTableHashed.findDuplicate(init1p);
+	if (dupit != m_modTableHashed.end()) {
+	    AstVarScope* vsc2p = m_modTableInitVscs[m_modTableHashed.iteratorNodep(dupit)];
+	    UINFO(8,"   Duplicate table var "<<vsc2p<<" == "<<vsc1p<<endl);
+	    ++m_statTablesDups;
+	    m_totalBytes -= vsc1p->varp()->dtypep()->widthTotalBytes();
+	    vsc1p->unlinkFrBack()->deleteTree();
+	    return vsc2p;
 	}
-	m_modTableVscs.push_back(vsc1p);
+	m_modTableHashed.hashAndInsert(init1p);
+	m_modTableInitVscs.insert(make_pair(init1p, vsc1p));
 	return vsc1p;
     }
 
@@ -375,8 +621,14 @@ private:
 	    AstVarScope* outvscp = *it;
 	    AstNode* alhsp = new AstVarRef(nodep->fileline(), outvscp, true);
 	    AstNode* arhsp = new AstArraySel(nodep->fileline(),
-					     new AstVarRef(nodep->fileline(), m_tableVarps[outnum], false),
+					     new AstVarRef(nodep->fileline(),
+							   m_tableVarps[m_packWidth ? 0 : outnum],
+							   false),
 					     new AstVarRef(nodep->fileline(), indexVscp, false));
+	    if (m_packWidth) {
+		arhsp = new AstSel(nodep->fileline(), arhsp,
+				   m_packLsbs[outnum], outvscp->width());
+	    }
 	    AstNode* outasnp = (m_assignDly
 				? (AstNode*)(new AstAssignDly (nodep->fileline(), alhsp, arhsp))
 				: (AstNode*)(new AstAssign (nodep->fileline(), alhsp, arhsp)));
@@ -407,7 +659,9 @@ private:
     }
     virtual void visit(AstNodeModule* nodep) {
 	m_modTables = 0;
-	m_modTableVscs.clear();
+	m_modTableHashed.clear();
+	m_modTableInitVscs.clear();
+	clearCaches();
 	m_modp = nodep;
 	nodep->iterateChildren(*this);
 	m_modp = NULL;
@@ -444,11 +698,19 @@ public:
 	m_assignDly = 0;
 	m_inWidth = 0;
 	m_outWidth = 0;
+	m_packWidth = 0;
+	m_cachep = NULL;
 	m_totalBytes = 0;
 	nodep->accept(*this);
     }
     virtual ~TableVisitor() {
+	clearCaches();
 	V3Stats::addStat("Optimizations, Tables created", m_statTablesCre);
+	V3Stats::addStat("Optimizations, Tables simulated compiled", m_statTablesCompiled);
+	V3Stats::addStat("Optimizations, Tables shared", m_statTablesShared);
+	V3Stats::addStat("Optimizations, Tables duplicates removed", m_statTablesDups);
+	V3Stats::addStat("Optimizations, Tables packed", m_statTablesPacked);
+	V3Stats::addStat("Optimizations, Tables over cache size", m_statTablesUncached);
     }
 };
 
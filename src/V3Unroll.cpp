@@ -25,6 +25,10 @@
 //	Look for "FOR" loops and unroll them if <= 32 loops.
 //	(Eventually, a better way would be to simulate the entire loop; ala V3Table.)
 //	Convert remaining FORs to WHILEs
+//	Loops with too many iterations to unroll, but a constant count,
+//	are partially unrolled so the condition is checked less often.
+//	Remaining loops get a temporary index, so it may be made a
+//	local and stay in a register, rather than a member variable.
 //
 //*************************************************************************
 
@@ -42,6 +46,10 @@
 #include "V3Ast.h"
 #include "V3Simulate.h"
 
+// CONFIG
+static const int UNROLL_PARTIAL_COUNT_MULT = 16;	// Count loops to this times --unroll-count for partial unrolling
+static const int UNROLL_PARTIAL_MAX_FACTOR = 8;		// Maximum copies of body in a partially unrolled loop
+
 //######################################################################
 // Unroll state, as a visitor of each AstNode
 
@@ -54,11 +62,15 @@ private:
     AstNode*		m_ignoreIncp;		// Increment node to ignore
     bool		m_varModeCheck;		// Just checking RHS assignments
     bool		m_varModeReplace;	// Replacing varrefs
+    AstVarScope*	m_localVscp;		// Replacing varrefs with this local index
     bool		m_varAssignHit;		// Assign var hit
     bool		m_generate;		// Expand single generate For loop
     string		m_beginName;		// What name to give begin iterations
     V3Double0		m_statLoops;		// Statistic tracking
     V3Double0		m_statIters;		// Statistic tracking
+    V3Double0		m_statPartial;		// Statistic tracking
+    V3Double0		m_statLocalized;	// Statistic tracking
+    int			m_localIdxs;		// Number of loop indexes localized
 
     // METHODS
     static int debug() {
@@ -97,6 +109,81 @@ private:
 	return bodySizeOverRecurse(nodep->nextp(), bodySize, bodyLimit);
     }
 
+    static bool bodyHasRecurse(AstNode* nodep, bool calls) {
+	// True if a jump (or when calls, anything that may see variables
+	// other than through a reference) is under nodep
+	if (!nodep) return false;
+	if (nodep->castJumpGo() || nodep->castJumpLabel()) return true;
+	if (calls && (nodep->castNodeFTaskRef() || nodep->castCCall()
+		      || nodep->castUCFunc() || nodep->castUCStmt())) return true;
+	return (bodyHasRecurse(nodep->op1p(), calls)
+		|| bodyHasRecurse(nodep->op2p(), calls)
+		|| bodyHasRecurse(nodep->op3p(), calls)
+		|| bodyHasRecurse(nodep->op4p(), calls)
+		|| bodyHasRecurse(nodep->nextp(), calls));
+    }
+
+    int partialFactor(AstWhile* whilep, int loops) {
+	// Copies of the body we can place in a loop with 'loops' iterations,
+	// keeping the copies within the statements per iteration a full unroll would allow
+	if (!whilep || whilep->precondsp() || loops < 2) return 1;
+	if (bodyHasRecurse(whilep->bodysp(), false)) return 1;
+	int bodyLimit = v3Global.opt.unrollStmts() / unrollCount();
+	int bodySize = 0;
+	if (bodySizeOverRecurse(whilep->bodysp(), bodySize/*ref*/, bodyLimit/2)
+	    || bodySizeOverRecurse(whilep->incsp(), bodySize/*ref*/, bodyLimit/2)) {
+	    return 1;
+	}
+	for (int factor = UNROLL_PARTIAL_MAX_FACTOR; factor >= 2; factor /= 2) {
+	    if ((loops % factor) == 0 && factor * bodySize <= bodyLimit) return factor;
+	}
+	return 1;
+    }
+
+    void forPartialUnroll(AstWhile* nodep, int factor) {
+	// WHILE(cond, body, inc) -> WHILE(cond, body, inc, body, inc, ...)
+	// The iteration count is a multiple of factor, so the condition
+	// need only be tested before each group of copies.
+	UINFO(4, "   Partial unroll x"<<factor<<" "<<nodep<<endl);
+	AstNode* onep = NULL;
+	if (nodep->bodysp()) onep = AstNode::addNextNull(onep, nodep->bodysp()->unlinkFrBackWithNext());
+	if (nodep->incsp()) onep = AstNode::addNextNull(onep, nodep->incsp()->unlinkFrBackWithNext());
+	if (!onep) return;
+	for (int i=1; i<factor; ++i) nodep->addBodysp(onep->cloneTree(true));
+	nodep->addBodysp(onep);
+	++m_statPartial;
+    }
+
+    void forLocalizeIndex(AstNode* nodep, AstAssign* initAssp) {
+	// A loop that remains: give it an index only it uses, so V3Localize can
+	// make it a local, and put the final value back in the real variable.
+	//   i=init; WHILE(cond(i), body(i))
+	//     -> __Vloopidx=init; WHILE(cond(__Vloopidx), body(__Vloopidx)); i=__Vloopidx;
+	AstWhile* whilep = nodep->castWhile();
+	if (!whilep || !m_forVscp) return;
+	if (m_forVarp->varType() == AstVarType::BLOCKTEMP) return;  // Already a temporary
+	if (bodyHasRecurse(whilep->op1p(), true) || bodyHasRecurse(whilep->op2p(), true)
+	    || bodyHasRecurse(whilep->op3p(), true) || bodyHasRecurse(whilep->op4p(), true)
+	    || bodyHasRecurse(initAssp->rhsp(), true)) {
+	    return;  // Called code may read the variable itself
+	}
+	FileLine* fl = nodep->fileline();
+	AstVar* localVarp = new AstVar(fl, AstVarType::BLOCKTEMP,
+				       "__Vloopidx" + cvtToStr(++m_localIdxs) + "_" + m_forVarp->name(),
+				       m_forVarp);
+	AstScope* scopep = m_forVscp->scopep();
+	scopep->modp()->addStmtp(localVarp);
+	AstVarScope* localVscp = new AstVarScope(fl, scopep, localVarp);
+	scopep->addVarp(localVscp);
+	m_localVscp = localVscp;
+	initAssp->lhsp()->iterateAndNext(*this);  // Not the rhs, which reads the old value
+	whilep->iterateChildren(*this);
+	m_localVscp = NULL;
+	whilep->addNextHere(new AstAssign(fl, new AstVarRef(fl, m_forVscp, true),
+					  new AstVarRef(fl, localVscp, false)));
+	++m_statLocalized;
+    }
+
     bool forUnrollCheck(AstNode* nodep,
 			AstNode* initp,	// Maybe under nodep (no nextp), or standalone (ignore nextp)
 			AstNode* precondsp, AstNode* condp,
@@ -157,22 +244,36 @@ private:
 
 	if (!m_generate) {
 	    AstAssign *incpAssign = incp->castAssign();
-	    if (!canSimulate(incpAssign->rhsp())) return cantUnroll(incp, "Unable to simulate increment");
-	    if (!canSimulate(condp)) return cantUnroll(condp, "Unable to simulate condition");
+	    if (!canSimulate(incpAssign->rhsp())) {
+		forLocalizeIndex(nodep, initAssp);
+		return cantUnroll(incp, "Unable to simulate increment");
+	    }
+	    if (!canSimulate(condp)) {
+		forLocalizeIndex(nodep, initAssp);
+		return cantUnroll(condp, "Unable to simulate condition");
+	    }
 
 	    // Check whether to we actually want to try and unroll.
+	    // Count further than we'd unroll, in case we can partially unroll.
 	    int loops;
-	    if (!countLoops(initAssp, condp, incp, unrollCount(), loops))
+	    if (!countLoops(initAssp, condp, incp, unrollCount()*UNROLL_PARTIAL_COUNT_MULT, loops)) {
+		forLocalizeIndex(nodep, initAssp);
 		return cantUnroll(nodep, "Unable to simulate loop");
+	    }
 
 	    // Less than 10 statements in the body?
 	    int bodySize = 0;
 	    int bodyLimit = v3Global.opt.unrollStmts();
 	    if (loops>0) bodyLimit = v3Global.opt.unrollStmts() / loops;
-	    if (bodySizeOverRecurse(precondsp, bodySize/*ref*/, bodyLimit)
-		|| bodySizeOverRecurse(bodysp, bodySize/*ref*/, bodyLimit)
-		|| bodySizeOverRecurse(incp, bodySize/*ref*/, bodyLimit)) {
-		return cantUnroll(nodep, "too many statements");
+	    bool tooBig = (bodySizeOverRecurse(precondsp, bodySize/*ref*/, bodyLimit)
+			   || bodySizeOverRecurse(bodysp, bodySize/*ref*/, bodyLimit)
+			   || bodySizeOverRecurse(incp, bodySize/*ref*/, bodyLimit));
+	    if (tooBig || loops > unrollCount()) {
+		// Too much code to fully unroll, keep as a loop
+		int factor = partialFactor(nodep->castWhile(), loops);
+		if (factor > 1) forPartialUnroll(nodep->castWhile(), factor);
+		forLocalizeIndex(nodep, initAssp);
+		return cantUnroll(nodep, tooBig ? "too many statements" : "too many iterations");
 	    }
 	}
 	// Finally, we can do it
@@ -209,15 +310,21 @@ private:
 	    tempp = NULL;
 	    pushDeletep(m_varValuep); m_varValuep = NULL;
 	}
+	// Fetch the result
+	SimulateProgram prog;
 	SimulateVisitor simvis;
-	simvis.mainParamEmulate(clone);
-	if (!simvis.optimizable()) {
-	    UINFO(3, "Unable to simulate" << endl);
-	    if (debug()>=9) nodep->dumpTree(cout,"- _simtree: ");
-	    return false;
+	V3Number* res = NULL;
+	if (prog.compileParam(clone) && prog.run()) {
+	    res = prog.fetchNumberNull(clone);
+	} else {
+	    simvis.mainParamEmulate(clone);
+	    if (!simvis.optimizable()) {
+		UINFO(3, "Unable to simulate" << endl);
+		if (debug()>=9) nodep->dumpTree(cout,"- _simtree: ");
+		return false;
+	    }
+	    res = simvis.fetchNumberNull(clone);
 	}
-	// Fetch the result
-	V3Number* res = simvis.fetchNumberNull(clone);
 	if (!res) {
 	    UINFO(3, "No number returned from simulation" << endl);
 	    return false;
@@ -361,7 +468,7 @@ private:
 
     virtual void visit(AstWhile* nodep) {
 	nodep->iterateChildren(*this);
-	if (m_varModeCheck || m_varModeReplace) {
+	if (m_varModeCheck || m_varModeReplace || m_localVscp) {
 	} else {
 	    // Constify before unroll call, as it may change what is underneath.
 	    if (nodep->precondsp()) V3Const::constifyEdit(nodep->precondsp());  // precondsp may change
@@ -441,6 +548,14 @@ private:
 	    nodep->replaceWith(newconstp);
 	    pushDeletep(nodep);
 	}
+
+	if (m_localVscp
+	    && nodep->varp() == m_forVarp
+	    && nodep->varScopep() == m_forVscp) {
+	    AstNode* newp = new AstVarRef(nodep->fileline(), m_localVscp, nodep->lvalue());
+	    nodep->replaceWith(newp);
+	    pushDeletep(nodep);
+	}
     }
 
     //--------------------
@@ -461,6 +576,8 @@ public:
 	m_ignoreIncp = NULL;
 	m_varModeCheck = false;
 	m_varModeReplace = false;
+	m_localVscp = NULL;
+	m_localIdxs = 0;
 	m_generate = generate;
 	m_beginName = beginName;
 	//
@@ -469,6 +586,8 @@ public:
     virtual ~UnrollVisitor() {
 	V3Stats::addStatSum("Optimizations, Unrolled Loops", m_statLoops);
 	V3Stats::addStatSum("Optimizations, Unrolled Iterations", m_statIters);
+	V3Stats::addStatSum("Optimizations, Unrolled Loops Partially", m_statPartial);
+	V3Stats::addStatSum("Optimizations, Loop Indexes Localized", m_statLocalized);
     }
 };
 
@@ -28,6 +28,7 @@
 #include "V3Assert.h"
 #include "V3AssertPre.h"
 #include "V3Begin.h"
+#include "V3BitParallel.h"
 #include "V3Branch.h"
 #include "V3Case.h"
 #include "V3Cast.h"
@@ -39,6 +40,7 @@
 #include "V3Const.h"
 #include "V3Coverage.h"
 #include "V3CoverageJoin.h"
+#include "V3Cse.h"
 #include "V3CCtors.h"
 #include "V3Dead.h"
 #include "V3Delayed.h"
@@ -75,10 +77,12 @@
 #include "V3ParseSym.h"
 #include "V3PreShell.h"
 #include "V3Premit.h"
+#include "V3ProfFeedback.h"
 #include "V3Scope.h"
 #include "V3Slice.h"
 #include "V3Split.h"
 #include "V3SplitAs.h"
+#include "V3SplitVar.h"
 #include "V3Stats.h"
 #include "V3String.h"
 #include "V3Subst.h"
@@ -118,6 +122,7 @@ void V3Global::readFiles() {
     V3InFilter filter (v3Global.opt.pipeFilter());
     V3ParseSym parseSyms (v3Global.rootp());  // Symbol table must be common across all parsing
 
+    V3StatsTraceScope trace ("readFiles");
     V3Parse parser (v3Global.rootp(), &filter, &parseSyms);
     // Read top module
     const V3StringList& vFiles = v3Global.opt.vFiles();
@@ -346,6 +351,11 @@ void process () {
 	    V3TraceDecl::traceDeclAll(v3Global.rootp());
 	}
 
+	// Split variables assigned as separate bit ranges, so ordering sees each range
+	if (v3Global.opt.oSplitVar()) {
+	    V3SplitVar::splitVarAll(v3Global.rootp());
+	}
+
 	// Gate-based logic elimination; eliminate signals and push constant across cell boundaries
 	// Instant propagation makes lots-o-constant reduction possibilities.
 	if (v3Global.opt.oGate()) {
@@ -412,6 +422,16 @@ void process () {
 	V3Const::constifyAll(v3Global.rootp());
 	V3Dead::deadifyAllScoped(v3Global.rootp());
 
+	// Convert per-lane logic, before change detection copies the lane signals
+	if (v3Global.opt.bitParallel() || v3Global.opt.batch()) {
+	    V3BitParallel::bitParallelAll(v3Global.rootp());
+	}
+
+	// Share repeated expressions within each function
+	if (v3Global.opt.oCse()) {
+	    V3Cse::cseAll(v3Global.rootp());
+	}
+
 	// Detect change loop
 	V3Changed::changedAll(v3Global.rootp());
 
@@ -445,6 +465,11 @@ void process () {
 	if (v3Global.opt.oCombine()) {
 	    V3Combine::combineAll(v3Global.rootp());
 	}
+
+	// Count function calls, or use counts from a previous run, now functions are final
+	if (v3Global.opt.profFeedbackGen() != "" || v3Global.opt.profFeedbackUse() != "") {
+	    V3ProfFeedback::profFeedbackAll(v3Global.rootp());
+	}
     }
 
     V3Error::abortIfErrors();
@@ -610,6 +635,7 @@ int main(int argc, char** argv, char** env) {
     // Final steps
     V3Global::dumpCheckGlobalTree("final", 990, v3Global.opt.dumpTreeLevel(__FILE__) >= 3);
     V3Error::abortIfWarnings();
+    if (v3Global.opt.statsTrace()) V3Stats::statsTraceReport();
 
     if (!v3Global.opt.lintOnly() && !v3Global.opt.cdc()
 	&& v3Global.opt.makeDepend()) {
@@ -0,0 +1,72 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+#include <verilated.h>
+#include "Vt_batch.h"
+
+// Scalar reference model of t_batch.v, one per lane
+struct Ref {
+    IData acc, flag, mem[4], wide[3];
+    void posedge(int rst, IData a, IData b) {
+	if (rst) {
+	    acc = 0; flag = 0;
+	    for (int i=0; i<4; i++) mem[i] = 0;
+	    for (int i=0; i<3; i++) wide[i] = 0;
+	    return;
+	}
+	IData oacc = acc;
+	if (a > b) acc = oacc + a;
+	else acc = oacc ^ (b<<24 | a<<16 | b<<8 | a);
+	flag = ((oacc & 0xf) == 5);
+	mem[a & 3] = b;
+	wide[2] = wide[1]; wide[1] = wide[0]; wide[0] = oacc;
+    }
+};
+
+static vluint32_t seed = 0x5aef0c8d;
+static IData random8() {
+    seed = seed * 1103515245 + 12345;
+    return (seed >> 16) & 0xff;
+}
+
+int main (int argc, char *argv[]) {
+    Vt_batch* topp = new Vt_batch;
+    Ref refs[Vt_batch::BATCH];
+
+    Verilated::debug(0);
+
+    topp->clk = 0;
+    for (int cyc = 0; cyc < 200; cyc++) {
+	for (int lane = 0; lane < Vt_batch::BATCH; lane++) {
+	    // All lanes start in reset, then each lane gets its own stimulus
+	    topp->rst[lane] = (cyc < 2) || (random8() < 8);
+	    topp->a[lane] = random8();
+	    topp->b[lane] = random8();
+	}
+	topp->eval();
+	topp->clk = 1;
+	topp->eval();
+	for (int lane = 0; lane < Vt_batch::BATCH; lane++) {
+	    IData a = topp->a[lane];
+	    IData b = topp->b[lane];
+	    Ref& ref = refs[lane];
+	    ref.posedge(topp->rst[lane], a, b);
+	    if (topp->sum[lane] != a + b
+		|| topp->acc[lane] != ref.acc
+		|| topp->flag[lane] != ref.flag
+		|| topp->m[lane] != ref.mem[b & 3]
+		|| topp->w[lane] != ref.wide[2]) {
+		vl_fatal(__FILE__,__LINE__,"top", "Lane mismatch with reference model\n");
+	    }
+	}
+	topp->clk = 0;
+	topp->eval();
+    }
+    topp->final();
+    delete topp;
+    printf ("*-* All Finished *-*\n");
+}
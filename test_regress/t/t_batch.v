@@ -0,0 +1,46 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   sum, acc, flag, m, w,
+   // Inputs
+   clk, rst, a, b
+   );
+   input clk;
+   input rst;
+   input [7:0] a;
+   input [7:0] b;
+   output [8:0] sum;
+   output reg [31:0] acc;
+   output reg flag;
+   output [7:0] m;
+   output [31:0] w;
+
+   reg [7:0] mem [0:3];
+   reg [95:0] wide;
+   integer i;
+
+   assign sum = a + b;
+   assign m = mem[b[1:0]];
+   assign w = wide[95:64];
+
+   always @ (posedge clk) begin
+      if (rst) begin
+	 acc <= 32'h0;
+	 flag <= 1'b0;
+	 wide <= 96'h0;
+	 for (i=0; i<4; i=i+1) mem[i] <= 8'h0;
+      end
+      else begin
+	 if (a > b) acc <= acc + {24'h0, a};
+	 else acc <= acc ^ {b, a, b, a};
+	 flag <= (acc[3:0] == 4'h5);
+	 mem[a[1:0]] <= b;
+	 wide <= {wide[63:0], acc};
+      end
+   end
+
+endmodule
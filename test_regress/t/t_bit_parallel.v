@@ -0,0 +1,37 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   q, y,
+   // Inputs
+   clk, rst, a, b
+   );
+   input clk;
+   input rst;
+   input a;
+   input b;
+   output reg q;
+   output y;
+
+   reg s0;
+   reg s1;
+
+   always @ (posedge clk) begin
+      if (rst) begin
+	 s0 <= 1'b0;
+	 s1 <= 1'b0;
+	 q <= 1'b0;
+      end
+      else begin
+	 if (a) s0 <= ~s0;
+	 else if (b) s1 <= s0 ^ s1;
+	 q <= (s0 && !s1) || (a == b);
+      end
+   end
+
+   assign y = s1 ? a : b;
+
+endmodule
@@ -0,0 +1,67 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc=0;
+   reg [63:0] crc;
+
+   // Sparse opcodes, wide enough the case can't be made into a bit tree
+   wire [31:0] op = {crc[3:0], 24'h0, crc[7:4]};
+
+   reg [3:0] dec;
+   always @* begin
+      case (op)
+	32'h0000_0000: dec = 4'd1;
+	32'h0000_0001,
+	32'h0000_0002,
+	32'h0000_0003: dec = 4'd2;
+	32'h1000_0000: dec = 4'd3;
+	32'h1000_0005: dec = 4'd4;
+	32'h2000_000f: dec = 4'd5;
+	32'h3000_0007: dec = 4'd6;
+	32'h3000_0008: dec = 4'd7;
+	32'h8000_0004,
+	32'h9000_0004: dec = 4'd8;
+	32'hf000_000e: dec = 4'd9;
+	32'hf000_000f: dec = 4'd10;
+	default: dec = 4'd0;
+      endcase
+   end
+
+   function [3:0] dec_chain (input [31:0] v);
+      if (v == 32'h0000_0000) dec_chain = 4'd1;
+      else if (v >= 32'h0000_0001 && v <= 32'h0000_0003) dec_chain = 4'd2;
+      else if (v == 32'h1000_0000) dec_chain = 4'd3;
+      else if (v == 32'h1000_0005) dec_chain = 4'd4;
+      else if (v == 32'h2000_000f) dec_chain = 4'd5;
+      else if (v == 32'h3000_0007) dec_chain = 4'd6;
+      else if (v == 32'h3000_0008) dec_chain = 4'd7;
+      else if (v == 32'h8000_0004 || v == 32'h9000_0004) dec_chain = 4'd8;
+      else if (v == 32'hf000_000e) dec_chain = 4'd9;
+      else if (v == 32'hf000_000f) dec_chain = 4'd10;
+      else dec_chain = 4'd0;
+   endfunction
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x op=%x dec=%x\n",$time, cyc, crc, op, dec);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      if (dec !== dec_chain(op)) $stop;
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else if (cyc==99) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,88 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc; initial cyc = 0;
+
+   wire       en = cyc[0] ^ cyc[2];
+   // Enable straight from a flop, must be sampled before its update
+   reg	      ren; initial ren = 1'b0;
+
+   // Bank of flops sharing one enable
+   reg [7:0]  a;
+   reg [7:0]  b;
+   reg [7:0]  c;
+   reg [31:0] d;
+   // Ungated flop in the same block
+   reg [7:0]  e;
+   // Second bank on the registered enable
+   reg [7:0]  f;
+   reg [7:0]  g;
+   initial begin
+      a = 8'h0; b = 8'h0; c = 8'h0; d = 32'h0; e = 8'h0;
+      f = 8'h0; g = 8'h0;
+   end
+
+   always @ (posedge clk) begin
+      if (en) begin
+	 a <= a + 8'h1;
+	 b <= a;
+	 c <= b ^ 8'h5a;
+	 d <= d + {24'h0, c};
+      end
+      e <= e + 8'h3;
+   end
+
+   always @ (posedge clk) begin
+      ren <= cyc[1];
+      if (ren) begin
+	 f <= f + 8'h7;
+	 g <= f;
+      end
+   end
+
+   // Reference model without any IF to gate
+   reg [7:0]  ra;
+   reg [7:0]  rb;
+   reg [7:0]  rc;
+   reg [31:0] rd;
+   reg [7:0]  re;
+   reg [7:0]  rf;
+   reg [7:0]  rg;
+   initial begin
+      ra = 8'h0; rb = 8'h0; rc = 8'h0; rd = 32'h0; re = 8'h0;
+      rf = 8'h0; rg = 8'h0;
+   end
+
+   always @ (posedge clk) begin
+      ra <= en ? ra + 8'h1 : ra;
+      rb <= en ? ra : rb;
+      rc <= en ? rb ^ 8'h5a : rc;
+      rd <= en ? rd + {24'h0, rc} : rd;
+      re <= re + 8'h3;
+      rf <= ren ? rf + 8'h7 : rf;
+      rg <= ren ? rf : rg;
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d en=%x a=%x b=%x c=%x d=%x e=%x ren=%x f=%x g=%x\n",
+	     $time, cyc, en, a, b, c, d, e, ren, f, g);
+`endif
+      if (a !== ra || b !== rb || c !== rc || d !== rd || e !== re) $stop;
+      if (f !== rf || g !== rg) $stop;
+      if (cyc == 99) begin
+	 if (d == 32'h0 || f == 8'h0) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
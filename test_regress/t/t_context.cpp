@@ -0,0 +1,57 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+#include <verilated.h>
+#include "Vt_context.h"
+
+// Two models, each with its own context, evaluated in turn.  Neither
+// model's $finish or $random may be seen by the other.
+
+static void tick(Vt_context* topp) {
+    topp->clk = 1;
+    topp->eval();
+    topp->clk = 0;
+    topp->eval();
+}
+
+int main (int argc, char *argv[]) {
+    VerilatedContext* actxp = new VerilatedContext;
+    VerilatedContext* bctxp = new VerilatedContext;
+    Vt_context* ap = new Vt_context("a", actxp);
+    Vt_context* bp = new Vt_context("b", bctxp);
+
+    Verilated::debug(0);
+
+    ap->limit = 10;
+    bp->limit = 20;
+    ap->clk = 0;
+    bp->clk = 0;
+    for (int cyc = 0; cyc < 10; ++cyc) {
+	tick(ap);
+	tick(bp);
+	if (ap->rnd != bp->rnd) vl_fatal(__FILE__,__LINE__,"top", "Contexts share $random state\n");
+    }
+    // Model a finished only its own context
+    tick(ap);
+    if (!actxp->gotFinish()) vl_fatal(__FILE__,__LINE__,"top", "Model a did not $finish\n");
+    if (bctxp->gotFinish()) vl_fatal(__FILE__,__LINE__,"top", "Model a $finish seen by b\n");
+    if (Verilated::defaultContextp()->gotFinish()) {
+	vl_fatal(__FILE__,__LINE__,"top", "Model a $finish seen by default context\n");
+    }
+    int bticks = 10;
+    while (!bctxp->gotFinish() && bticks < 100) { tick(bp); ++bticks; }
+    if (bticks != 21) vl_fatal(__FILE__,__LINE__,"top", "Model b did not $finish on time\n");
+
+    ap->final();
+    bp->final();
+    delete ap;
+    delete bp;
+    delete actxp;
+    delete bctxp;
+    printf ("*-* All Finished *-*\n");
+    return 0;
+}
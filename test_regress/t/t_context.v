@@ -0,0 +1,25 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   rnd,
+   // Inputs
+   clk, limit
+   );
+   input clk;
+   input [31:0] limit;
+   output reg [31:0] rnd;
+
+   integer cyc=0;
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      rnd <= $random;
+      if (cyc == limit) begin
+	 $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,89 @@
+// -*- mode: C++; c-file-style: "cc-mode" -*-
+//
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+#include <verilated.h>
+#include <pthread.h>
+#include "Vt_context.h"
+
+// Two models, each with its own context, evaluated at the same time on
+// separate threads.  Each must see only its own $finish and $random.
+
+#define CYCLES_MAX 40000
+
+struct ThreadData {
+    Vt_context*		m_topp;
+    VerilatedContext*	m_contextp;
+    unsigned		m_ticks;
+    bool		m_currentOk;	// Current context was always our own
+    IData		m_rnds[CYCLES_MAX];
+};
+
+static pthread_barrier_t s_startBarrier;
+
+static void* runModel(void* argp) {
+    ThreadData* datap = static_cast<ThreadData*>(argp);
+    Vt_context* topp = datap->m_topp;
+    // Start both threads together, so the models evaluate concurrently
+    pthread_barrier_wait(&s_startBarrier);
+    while (!datap->m_contextp->gotFinish() && datap->m_ticks < CYCLES_MAX) {
+	topp->clk = 1;
+	topp->eval();
+	topp->clk = 0;
+	topp->eval();
+	if (Verilated::contextp() != datap->m_contextp) datap->m_currentOk = false;
+	datap->m_rnds[datap->m_ticks++] = topp->rnd;
+    }
+    return NULL;
+}
+
+static void setup(ThreadData* datap, const char* namep, unsigned limit) {
+    datap->m_contextp = new VerilatedContext;
+    datap->m_topp = new Vt_context(namep, datap->m_contextp);
+    datap->m_topp->limit = limit;
+    datap->m_topp->clk = 0;
+    datap->m_ticks = 0;
+    datap->m_currentOk = true;
+}
+
+int main (int argc, char *argv[]) {
+    static ThreadData a;
+    static ThreadData b;
+    // Models are constructed and destroyed one at a time, on this thread
+    setup(&a, "a", 20000);
+    setup(&b, "b", 30000);
+
+    pthread_barrier_init(&s_startBarrier, NULL, 2);
+    pthread_t athread;
+    pthread_t bthread;
+    pthread_create(&athread, NULL, runModel, &a);
+    pthread_create(&bthread, NULL, runModel, &b);
+    pthread_join(athread, NULL);
+    pthread_join(bthread, NULL);
+    pthread_barrier_destroy(&s_startBarrier);
+
+    if (!a.m_currentOk || !b.m_currentOk) {
+	vl_fatal(__FILE__,__LINE__,"top", "Thread saw another model's context\n");
+    }
+    if (a.m_ticks != 20001) vl_fatal(__FILE__,__LINE__,"top", "Model a did not $finish on time\n");
+    if (b.m_ticks != 30001) vl_fatal(__FILE__,__LINE__,"top", "Model b did not $finish on time\n");
+    if (Verilated::defaultContextp()->gotFinish()) {
+	vl_fatal(__FILE__,__LINE__,"top", "Model $finish seen by default context\n");
+    }
+    // Same seeds, so the sequences match unless $random state was shared
+    for (unsigned i = 0; i < a.m_ticks; ++i) {
+	if (a.m_rnds[i] != b.m_rnds[i]) vl_fatal(__FILE__,__LINE__,"top", "Contexts share $random state\n");
+    }
+
+    a.m_topp->final();
+    b.m_topp->final();
+    delete a.m_topp;
+    delete b.m_topp;
+    delete a.m_contextp;
+    delete b.m_contextp;
+    printf ("*-* All Finished *-*\n");
+    return 0;
+}
@@ -0,0 +1,62 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc; initial crc = 64'h5aef0c8d_d70a4497;
+
+   reg [31:0] 	sum;
+   reg [31:0] 	sumx;
+   reg [31:0] 	shr;
+   reg [31:0] 	shrx;
+   reg [31:0] 	a;
+   reg [31:0] 	pre;
+   reg [31:0] 	post;
+   reg [63:0] 	chk; initial chk = 64'h0;
+
+   // What checksum we will end up with, from an independent model
+`define EXPECTED_SUM 64'h813b7d2e0cc31e47
+
+   // Same decode computed by several assignments
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      sum <= ((crc[31:0] ^ crc[63:32]) + 32'h1234) & ~crc[47:16];
+      sumx <= (((crc[31:0] ^ crc[63:32]) + 32'h1234) & ~crc[47:16]) ^ 32'h5;
+      shr <= ((crc[31:0] ^ crc[63:32]) + 32'h1234) >> 3;
+      // A blocking write to an operand between two copies of an expression
+      a = crc[31:0];
+      pre = ((a ^ crc[63:32]) + 32'h1234) >> 3;
+      a = a ^ 32'h00ff00ff;
+      post = ((a ^ crc[63:32]) + 32'h1234) >> 3;
+      if ((((crc[31:0] ^ crc[63:32]) + 32'h1234) >> 3) != 32'h0) begin
+	 shrx <= ((crc[31:0] ^ crc[63:32]) + 32'h1234) >> 3;
+      end
+      else begin
+	 shrx <= 32'h0;
+      end
+      if (cyc != 0) begin
+`ifdef TEST_VERBOSE
+	 $write("[%0t] cyc=%0d sum=%x shr=%x pre=%x post=%x\n",$time, cyc, sum, shr, pre, post);
+`endif
+	 if (sum != (sumx ^ 32'h5)) $stop;
+	 if (shr != shrx) $stop;
+	 chk <= {chk[62:0], chk[63]^chk[2]^chk[0]} ^ {sum, shr} ^ {pre, post};
+      end
+      if (cyc == 99) begin
+	 $write("[%0t] cyc=%0d chk=%x\n",$time, cyc, chk);
+	 if (chk !== `EXPECTED_SUM) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,57 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Outputs
+   out,
+   // Inputs
+   clk
+   );
+
+   input clk;
+   output reg [31:0] out;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc;
+
+   // Two clock domains feeding one combo block
+   reg	      div_clk;
+   reg [31:0] a;
+   reg [31:0] b;
+
+   always @ (posedge div_clk) begin
+      b <= b + crc[63:32];
+   end
+
+   always @* begin
+      out = (a * b) ^ (a + b) ^ {a[15:0], b[31:16]};
+      if (a[0]) out = out + {b[7:0], a[31:8]};
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      div_clk <= cyc[2];
+      if (cyc[1:0] == 2'd0) a <= crc[31:0];
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+	 a <= 32'h0;
+	 b <= 32'h0;
+      end
+      else if (cyc > 2 && cyc < 99) begin
+	 if (out !== (a[0] ? (((a * b) ^ (a + b) ^ {a[15:0], b[31:16]}) + {b[7:0], a[31:8]})
+		      : ((a * b) ^ (a + b) ^ {a[15:0], b[31:16]}))) begin
+	    $write("%%Error: cyc=%0d a=%x b=%x out=%x\n", cyc, a, b, out);
+	    $stop;
+	 end
+      end
+      else if (cyc==99) begin
+	 $write("[%0t] cyc==%0d crc=%x out=%x\n",$time, cyc, crc, out);
+	 if (crc !== 64'hc77bb9b3784ea091) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
@@ -0,0 +1,25 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+compile (
+    verilator_flags2 => ["--stats"],
+    );
+
+execute (
+    check_finished=>1,
+    );
+
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats.txt", qr/EmitC, Hot members\s+[1-9]/);
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/v__DOT__crc,[\s\S]*COLD SIGNALS AND VARIABLES/);
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}.h", qr/COLD SIGNALS AND VARIABLES[\s\S]*v__DOT__init_i,[\s\S]*v__DOT__mem\[/);
+
+ok(1);
+1;
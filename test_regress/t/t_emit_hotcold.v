@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc;
+   reg [31:0] sum;
+
+   // Memory and initial-only loop variable belong in the cold section
+   reg [31:0] mem [0:255];
+   integer    init_i;
+   initial begin
+      for (init_i = 0; init_i < 256; init_i = init_i + 1) begin
+	 mem[init_i] = init_i * 32'h01010101;
+      end
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      sum <= sum ^ mem[crc[7:0]];
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+	 sum <= 32'h0;
+      end
+      else if (cyc==99) begin
+	 $write("[%0t] cyc==%0d crc=%x sum=%x\n",$time, cyc, crc, sum);
+	 if (crc !== 64'hc77bb9b3784ea091) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
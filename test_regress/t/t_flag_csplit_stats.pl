@@ -0,0 +1,27 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_flag_csplit.v");
+
+compile (
+    v_flags2 => ["--output-split 10 --stats"],
+    );
+
+execute (
+    check_finished=>1,
+    );
+
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats_split.txt", qr/Split Cost Report/);
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats_split.txt", qr/$Self->{VM_PREFIX}__1\.cpp/);
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats.txt", qr/EmitC, Split files\s+(\d+)/);
+
+ok(1);
+1;
@@ -0,0 +1,58 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_flag_csplit.v");
+
+my $serial_dir = "$Self->{obj_dir}_serial";
+mkdir $serial_dir;
+
+# Emit the same model serially, to compare against
+{
+    my @cmdargs = $Self->compile_vlt_flags
+	(verilator_flags => ["-cc", "-Mdir", "${serial_dir}", "-OD", "--debug-check"],
+	 v_flags2 => ["--output-split 1 --output-split-cfuncs 1 --output-jobs 1"],
+	);
+
+    $Self->_run(logfile=>"${serial_dir}/vlt_compile.log",
+		cmd=>\@cmdargs);
+}
+
+compile (
+    v_flags2 => ["--output-split 1 --output-split-cfuncs 1 --output-jobs 4"],
+    );
+
+execute (
+    check_finished=>1,
+    );
+
+my $got1;
+foreach my $file (glob("$Self->{obj_dir}/*.cpp")) {
+    $got1 = 1 if $file =~ /__1/;
+}
+$got1 or $Self->error("No __1 split file found");
+
+# Each emitted file must also be in the makefile's class list
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}_classes.mk", qr/$Self->{VM_PREFIX}__1/);
+
+# Parallel emission must produce exactly the serial sources
+foreach my $file (glob("${serial_dir}/*.cpp ${serial_dir}/*.h")) {
+    (my $base = $file) =~ s!.*/!!;
+    files_identical("$Self->{obj_dir}/$base", $file)
+	or $Self->error("Parallel output differs from serial for $base");
+}
+foreach my $file (glob("$Self->{obj_dir}/$Self->{VM_PREFIX}*.cpp $Self->{obj_dir}/$Self->{VM_PREFIX}*.h")) {
+    (my $base = $file) =~ s!.*/!!;
+    next if $base =~ /__main\.cpp$/;  # Made by the driver, not Verilator
+    -r "${serial_dir}/$base" or $Self->error("Parallel output has extra file $base");
+}
+
+ok(1);
+1;
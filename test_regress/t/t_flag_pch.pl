@@ -0,0 +1,35 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_flag_csplit.v");
+
+compile (
+    v_flags2 => ["--trace --output-split 1"],
+    make_flags => 'VM_PARALLEL_BUILDS=1',
+    );
+
+execute (
+    check_finished=>1,
+    );
+
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__pch.h", qr/#include "$Self->{VM_PREFIX}__Syms.h"/);
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}_classes.mk", qr/VM_PCH_H = $Self->{VM_PREFIX}__pch.h/);
+
+# When configure found the compiler can precompile, the build must have used it
+if (file_contents("$ENV{VERILATOR_ROOT}/include/verilated.mk") =~ /^CFG_CXXFLAGS_PCH\s*=\s*\S/m) {
+    foreach my $gch ("$Self->{obj_dir}/$Self->{VM_PREFIX}__pch.h.fast.gch",
+		     "$Self->{obj_dir}/$Self->{VM_PREFIX}__pch.h.slow.gch") {
+	-s $gch or $Self->error("Precompiled header not built: $gch");
+    }
+}
+
+ok(1);
+1;
@@ -0,0 +1,43 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_pp_lib.v");
+
+my $cache = "$Self->{obj_dir}/preproc_cache";
+
+compile (
+    v_flags2 => ['-v', 't/t_pp_lib_library.v', "--preproc-cache $cache"],
+    );
+
+my @entries = glob("$cache/*.vpc");
+@entries or $Self->error("No preprocessor cache entries in $cache");
+
+# Different arguments so --skip-identical doesn't bypass the second run
+compile (
+    v_flags2 => ['-v', 't/t_pp_lib_library.v', "--preproc-cache $cache", "--stats"],
+    );
+
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats.txt", qr/Preprocess, Cache hits\s+[1-9]/);
+
+# --relative-includes may resolve `includes differently, so it must not reuse entries
+compile (
+    v_flags2 => ['-v', 't/t_pp_lib_library.v', "--preproc-cache $cache", "--relative-includes"],
+    );
+
+my @relEntries = glob("$cache/*.vpc");
+($#relEntries > $#entries) or $Self->error("--relative-includes reused preprocessor cache entries");
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
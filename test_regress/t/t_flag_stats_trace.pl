@@ -0,0 +1,25 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_flag_csplit.v");
+
+compile (
+    v_flags2 => ["--stats-trace"],
+    );
+
+my $file = "$Self->{obj_dir}/$Self->{VM_PREFIX}__stats_trace.json";
+file_grep ($file, qr/"traceEvents"/);
+file_grep ($file, qr/"name":"order","cat":"pass","ph":"X"/);
+file_grep ($file, qr/"name":"order, move","cat":"step","ph":"X"/);
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats.txt", qr/Stage, Elapsed time/);
+
+ok(1);
+1;
@@ -0,0 +1,29 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+top_filename("t/t_if_deep.v");
+
+compile (
+	 verilator_flags2 => ["--compiler msvc", "--share-instances"],  # Deep blocks split from a function passed vlSelf
+	 );
+
+if ($Self->{vlt}) {
+    my $found;
+    foreach my $file (glob("$Self->{obj_dir}/*.cpp")) {
+	$found = 1 if $Self->file_contents($file) =~ /__deep\d+\(vlSymsp, vlSelf\)/;
+    }
+    $found or $Self->error("No deep block function was passed vlSelf");
+}
+
+execute (
+	 check_finished=>1,
+     );
+
+ok(1);
+1;
@@ -0,0 +1,48 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+top_filename("t/t_inst_tree.v");
+
+my $noshare_dir = "$Self->{obj_dir}_noshare";
+
+if ($Self->{vlt}) {
+    # Same model without sharing, to count what combines anyway
+    mkdir $noshare_dir;
+    my @cmdargs = $Self->compile_vlt_flags
+	(verilator_flags => ["-cc", "-Mdir", "${noshare_dir}", "-OD", "--debug-check"],
+	 v_flags2 => ['+define+NOUSE_INLINE', '+define+NOUSE_PUBLIC'],
+	 verilator_flags2 => ['--stats'],
+	);
+    $Self->_run(logfile=>"${noshare_dir}/vlt_compile.log",
+		cmd=>\@cmdargs);
+}
+
+compile (
+	 v_flags2 => ['+define+NOUSE_INLINE', '+define+NOUSE_PUBLIC'],
+	 verilator_flags2 => ['--share-instances', '--stats'],
+	 );
+
+if ($Self->{vlt}) {
+    # Each instance's copy of a function must now combine too
+    my $statRe = qr/Optimizations, Combined CFuncs\s+(\d+)/i;
+    my $noshare = ($Self->file_contents("${noshare_dir}/$Self->{VM_PREFIX}__stats.txt") =~ $statRe) ? $1 : 0;
+    my $share = ($Self->file_contents($Self->{stats}) =~ $statRe) ? $1 : 0;
+    $share > $noshare
+	or $Self->error("--share-instances combined $share CFuncs, no more than $noshare without it");
+}
+
+execute (
+	 check_finished=>1,
+	 expect=>
+'\] (%m|.*t\.ps): Clocked
+',
+     );
+
+ok(1);
+1;
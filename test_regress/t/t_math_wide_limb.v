@@ -0,0 +1,57 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc;
+
+   // Odd and even word counts, so both full and short last limbs are covered
+   wire [95:0]  a96  = {crc[31:0], ~crc, crc[63:32]};
+   wire [95:0]  b96  = {crc, crc[0] ? 32'hffffffff : 32'h0};
+   wire [159:0] a160 = {crc[15:0], crc, ~crc, crc[47:32]};
+   wire [159:0] b160 = {~crc[47:0], crc[63:32], crc, crc[15:0]};
+   wire [255:0] a256 = {crc, ~crc, crc[0] ? 64'h0 : ~64'h0, crc};
+   wire [255:0] b256 = {~crc, crc, crc, crc[1] ? 64'hffffffff_ffffffff : 64'h1};
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x a96=%x b96=%x\n",$time, cyc, crc, a96, b96);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else if (cyc<90) begin
+	 // Add and subtract, with carries across every word
+	 if (((a96 + b96) - b96) !== a96) $stop;
+	 if (((a160 + b160) - b160) !== a160) $stop;
+	 if (((a256 + b256) - b256) !== a256) $stop;
+	 if ((a256 + (-a256)) !== 256'h0) $stop;
+	 if ((a160 + (-a160)) !== 160'h0) $stop;
+	 // Multiply
+	 if ((a96 * b96) !== (b96 * a96)) $stop;
+	 if ((a160 * (b160 + 160'h1)) !== ((a160 * b160) + a160)) $stop;
+	 if ((a256 * (b256 + 256'h1)) !== ((a256 * b256) + a256)) $stop;
+	 if ((a256 * 256'h1_00000000) !== (a256 << 32)) $stop;
+	 if ((a160 * 160'h1_00000000_00000000) !== (a160 << 64)) $stop;
+	 // Compare
+	 if ((a96 < b96) !== !(a96 >= b96)) $stop;
+	 if ((a160 > b160) === (b160 >= a160)) $stop;
+	 if ((a256 < (a256 + 256'h1_00000000_00000000)) !== (a256[255:64] != ~192'h0)) $stop;
+      end
+      else if (cyc==99) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,56 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc;
+
+   // Wider than the stack temporaries, and above the Karatsuba threshold
+   reg [1023:0] a;
+   reg [1023:0] b;
+   wire [2047:0] a2k = {1024'h0, a};
+   wire [2047:0] b2k = {1024'h0, b};
+   wire [2047:0] p2k = a2k * b2k;
+   wire signed [2047:0] sa2k = -$signed(a2k);
+   wire signed [2047:0] sb2k = $signed(b2k);
+   wire signed [2047:0] sp2k = sa2k * sb2k;
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x\n",$time, cyc, crc);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      a <= {crc[31:0], {7{crc, ~crc}}, crc[63:32], 32'h1};
+      b <= {crc[0] ? 64'h0 : crc, {7{~crc, crc ^ 64'h12345678_9abcdef0}}, crc | 64'h1};
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else if (cyc>2 && cyc<50) begin
+	 // Multiply is undone by divide, as the product doesn't overflow
+	 if ((p2k / b2k) !== a2k) $stop;
+	 if ((p2k % b2k) !== 2048'h0) $stop;
+	 if (((p2k + a2k) % b2k) !== (a2k % b2k)) $stop;
+	 if ((p2k - b2k) !== ((a2k - 2048'h1) * b2k)) $stop;
+	 // Signed
+	 if (sp2k !== -$signed(p2k)) $stop;
+	 if ((sp2k / sb2k) !== sa2k) $stop;
+	 if ((sp2k % sb2k) !== 2048'sh0) $stop;
+	 // Truncating multiply keeps only the low words
+	 if ((a * b) !== p2k[1023:0]) $stop;
+      end
+      else if (cyc==99) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,24 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_math_wide_muldiv.v");
+
+# Lowest threshold, so the multiplies split down several levels
+compile (
+    v_flags2 => ["-CFLAGS -DVL_MUL_KARATSUBA_WORDS=8"],
+    );
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
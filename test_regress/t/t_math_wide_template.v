@@ -0,0 +1,63 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc;
+
+   // Variable shifts and selects are left as calls to the wide helpers
+   wire [7:0]	sh = crc[7:0];
+   wire [6:0]	lsb = crc[14:8];
+   wire [199:0] a = {crc[7:0], crc, ~crc, crc};
+   wire [199:0] shl = a << sh;
+   wire [199:0] shr = a >> sh;
+   wire [31:0]	sel32 = a[lsb +: 32];
+   wire [63:0]	sel64 = a[lsb +: 64];
+   wire [299:0] cat = {a, crc[37:0], ~crc[61:0]};
+
+   reg [199:0]	ref_shl;
+   reg [199:0]	ref_shr;
+   reg [63:0]	ref_sel;
+   integer	i;
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x shl=%x shr=%x\n",$time, cyc, crc, shl, shr);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else if (cyc<90) begin
+	 // Compare against the same operations done a bit at a time
+	 for (i=0; i<200; i=i+1) begin
+	    ref_shl[i] = (i >= sh) ? a[i-sh] : 1'b0;
+	    ref_shr[i] = (i+sh < 200) ? a[i+sh] : 1'b0;
+	 end
+	 for (i=0; i<64; i=i+1) begin
+	    ref_sel[i] = a[lsb+i];
+	 end
+	 if (shl !== ref_shl) $stop;
+	 if (shr !== ref_shr) $stop;
+	 if (sel32 !== ref_sel[31:0]) $stop;
+	 if (sel64 !== ref_sel) $stop;
+	 if (cat[299:100] !== a) $stop;
+	 if (cat[99:62] !== crc[37:0]) $stop;
+	 if (cat[61:0] !== ~crc[61:0]) $stop;
+      end
+      else if (cyc==99) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,80 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc;
+
+   // 17 words, so both whole vectors and a partial tail are covered
+   reg [543:0] a;
+   reg [543:0] b;
+   reg [543:0] o_and;
+   reg [543:0] o_or;
+   reg [543:0] o_xor;
+   reg	       o_eq;
+   reg	       o_neq;
+   reg	       o_redor;
+   reg	       o_redxor;
+
+   reg [31:0]  w;
+   reg	       any;
+   reg	       par;
+   reg	       same;
+   integer     i;
+
+   always @* begin
+      o_and = a & b;
+      o_or = a | b;
+      o_xor = a ^ b;
+      o_eq = (a == b);
+      o_neq = (a != b);
+      o_redor = |a;
+      o_redxor = ^a;
+   end
+
+   always @ (posedge clk) begin
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc==%0d crc=%x a=%x b=%x\n",$time, cyc, crc, a, b);
+`endif
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      a <= {crc[15:0], {4{crc, ~crc}}, (crc[3:0]==4'h0) ? 16'h0 : crc[63:48]};
+      b <= {crc[15:0], {4{crc, ~crc}}, crc[1] ? crc[63:48] : crc[47:32]};
+      if (crc[5:4]==2'b00) a <= 544'h0;
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+      end
+      else if (cyc>2 && cyc<90) begin
+	 // Compare against the same operations done a word at a time
+	 any = 1'b0;
+	 par = 1'b0;
+	 same = 1'b1;
+	 for (i=0; i<17; i=i+1) begin
+	    w = a[i*32+:32];
+	    if (o_and[i*32+:32] !== (w & b[i*32+:32])) $stop;
+	    if (o_or[i*32+:32] !== (w | b[i*32+:32])) $stop;
+	    if (o_xor[i*32+:32] !== (w ^ b[i*32+:32])) $stop;
+	    any = any | (|w);
+	    par = par ^ (^w);
+	    same = same & (w == b[i*32+:32]);
+	 end
+	 if (o_eq !== same) $stop;
+	 if (o_neq !== !same) $stop;
+	 if (o_redor !== any) $stop;
+	 if (o_redxor !== par) $stop;
+      end
+      else if (cyc==99) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,52 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+
+   integer 		i;
+   // Too large to unroll, so delayed writes in loops go through a queue
+   reg [31:0] 		mem [199:0];
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc==0) begin
+	 for (i=0; i<200; i=i+1) begin
+	    mem[i] <= i;
+	 end
+      end
+      else if (cyc==1) begin
+	 for (i=0; i<200; i=i+1) begin
+	    if (mem[i] != i) $stop;
+	    mem[i] <= mem[i] * 2;
+	 end
+	 // Partial write of an element already written
+	 mem[7][3:0] <= 4'hf;
+      end
+      else if (cyc==2) begin
+	 if (mem[0] != 0) $stop;
+	 if (mem[7] != 32'h0f) $stop;
+	 if (mem[199] != 398) $stop;
+	 mem[3] <= 32'h11;
+	 mem[3] <= 32'h22;
+	 // Partial write of an element not otherwise written
+	 mem[cyc+2][31:24] <= 8'hab;
+      end
+      else if (cyc==3) begin
+	 if (mem[3] != 32'h22) $stop;
+	 if (mem[4] != 32'hab000008) $stop;
+	 if (mem[5] != 10) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
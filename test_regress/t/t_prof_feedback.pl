@@ -0,0 +1,37 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+my $feedback = "$Self->{obj_dir}/$Self->{name}.dat";
+unlink $feedback;
+
+compile (
+    verilator_flags2 => ["--prof-feedback-gen $feedback"],
+    );
+
+execute (
+    check_finished=>1,
+    );
+
+file_grep ($feedback, qr/^cfunc TOP::_eval [1-9]/m);
+
+compile (
+    verilator_flags2 => ["--prof-feedback-use $feedback", "--stats"],
+    );
+
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats.txt", qr/Profile feedback cold functions\s+[1-9]/);
+file_grep ("$Self->{obj_dir}/$Self->{VM_PREFIX}__stats.txt", qr/Profile feedback unlikely branches\s+[1-9]/);
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
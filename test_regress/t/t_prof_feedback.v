@@ -0,0 +1,51 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [63:0] crc;
+   reg [31:0] sum;
+
+   // Derived clocks; rare_clk rises every 16 cycles, never_clk not within the test
+   reg	      rare_clk;
+   reg	      never_clk;
+   reg [31:0] rare_count;
+   reg [31:0] never_count;
+
+   always @ (posedge rare_clk) begin
+      rare_count <= rare_count + 32'd1;
+   end
+
+   always @ (posedge never_clk) begin
+      never_count <= never_count + crc[31:0];
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      crc <= {crc[62:0], crc[63]^crc[2]^crc[0]};
+      sum <= sum ^ crc[31:0];
+      rare_clk <= (cyc[3:0] == 4'd0);
+      never_clk <= (cyc == 1000);
+      if (cyc==0) begin
+	 crc <= 64'h5aef0c8d_d70a4497;
+	 sum <= 32'h0;
+	 rare_count <= 32'h0;
+	 never_count <= 32'h0;
+      end
+      else if (cyc==99) begin
+	 $write("[%0t] cyc==%0d crc=%x sum=%x rare=%0d\n",$time, cyc, crc, sum, rare_count);
+	 if (crc !== 64'hc77bb9b3784ea091) $stop;
+	 if (never_count !== 32'h0) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
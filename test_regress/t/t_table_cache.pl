@@ -0,0 +1,38 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+my $nocache_dir = "$Self->{obj_dir}_nocache";
+mkdir $nocache_dir;
+
+# With no cache budget, the same block must stay as logic
+{
+    my @cmdargs = $Self->compile_vlt_flags
+	(verilator_flags => ["-cc", "-Mdir", "${nocache_dir}", "--stats"],
+	 v_flags2 => ["--table-cache-bytes 0"],
+	);
+
+    $Self->_run(logfile=>"${nocache_dir}/vlt_compile.log",
+		cmd=>\@cmdargs);
+}
+file_grep ("${nocache_dir}/$Self->{VM_PREFIX}__stats.txt", qr/Optimizations, Tables over cache size\s+[1-9]/i);
+
+compile (
+    verilator_flags2 => ["--stats"],
+    );
+
+file_grep ($Self->{stats}, qr/Optimizations, Tables created\s+[1-9]/i);
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
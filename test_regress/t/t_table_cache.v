@@ -0,0 +1,41 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc; initial cyc = 0;
+   reg [7:0]  sel; initial sel = 8'h0;
+   reg [31:0] sum; initial sum = 32'h0;
+
+   // Worth a table when it fits in the cache, but not otherwise
+   reg [7:0]  o;
+   always @* begin
+      o = sel;
+      o = (o ^ {o[6:0], o[7]}) + 8'h3b;
+      o = (o ^ {o[6:0], o[7]}) + 8'hc5;
+      o = (o ^ {o[6:0], o[7]}) + 8'h17;
+      o = (o ^ {o[6:0], o[7]}) + 8'h92;
+      o = (o ^ {o[6:0], o[7]}) + 8'h6d;
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      sel <= cyc[7:0];
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d sel=%x o=%x sum=%x\n", $time, cyc, sel, o, sum);
+`endif
+      if (cyc == 1 && o != 8'h28) $stop;
+      if (cyc >= 1 && cyc <= 256) sum <= sum * 32'd3 + {24'h0, o};
+      if (cyc == 257) begin
+	 if (sum != 32'ha8f19678) $stop;
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule
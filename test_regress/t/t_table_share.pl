@@ -0,0 +1,28 @@
+#!/usr/bin/perl
+if (!$::Driver) { use FindBin; exec("$FindBin::Bin/bootstrap.pl", @ARGV, $0); die; }
+# DESCRIPTION: Verilator: Verilog Test driver/expect definition
+#
+# Copyright 2003 by Wilson Snyder. This program is free software; you can
+# redistribute it and/or modify it under the terms of either the GNU
+# Lesser General Public License Version 3 or the Perl Artistic License
+# Version 2.0.
+
+$Self->{vlt} or $Self->skip("Verilator only test");
+
+top_filename("t/t_case_huge.v");
+
+compile (
+    verilator_flags2 => ["--stats"],
+    );
+
+# Each t_case_huge_sub instance reuses the first one's tables,
+# and its three narrow outputs share one table
+file_grep ($Self->{stats}, qr/Optimizations, Tables shared\s+[1-9]/i);
+file_grep ($Self->{stats}, qr/Optimizations, Tables packed\s+[1-9]/i);
+
+execute (
+    check_finished=>1,
+    );
+
+ok(1);
+1;
@@ -0,0 +1,36 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [3:0] in; initial in = 4'h5;
+
+   // Circular as whole signals, but settles, so can loop by itself
+   wire [2:0] x = {x[1:0], in[0]};
+   wire [7:0] y;
+   wire [7:0] z = y + {5'h0, x};
+   assign y = {z[3:0], in};
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      in <= in + 4'h3;
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d in=%x x=%x y=%x\n",$time, cyc, in, x, y);
+`endif
+      if (x != {3{in[0]}}) $stop;
+      if (y != {in + {1'b0, x}, in}) $stop;
+      if (cyc == 20) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
@@ -0,0 +1,42 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+
+   input clk;
+
+   integer cyc; initial cyc=0;
+   reg [7:0] in; initial in = 8'h5a;
+
+   // Only circular if ordered as whole signals
+   wire [7:0] b;
+   assign b[3:0] = b[7:4];
+   assign b[7:4] = in[3:0];
+
+   wire [11:0] c;
+   assign c[3:0] = in[7:4];
+   assign c[7:4] = c[3:0] + 4'h1;
+   assign c[11:8] = c[7:4] ^ b[3:0];
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      in <= in + 8'h13;
+`ifdef TEST_VERBOSE
+      $write("[%0t] cyc=%0d in=%x b=%x c=%x\n",$time, cyc, in, b, c);
+`endif
+      if (b != {in[3:0], in[3:0]}) $stop;
+      if (c[3:0] != in[7:4]) $stop;
+      if (c[7:4] != in[7:4] + 4'h1) $stop;
+      if (c[11:8] != ((in[7:4] + 4'h1) ^ in[3:0])) $stop;
+      if (cyc == 20) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+
+endmodule
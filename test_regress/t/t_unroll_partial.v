@@ -0,0 +1,45 @@
+// DESCRIPTION: Verilator: Verilog Test module
+//
+// This file ONLY is placed into the Public Domain, for any use,
+// without warranty, 2017 by Wilson Snyder.
+
+module t (/*AUTOARG*/
+   // Inputs
+   clk
+   );
+   input clk;
+
+   integer cyc=0;
+
+   reg [7:0] mem [0:255];
+   reg [15:0] sum;
+   reg [15:0] cnt;
+   integer i;
+   integer j;
+   integer k;
+
+   // Too many iterations to unroll; kept as loops
+   initial begin
+      for (i=0; i<256; i=i+1) mem[i] = i[7:0] ^ 8'h5a;
+      if (i != 256) $stop;
+   end
+
+   always @ (posedge clk) begin
+      cyc <= cyc + 1;
+      if (cyc==1) begin
+	 sum = 16'h0;
+	 for (j=0; j<256; j=j+1) sum = sum + {8'h0, mem[j]};
+	 if (j != 256) $stop;
+	 if (sum != 16'd32640) $stop;
+	 // Odd count, can't be partially unrolled
+	 cnt = 16'h0;
+	 for (k=0; k<255; k=k+1) cnt = cnt + k[15:0];
+	 if (k != 255) $stop;
+	 if (cnt != 16'd32385) $stop;
+      end
+      else if (cyc==2) begin
+	 $write("*-* All Finished *-*\n");
+	 $finish;
+      end
+   end
+endmodule